@@ -0,0 +1,20 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "benchmark_module.h"
+
+#include <QThread>
+
+namespace dss {
+namespace module {
+
+BenchmarkModule::BenchmarkModule(QObject *parent)
+    : QObject(parent)
+{
+    setObjectName(QStringLiteral(BENCHMARK_MODULE_KEY));
+    QThread::msleep(BENCHMARK_MODULE_INIT_MS);
+}
+
+} // namespace module
+} // namespace dss
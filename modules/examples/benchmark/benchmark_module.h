@@ -0,0 +1,36 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef BENCHMARK_MODULE_H
+#define BENCHMARK_MODULE_H
+
+#include "base_module_interface.h"
+
+namespace dss {
+namespace module {
+
+/**
+ * @brief 用于测试插件加载速度的空插件，构造时模拟插件初始化的耗时
+ */
+class BenchmarkModule : public QObject
+    , public BaseModuleInterface
+{
+    Q_OBJECT
+    Q_PLUGIN_METADATA(IID "com.deepin.dde.shell.Modules" FILE "benchmark.json")
+    Q_INTERFACES(dss::module::BaseModuleInterface)
+
+public:
+    explicit BenchmarkModule(QObject *parent = nullptr);
+
+    void init() override { }
+
+    inline QString key() const override { return objectName(); }
+    inline QWidget *content() override { return nullptr; }
+    inline ModuleType type() const override { return TrayType; }
+    inline bool isNeedInitPlugin() const override { return true; }
+};
+
+} // namespace module
+} // namespace dss
+#endif // BENCHMARK_MODULE_H
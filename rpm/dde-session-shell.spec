@@ -19,6 +19,7 @@ BuildRequires:  libXrandr-devel
 BuildRequires:  libXtst-devel
 BuildRequires:  libXi-devel
 BuildRequires:  xcb-util-wm xcb-util-wm-devel
+BuildRequires:  libxcb-devel
 BuildRequires:  dde-qt-dbus-factory-devel
 BuildRequires:  gsettings-qt-devel
 BuildRequires:  lightdm-qt5-devel
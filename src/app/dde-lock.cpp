@@ -8,6 +8,7 @@
 #include "dbuslockfrontservice.h"
 #include "dbusshutdownagent.h"
 #include "dbusshutdownfrontservice.h"
+#include "encryptionprovider.h"
 #include "lockcontent.h"
 #include "lockframe.h"
 #include "lockworker.h"
@@ -15,6 +16,8 @@
 #include "multiscreenmanager.h"
 #include "propertygroup.h"
 #include "sessionbasemodel.h"
+#include "tracer.h"
+#include "xkbparser.h"
 
 #include <DApplication>
 #include <DGuiApplicationHelper>
@@ -22,6 +25,7 @@
 #include <DPlatformTheme>
 
 #include <QDBusInterface>
+#include <QScopedPointer>
 
 #include <unistd.h>
 
@@ -30,6 +34,9 @@ DWIDGET_USE_NAMESPACE
 
 int main(int argc, char *argv[])
 {
+    TraceSpan startupSpan("startup");
+
+    TraceSpan applicationSpan("DApplication");
     DApplication *app = nullptr;
 #if (DTK_VERSION < DTK_VERSION_CHECK(5, 4, 0, 0))
     app = new DApplication(argc, argv);
@@ -45,6 +52,7 @@ int main(int argc, char *argv[])
 
     DLogManager::registerConsoleAppender();
     DLogManager::registerFileAppender();
+    applicationSpan.end();
 
     //注册全局事件过滤器
     AppEventFilter appEventFilter;
@@ -77,7 +85,9 @@ int main(int argc, char *argv[])
     });
 
     /* load translation files */
+    TraceSpan translationSpan("loadTranslation");
     loadTranslation(QLocale::system().name());
+    translationSpan.end();
 
     QCommandLineParser cmdParser;
     cmdParser.addHelpOption();
@@ -108,6 +118,8 @@ int main(int argc, char *argv[])
     }
 
     modulesLoader->start(QThread::LowestPriority);
+    // 键盘布局列表在创建界面时使用，提前在线程池中解析
+    XkbParser::instance()->preload();
 
     bool runDaemon = cmdParser.isSet(backend);
     bool showUserList = cmdParser.isSet(switchUser);
@@ -120,7 +132,9 @@ int main(int argc, char *argv[])
 
     SessionBaseModel *model = new SessionBaseModel();
     model->setAppType(Lock);
+    TraceSpan workerSpan("LockWorker");
     LockWorker *worker = new LockWorker(model);
+    workerSpan.end();
     QObject::connect(&appEventFilter, &AppEventFilter::userIsActive, worker, &LockWorker::restartResetSessionTimer);
     PropertyGroup *property_group = new PropertyGroup(worker);
 
@@ -141,8 +155,26 @@ int main(int argc, char *argv[])
     shutdownAgent.setModel(model);
     DBusShutdownFrontService shutdownServices(&shutdownAgent);
 
+    // 所有屏幕共用一个 LockContent，显示在鼠标所在的屏幕上，其它屏幕只绘制背景
+    TraceSpan contentSpan("LockContent");
+    LockContent *lockContent = new LockContent(model);
+    // LockFrame 析构时只把共用的 LockContent 移出窗口，退出 main 时在这里释放
+    QScopedPointer<LockContent> lockContentOwner(lockContent);
+    contentSpan.end();
+    QObject::connect(lockContent, &LockContent::requestSwitchToUser, worker, &LockWorker::switchToUser);
+    QObject::connect(lockContent, &LockContent::requestSetKeyboardLayout, worker, &LockWorker::setKeyboardLayout);
+    QObject::connect(lockContent, &LockContent::requestStartAuthentication, worker, &LockWorker::startAuthentication);
+    QObject::connect(lockContent, &LockContent::sendTokenToAuth, worker, &LockWorker::sendTokenToAuth);
+    QObject::connect(lockContent, &LockContent::requestEndAuthentication, worker, &LockWorker::endAccountAuthentication);
+    QObject::connect(lockContent, &LockContent::requestCheckAccount, worker, &LockWorker::checkAccount);
+    QObject::connect(lockContent, &LockContent::authFinished, worker, [worker] {
+        worker->enableZoneDetected(true);
+        worker->onAuthFinished();
+    });
+
     auto createFrame = [&] (QScreen *screen, int count) -> QWidget* {
-        LockFrame *lockFrame = new LockFrame(model);
+        DSS_TRACE_SCOPE("createFrame");
+        LockFrame *lockFrame = new LockFrame(model, lockContent);
         lockFrame->setScreen(screen, count <= 0);
         property_group->addObject(lockFrame);
         QObject::connect(lockFrame, &LockFrame::requestSwitchToUser, worker, &LockWorker::switchToUser);
@@ -169,8 +201,10 @@ int main(int argc, char *argv[])
         return lockFrame;
     };
 
+    TraceSpan framesSpan("frames");
     MultiScreenManager multi_screen_manager;
     multi_screen_manager.register_for_mutil_screen(createFrame);
+    framesSpan.end();
 
 #if defined(DSS_CHECK_ACCESSIBILITY) && defined(QT_DEBUG)
     AccessibilityCheckerEx checker;
@@ -185,11 +219,13 @@ int main(int argc, char *argv[])
 
     QDBusConnection conn = QDBusConnection::sessionBus();
     int ret = 0;
+    TraceSpan registerSpan("registerService");
     if (!conn.registerService(DBUS_LOCK_NAME) ||
         !conn.registerObject(DBUS_LOCK_PATH, &lockAgent) ||
         !conn.registerService(DBUS_SHUTDOWN_NAME) ||
         !conn.registerObject(DBUS_SHUTDOWN_PATH, &shutdownAgent) ||
         !app->setSingleInstance(QString("dde-lock%1").arg(getuid()), DApplication::UserScope)) {
+        registerSpan.end();
         qDebug() << "register dbus failed"<< "maybe lockFront is running..." << conn.lastError();
 
         if (!runDaemon) {
@@ -207,6 +243,7 @@ int main(int argc, char *argv[])
             }
         }
     } else {
+        registerSpan.end();
         if (!runDaemon) {
             if (showUserList) {
                 emit model->showUserList();
@@ -216,6 +253,12 @@ int main(int argc, char *argv[])
                 emit model->showLockScreen();
             }
         }
+        startupSpan.end();
+        Tracer::instance()->finishStartup();
+        // OpenSSL 的 atexit 清理早于静态析构，退出事件循环时释放加密相关的资源
+        QObject::connect(app, &QCoreApplication::aboutToQuit, [] {
+            EncryptionProvider::instance()->release();
+        });
         ret = app->exec();
     }
     return ret;
@@ -5,12 +5,15 @@
 #include "accessibilitycheckerex.h"
 #include "appeventfilter.h"
 #include "constants.h"
+#include "encryptionprovider.h"
 #include "greeterworker.h"
 #include "loginframe.h"
 #include "modules_loader.h"
 #include "multiscreenmanager.h"
 #include "propertygroup.h"
 #include "sessionbasemodel.h"
+#include "tracer.h"
+#include "xkbparser.h"
 
 #include <DApplication>
 #include <DGuiApplicationHelper>
@@ -191,6 +194,8 @@ void set_pointer()
 
 int main(int argc, char* argv[])
 {
+    TraceSpan startupSpan("startup");
+
     // 正确加载dxcb插件
     //for qt5platform-plugins load DPlatformIntegration or DPlatformIntegrationParent
     if (!QString(qgetenv("XDG_CURRENT_DESKTOP")).toLower().startsWith("deepin")){
@@ -202,9 +207,11 @@ int main(int argc, char* argv[])
     DGuiApplicationHelper::setAttribute(DGuiApplicationHelper::UseInactiveColorGroup, false);
     // 设置缩放，文件存在的情况下，由后端去设置，否则前端自行设置
     if (!QFile::exists("/etc/lightdm/deepin/xsettingsd.conf")) {
+        DSS_TRACE_SCOPE("set_auto_QT_SCALE_FACTOR");
         set_auto_QT_SCALE_FACTOR();
     }
 
+    TraceSpan applicationSpan("DApplication");
     DApplication a(argc, argv);
     QApplication::setAttribute(Qt::AA_UseHighDpiPixmaps);
     qApp->setOrganizationName("deepin");
@@ -214,14 +221,18 @@ int main(int argc, char* argv[])
 
     DLogManager::registerConsoleAppender();
     DLogManager::registerJournalAppender();
+    applicationSpan.end();
 
+    TraceSpan pointerSpan("set_pointer");
     set_pointer();
+    pointerSpan.end();
 
     //注册全局事件过滤器
     AppEventFilter appEventFilter;
     a.installEventFilter(&appEventFilter);
     setAppType(APP_TYPE_LOGIN);
 
+    TraceSpan paletteSpan("palette");
     DPalette pa = DGuiApplicationHelper::instance()->standardPalette(DGuiApplicationHelper::LightType);
     pa.setColor(QPalette::Normal, DPalette::WindowText, QColor("#FFFFFF"));
     pa.setColor(QPalette::Normal, DPalette::Text, QColor("#FFFFFF"));
@@ -238,6 +249,7 @@ int main(int argc, char* argv[])
     DGuiApplicationHelper::generatePaletteColor(pa, DPalette::Dark, DGuiApplicationHelper::LightType);
     DGuiApplicationHelper::generatePaletteColor(pa, DPalette::ButtonText, DGuiApplicationHelper::LightType);
     DGuiApplicationHelper::instance()->setApplicationPalette(pa);
+    paletteSpan.end();
 
     dss::module::ModulesLoader *modulesLoader = &dss::module::ModulesLoader::instance();
 
@@ -257,9 +269,12 @@ int main(int argc, char* argv[])
     }
 
     modulesLoader->start(QThread::LowestPriority);
+    // 键盘布局列表在创建界面时使用，提前在线程池中解析
+    XkbParser::instance()->preload();
 
     const QString serviceName = "org.deepin.dde.Accounts1";
     QDBusConnectionInterface *interface = QDBusConnection::systemBus().interface();
+    TraceSpan accountsSpan("wait Accounts1");
     if (!interface->isServiceRegistered(serviceName)) {
         qWarning() << "accounts service is not registered wait...";
 
@@ -281,14 +296,19 @@ int main(int argc, char* argv[])
         qDebug() << "service registered!";
 #endif
     }
+    accountsSpan.end();
 
     SessionBaseModel *model = new SessionBaseModel();
     model->setAppType(Login);
+    TraceSpan workerSpan("GreeterWorker");
     GreeterWorker *worker = new GreeterWorker(model);
+    workerSpan.end();
     QObject::connect(&appEventFilter, &AppEventFilter::userIsActive, worker, &GreeterWorker::restartResetSessionTimer);
 
     /* load translation files */
+    TraceSpan translationSpan("loadTranslation");
     loadTranslation(model->currentUser()->locale());
+    translationSpan.end();
 
     // 设置系统登录成功的加载光标
     QObject::connect(model, &SessionBaseModel::authFinished, model, [ = ](bool is_success) {
@@ -301,6 +321,7 @@ int main(int argc, char* argv[])
     property_group->addProperty("contentVisible");
 
     auto createFrame = [&](QScreen *screen, int count) -> QWidget * {
+        DSS_TRACE_SCOPE("createFrame");
         LoginFrame *loginFrame = new LoginFrame(model);
         loginFrame->setScreen(screen, count <= 0);
         property_group->addObject(loginFrame);
@@ -316,9 +337,11 @@ int main(int argc, char* argv[])
         return loginFrame;
     };
 
+    TraceSpan framesSpan("frames");
     MultiScreenManager multi_screen_manager;
     multi_screen_manager.register_for_mutil_screen(createFrame);
     QObject::connect(model, &SessionBaseModel::visibleChanged, &multi_screen_manager, &MultiScreenManager::startRaiseContentFrame);
+    framesSpan.end();
 
 #if defined(DSS_CHECK_ACCESSIBILITY) && defined(QT_DEBUG)
     AccessibilityCheckerEx checker;
@@ -328,5 +351,12 @@ int main(int argc, char* argv[])
     checker.start();
 #endif
 
+    startupSpan.end();
+    Tracer::instance()->finishStartup();
+
+    // OpenSSL 的 atexit 清理早于静态析构，退出事件循环时释放加密相关的资源
+    QObject::connect(&a, &QCoreApplication::aboutToQuit, [] {
+        EncryptionProvider::instance()->release();
+    });
     return a.exec();
 }
@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "dbuslockfrontservice.h"
+#include "dbusmetrics.h"
 
 /*
  * Implementation of interface class DBusLockFront
@@ -42,3 +43,16 @@ void DBusLockFrontService::Hibernate(bool enable)
 {
     parent()->Hibernate(enable);
 }
+
+/**
+ * @brief 导出本进程 D-Bus 调用的次数和耗时分布，JSON 格式
+ */
+QString DBusLockFrontService::DumpDBusMetrics()
+{
+    return DBusMetrics::instance()->dump();
+}
+
+void DBusLockFrontService::ResetDBusMetrics()
+{
+    DBusMetrics::instance()->reset();
+}
@@ -41,6 +41,8 @@ public Q_SLOTS:// METHODS
     void ShowAuth(bool active);
     void Suspend(bool enable);
     void Hibernate(bool enable);
+    QString DumpDBusMetrics();
+    void ResetDBusMetrics();
 
 Q_SIGNALS:
     void ChangKey(QString key);
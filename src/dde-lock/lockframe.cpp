@@ -36,10 +36,19 @@ xcb_atom_t internAtom(xcb_connection_t *connection, const char *name, bool only_
     return atom;
 }
 
-LockFrame::LockFrame(SessionBaseModel *const model, QWidget *parent)
+/**
+ * @brief 锁屏窗口
+ *
+ * @param model
+ * @param content 多个屏幕共用的 LockContent，为空时创建自己的 LockContent。
+ *                共用的 LockContent 的请求由创建者统一转发，窗口只处理自己的显示和隐藏
+ * @param parent
+ */
+LockFrame::LockFrame(SessionBaseModel *const model, LockContent *content, QWidget *parent)
     : FullscreenBackground(model, parent)
     , m_model(model)
-    , m_lockContent(new LockContent(model))
+    , m_lockContent(content ? content : new LockContent(model))
+    , m_ownsLockContent(!content)
     , m_warningContent(nullptr)
     , m_enablePowerOffKey(false)
     , m_autoExitTimer(nullptr)
@@ -55,22 +64,27 @@ LockFrame::LockFrame(SessionBaseModel *const model, QWidget *parent)
 
     setAccessibleName("LockFrame");
     m_lockContent->setAccessibleName("LockContent");
-    m_lockContent->hide();
+    if (m_ownsLockContent)
+        m_lockContent->hide();
     setContent(m_lockContent);
 
-    connect(m_lockContent, &LockContent::requestSwitchToUser, this, &LockFrame::requestSwitchToUser);
-    connect(m_lockContent, &LockContent::requestSetKeyboardLayout, this, &LockFrame::requestSetKeyboardLayout);
     connect(m_lockContent, &LockContent::requestBackground, this, static_cast<void (LockFrame::*)(const QString &)>(&LockFrame::updateBackground));
-    connect(m_lockContent, &LockContent::requestStartAuthentication, this, &LockFrame::requestStartAuthentication);
-    connect(m_lockContent, &LockContent::sendTokenToAuth, this, &LockFrame::sendTokenToAuth);
-    connect(m_lockContent, &LockContent::requestEndAuthentication, this, &LockFrame::requestEndAuthentication);
     connect(m_lockContent, &LockContent::requestLockFrameHide, this, &LockFrame::hide);
-    connect(m_lockContent, &LockContent::authFinished, this, [this] {
-        hide();
-        emit requestEnableHotzone(true);
-        emit authFinished();
-    });
-    connect(m_lockContent, &LockContent::requestCheckAccount, this, &LockFrame::requestCheckAccount);
+    if (m_ownsLockContent) {
+        connect(m_lockContent, &LockContent::requestSwitchToUser, this, &LockFrame::requestSwitchToUser);
+        connect(m_lockContent, &LockContent::requestSetKeyboardLayout, this, &LockFrame::requestSetKeyboardLayout);
+        connect(m_lockContent, &LockContent::requestStartAuthentication, this, &LockFrame::requestStartAuthentication);
+        connect(m_lockContent, &LockContent::sendTokenToAuth, this, &LockFrame::sendTokenToAuth);
+        connect(m_lockContent, &LockContent::requestEndAuthentication, this, &LockFrame::requestEndAuthentication);
+        connect(m_lockContent, &LockContent::authFinished, this, [this] {
+            hide();
+            emit requestEnableHotzone(true);
+            emit authFinished();
+        });
+        connect(m_lockContent, &LockContent::requestCheckAccount, this, &LockFrame::requestCheckAccount);
+    } else {
+        connect(m_lockContent, &LockContent::authFinished, this, &LockFrame::hide);
+    }
     connect(model, &SessionBaseModel::showUserList, this, &LockFrame::showUserList);
     connect(model, &SessionBaseModel::showLockScreen, this, &LockFrame::showLockScreen);
     connect(model, &SessionBaseModel::showShutdown, this, &LockFrame::showShutdown);
@@ -122,6 +136,15 @@ LockFrame::LockFrame(SessionBaseModel *const model, QWidget *parent)
     }
 }
 
+LockFrame::~LockFrame()
+{
+    // 共用的 LockContent 不随当前窗口析构，其它屏幕显示内容时会再移动过去
+    if (!m_ownsLockContent && m_lockContent->parentWidget() == this) {
+        m_lockContent->hide();
+        m_lockContent->setParent(nullptr);
+    }
+}
+
 bool LockFrame::event(QEvent *event)
 {
     if (event->type() == QEvent::KeyRelease) {
@@ -184,7 +207,8 @@ bool LockFrame::event(QEvent *event)
 
 void LockFrame::resizeEvent(QResizeEvent *event)
 {
-    m_lockContent->resize(size());
+    if (m_lockContent->parentWidget() == this)
+        m_lockContent->resize(size());
     FullscreenBackground::resizeEvent(event);
 }
 
@@ -29,7 +29,8 @@ class LockFrame: public FullscreenBackground
 {
     Q_OBJECT
 public:
-    LockFrame(SessionBaseModel *const model, QWidget *parent = nullptr);
+    LockFrame(SessionBaseModel *const model, LockContent *content = nullptr, QWidget *parent = nullptr);
+    ~LockFrame() override;
 
 signals:
     void requestSwitchToUser(std::shared_ptr<User> user);
@@ -63,6 +64,7 @@ private:
 private:
     SessionBaseModel *m_model;
     LockContent *m_lockContent;
+    bool m_ownsLockContent;
     WarningContent *m_warningContent;
     bool m_enablePowerOffKey;
     QTimer *m_autoExitTimer;
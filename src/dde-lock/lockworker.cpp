@@ -31,6 +31,7 @@ LockWorker::LockWorker(SessionBaseModel *const model, QObject *parent)
     , m_isThumbAuth(false)
     , m_canAuthenticate(false)
     , m_authFramework(new DeepinAuthFramework(this))
+    , m_authStateMachine(new AuthStateMachine(this))
     , m_lockInter(new DBusLockService("org.deepin.dde.LockService1", "/org/deepin/dde/LockService1", QDBusConnection::systemBus(), this))
     , m_hotZoneInter(new DBusHotzone("org.deepin.dde.Zone1", "/org/deepin/dde/Zone1", QDBusConnection::sessionBus(), this))
     , m_sessionManagerInter(new SessionManagerInter("org.deepin.dde.SessionManager1", "/org/deepin/dde/SessionManager1", QDBusConnection::sessionBus(), this))
@@ -97,15 +98,30 @@ void LockWorker::initConnections()
     connect(m_authFramework, &DeepinAuthFramework::MFAFlagChanged, m_model, &SessionBaseModel::updateMFAFlag);
     connect(m_authFramework, &DeepinAuthFramework::PINLenChanged, m_model, &SessionBaseModel::updatePINLen);
     connect(m_authFramework, &DeepinAuthFramework::PromptChanged, m_model, &SessionBaseModel::updatePrompt);
-    connect(m_authFramework, &DeepinAuthFramework::AuthStateChanged, this, &LockWorker::onAuthStateChanged);
+    connect(m_authFramework, &DeepinAuthFramework::AuthStateChanged, m_authStateMachine, &AuthStateMachine::handleStatus);
+    connect(m_authStateMachine, &AuthStateMachine::statusChanged, this, &LockWorker::onAuthStateChanged);
+    connect(m_authStateMachine, &AuthStateMachine::deferredStateChanged, m_model, &SessionBaseModel::updateAuthState);
+    connect(m_authStateMachine, &AuthStateMachine::requestStartAuthentication, this, [this](const int type) {
+        startAuthentication(m_account, type);
+    });
+    connect(m_authStateMachine, &AuthStateMachine::requestEndAuthentication, this, [this](const int type) {
+        endAuthentication(m_account, type);
+        // 不使用认证框架时 PAM 认证要等线程结束后才能重新开启，其它类型没有需要等待的结束过程
+        if (m_model->getAuthProperty().FrameworkState != Available && type != AT_PAM)
+            m_authStateMachine->markEnded(type);
+    });
+    connect(m_authFramework, &DeepinAuthFramework::PAMAuthenticationFinished, this, [this] {
+        m_authStateMachine->markEnded(AT_PAM);
+    });
     connect(m_authFramework, &DeepinAuthFramework::FactorsInfoChanged, m_model, &SessionBaseModel::updateFactorsInfo);
 
     /* org.deepin.dde.LockService1 */
     connect(m_lockInter, &DBusLockService::UserChanged, this, [ = ](const QString &json) {
         qInfo() << "DBusLockService::UserChanged:" << json;
-        QTimer::singleShot(100, this, [ = ] {
+        // 等切换用户的其它信号处理完再切换模式
+        QMetaObject::invokeMethod(this, [this] {
             m_model->setCurrentModeState(SessionBaseModel::ModeStatus::PasswordMode);
-        });
+        }, Qt::QueuedConnection);
         m_resetSessionTimer->stop();
     });
     connect(m_lockInter, &DBusLockService::Event, this, &LockWorker::handleServiceEvent);
@@ -293,27 +309,17 @@ void LockWorker::onAuthStateChanged(const int type, const int state, const QStri
                     m_model->setCurrentModeState(SessionBaseModel::ModeStatus::PasswordMode);
                 }
                 m_model->updateLimitedInfo(m_authFramework->GetLimitedInfo(m_model->currentUser()->name()));
-                endAuthentication(m_account, type);
-                if (!m_model->currentUser()->limitsInfo(type).locked
-                        && type != AT_Face && type != AT_Iris) {
-                    QTimer::singleShot(50, this, [this, type] {
-                        startAuthentication(m_account, type);
-                    });
-                }
-                QTimer::singleShot(50, this, [this, type, state, message] {
-                    m_model->updateAuthState(type, state, message);
-                });
+                // 收到 Ended 之后再更新界面和重新开启认证，人脸和虹膜需要手动重新开启
+                m_authStateMachine->finishFactor(type, state, message,
+                                                 !m_model->currentUser()->limitsInfo(type).locked && type != AT_Face && type != AT_Iris);
                 break;
             case AS_Locked:
                 if (m_model->currentModeState() != SessionBaseModel::ModeStatus::PasswordMode
                     && m_model->currentModeState() != SessionBaseModel::ModeStatus::ConfirmPasswordMode) {
                     m_model->setCurrentModeState(SessionBaseModel::ModeStatus::PasswordMode);
                 }
-                endAuthentication(m_account, type);
-                // TODO: 信号时序问题,考虑优化,Bug 89056
-                QTimer::singleShot(50, this, [this, type, state, message] {
-                    m_model->updateAuthState(type, state, message);
-                });
+                // 锁定的界面状态要在 Ended 之后更新，Bug 89056
+                m_authStateMachine->finishFactor(type, state, message, false);
                 break;
             case AS_Timeout:
             case AS_Error:
@@ -347,13 +353,9 @@ void LockWorker::onAuthStateChanged(const int type, const int state, const QStri
         case AS_Failure:
             // 单因失败会返回明确的失败类型，不关注type为-1的情况
             if (AT_All != type) {
-                endAuthentication(m_account, type);
                 // 人脸和虹膜需要手动重新开启验证
-                if (!m_model->currentUser()->limitsInfo(type).locked && type != AT_Face && type != AT_Iris) {
-                    QTimer::singleShot(50, this, [this, type] {
-                        startAuthentication(m_account, type);
-                    });
-                }
+                m_authStateMachine->finishFactor(type, AS_None, QString(),
+                                                 !m_model->currentUser()->limitsInfo(type).locked && type != AT_Face && type != AT_Iris);
             }
             break;
         case AS_Cancel:
@@ -543,9 +545,10 @@ void LockWorker::createAuthentication(const QString &account)
     }
 
     m_account = account;
+    m_authStateMachine->reset();
     switch (m_model->getAuthProperty().FrameworkState) {
     case Available:
-        m_authFramework->CreateAuthController(account, m_authFramework->GetSupportedMixAuthFlags(), Lock);
+        m_authFramework->CreateAuthControllerAsync(account, m_authFramework->GetSupportedMixAuthFlags(), Lock);
         break;
     default:
         m_authFramework->CreateAuthenticate(account);
@@ -564,6 +567,7 @@ void LockWorker::createAuthentication(const QString &account)
 void LockWorker::destroyAuthentication(const QString &account)
 {
     qInfo() << "LockWorker::destroyAuthentication:" << account;
+    m_authStateMachine->reset();
     switch (m_model->getAuthProperty().FrameworkState) {
     case Available:
         m_authFramework->DestroyAuthController(account);
@@ -6,6 +6,7 @@
 #define LOCKWORKER_H
 
 #include "authinterface.h"
+#include "authstatemachine.h"
 #include "dbushotzone.h"
 #include "dbuslockservice.h"
 #include "dbuslogin1manager.h"
@@ -75,6 +76,7 @@ private:
     bool m_isThumbAuth;
     bool m_canAuthenticate;
     DeepinAuthFramework *m_authFramework;
+    AuthStateMachine *m_authStateMachine;
     DBusLockService *m_lockInter;
     DBusHotzone *m_hotZoneInter;
     SessionManagerInter *m_sessionManagerInter;
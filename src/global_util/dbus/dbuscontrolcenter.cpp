@@ -9,7 +9,7 @@
  */
 
 DBusControlCenter::DBusControlCenter(QObject *parent)
-    : QDBusAbstractInterface("org.deepin.dde.ControlCenter1", "/org/deepin/dde/ControlCenter1", staticInterfaceName(), QDBusConnection::sessionBus(), parent)
+    : DBusInstrumentedInterface("org.deepin.dde.ControlCenter1", "/org/deepin/dde/ControlCenter1", staticInterfaceName(), QDBusConnection::sessionBus(), parent)
 {
     QDBusConnection::sessionBus().connect(this->service(), this->path(), "org.freedesktop.DBus.Properties",  "PropertiesChanged","sa{sv}as", this, SLOT(__propertyChanged__(QDBusMessage)));
 }
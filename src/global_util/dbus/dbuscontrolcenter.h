@@ -5,6 +5,8 @@
 #ifndef DBUSCONTROLCENTER_H_1442200179
 #define DBUSCONTROLCENTER_H_1442200179
 
+#include "dbusmetrics.h"
+
 #include <QtCore/QObject>
 #include <QtCore/QByteArray>
 #include <QtCore/QList>
@@ -17,7 +19,7 @@
 /*
  * Proxy class for interface org.deepin.dde.ControlCenter1
  */
-class DBusControlCenter: public QDBusAbstractInterface
+class DBusControlCenter: public DBusInstrumentedInterface
 {
     Q_OBJECT
 
@@ -9,7 +9,7 @@
  */
 
 DBusDisplayManager::DBusDisplayManager(const QString &service, const QString &path, const QDBusConnection &connection, QObject *parent)
-    : QDBusAbstractInterface(service, path, staticInterfaceName(), connection, parent)
+    : DBusInstrumentedInterface(service, path, staticInterfaceName(), connection, parent)
 {
     QDBusConnection::systemBus().connect(this->service(), this->path(), "org.freedesktop.DBus.Properties",  "PropertiesChanged","sa{sv}as", this, SLOT(__propertyChanged__(QDBusMessage)));
 }
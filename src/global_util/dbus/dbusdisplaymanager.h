@@ -5,6 +5,8 @@
 #ifndef DBUSDISPLAYMANAGER_H_1446711552
 #define DBUSDISPLAYMANAGER_H_1446711552
 
+#include "dbusmetrics.h"
+
 #include <QtCore/QObject>
 #include <QtCore/QByteArray>
 #include <QtCore/QList>
@@ -17,7 +19,7 @@
 /*
  * Proxy class for interface org.freedesktop.DisplayManager
  */
-class DBusDisplayManager: public QDBusAbstractInterface
+class DBusDisplayManager: public DBusInstrumentedInterface
 {
     Q_OBJECT
 
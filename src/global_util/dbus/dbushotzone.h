@@ -5,6 +5,8 @@
 #ifndef DBUSHOTZONE_H
 #define DBUSHOTZONE_H
 
+#include "dbusmetrics.h"
+
 #include <QtCore/QObject>
 #include <QtCore/QByteArray>
 #include <QtCore/QList>
@@ -17,7 +19,7 @@
 /*
  * Proxy class for interface org.deepin.dde.Zone1
  */
-class DBusHotzone: public QDBusAbstractInterface
+class DBusHotzone: public DBusInstrumentedInterface
 {
     Q_OBJECT
     Q_SLOT void __propertyChanged__(const QDBusMessage& msg)
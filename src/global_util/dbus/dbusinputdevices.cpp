@@ -25,7 +25,7 @@ const QDBusArgument &operator>>(const QDBusArgument &argument, InputDevice &devi
 }
 
 DBusInputDevices::DBusInputDevices(QObject *parent)
-    : QDBusAbstractInterface(staticServiceName(), staticObjectPath(), staticInterfaceName(), QDBusConnection::sessionBus(), parent)
+    : DBusInstrumentedInterface(staticServiceName(), staticObjectPath(), staticInterfaceName(), QDBusConnection::sessionBus(), parent)
 {
     qDBusRegisterMetaType<InputDevice>();
     qDBusRegisterMetaType<InputDeviceList>();
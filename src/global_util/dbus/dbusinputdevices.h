@@ -5,6 +5,8 @@
 #ifndef DBUSINPUTDEVICES_H_1439802129
 #define DBUSINPUTDEVICES_H_1439802129
 
+#include "dbusmetrics.h"
+
 #include <QtCore/QObject>
 #include <QtCore/QByteArray>
 #include <QtCore/QList>
@@ -31,7 +33,7 @@ const QDBusArgument &operator>>(const QDBusArgument &argument, InputDevice &devi
 /*
  * Proxy class for interface com.deepin.dde.InputDevices1
  */
-class DBusInputDevices: public QDBusAbstractInterface
+class DBusInputDevices: public DBusInstrumentedInterface
 {
     Q_OBJECT
 
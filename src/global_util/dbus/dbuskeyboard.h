@@ -5,6 +5,8 @@
 #ifndef DBUSKEYBOARD_H_1439802333
 #define DBUSKEYBOARD_H_1439802333
 
+#include "dbusmetrics.h"
+
 #include <QtCore/QObject>
 #include <QtCore/QByteArray>
 #include <QtCore/QList>
@@ -21,7 +23,7 @@ Q_DECLARE_METATYPE(KeyboardLayoutList)
 /*
  * Proxy class for interface org.deepin.dde.InputDevice1.Keyboard
  */
-class DBusKeyboard: public QDBusAbstractInterface
+class DBusKeyboard: public DBusInstrumentedInterface
 {
     Q_OBJECT
 
@@ -5,6 +5,8 @@
 #ifndef DBUSLOCKFRONT_H
 #define DBUSLOCKFRONT_H
 
+#include "dbusmetrics.h"
+
 #include <QDBusAbstractInterface>
 #include <QDBusPendingReply>
 #include <QMetaObject>
@@ -13,7 +15,7 @@
 /*
  * Proxy class for interface org.deepin.dde.LockFront1
  */
-class DBusLockFront: public QDBusAbstractInterface
+class DBusLockFront: public DBusInstrumentedInterface
 {
     Q_OBJECT
 
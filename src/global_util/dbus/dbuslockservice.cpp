@@ -16,7 +16,7 @@
  */
 
 DBusLockService::DBusLockService(const QString &service, const QString &path, const QDBusConnection &connection, QObject *parent)
-    : QDBusAbstractInterface(service, path, staticInterfaceName(), connection, parent)
+    : DBusInstrumentedInterface(service, path, staticInterfaceName(), connection, parent)
 {
 }
 
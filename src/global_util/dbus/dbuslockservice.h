@@ -11,6 +11,8 @@
 #ifndef DBUSLOCKSERVICE_H
 #define DBUSLOCKSERVICE_H
 
+#include "dbusmetrics.h"
+
 #include <QtCore/QObject>
 #include <QtCore/QByteArray>
 #include <QtCore/QList>
@@ -23,7 +25,7 @@
 /*
  * Proxy class for interface org.deepin.dde.LockService1
  */
-class DBusLockService: public QDBusAbstractInterface
+class DBusLockService: public DBusInstrumentedInterface
 {
     Q_OBJECT
 public:
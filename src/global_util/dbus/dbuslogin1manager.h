@@ -5,6 +5,8 @@
 #ifndef DBUSLOGIN1MANAGER_H_1447400884
 #define DBUSLOGIN1MANAGER_H_1447400884
 
+#include "dbusmetrics.h"
+
 #include"dbusvariant.h"
 #include <QtCore/QObject>
 #include <QtCore/QByteArray>
@@ -18,7 +20,7 @@
 /*
  * Proxy class for interface org.freedesktop.login1.Manager
  */
-class DBusLogin1Manager: public QDBusAbstractInterface
+class DBusLogin1Manager: public DBusInstrumentedInterface
 {
     Q_OBJECT
     Q_SLOT void __propertyChanged__(const QDBusMessage& msg)
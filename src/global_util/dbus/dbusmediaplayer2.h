@@ -5,6 +5,8 @@
 #ifndef DBUSMEDIAPLAYER2_H_1446777070
 #define DBUSMEDIAPLAYER2_H_1446777070
 
+#include "dbusmetrics.h"
+
 #include <QtCore/QObject>
 #include <QtCore/QByteArray>
 #include <QtCore/QList>
@@ -20,7 +22,7 @@ Q_DECLARE_METATYPE(Dict)
 /*
  * Proxy class for interface org.mpris.MediaPlayer2.Player
  */
-class DBusMediaPlayer2: public QDBusAbstractInterface
+class DBusMediaPlayer2: public DBusInstrumentedInterface
 {
     Q_OBJECT
 
@@ -9,7 +9,7 @@
  */
 
 DisplayInterface::DisplayInterface(QObject *parent)
-    : QDBusAbstractInterface(staticServiceName(), staticObjectPath(), staticInterfaceName(), QDBusConnection::sessionBus(), parent)
+    : DBusInstrumentedInterface(staticServiceName(), staticObjectPath(), staticInterfaceName(), QDBusConnection::sessionBus(), parent)
 {
     qDBusRegisterMetaType<BrightnessMap>();
     qDBusRegisterMetaType<DisplayRect>();
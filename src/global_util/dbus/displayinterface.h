@@ -5,6 +5,8 @@
 #ifndef DISPLAYINTERFACE_H_1439948860
 #define DISPLAYINTERFACE_H_1439948860
 
+#include "dbusmetrics.h"
+
 #include <QtCore/QObject>
 #include <QtCore/QByteArray>
 #include <QtCore/QList>
@@ -39,7 +41,7 @@ QDebug operator<<(QDebug deg, const DisplayRect &rect);
 /*
  * Proxy class for interface org.deepin.dde.Display1
  */
-class DisplayInterface: public QDBusAbstractInterface
+class DisplayInterface: public DBusInstrumentedInterface
 {
     Q_OBJECT
 
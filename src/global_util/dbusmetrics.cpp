@@ -0,0 +1,230 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "dbusmetrics.h"
+
+#include <QCoreApplication>
+#include <QDBusPendingCallWatcher>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMetaProperty>
+#include <QThread>
+#include <QTimer>
+
+#include <atomic>
+#include <memory>
+
+static const int BUCKET_LIMITS[DBusMetrics::BucketCount - 1] = {1, 4, 16, 64, 256, 1024};
+
+static int bucketIndex(qint64 latency)
+{
+    const qint64 msec = latency / 1000;
+    int index = 0;
+    while (index < DBusMetrics::BucketCount - 1 && msec >= BUCKET_LIMITS[index])
+        ++index;
+    return index;
+}
+
+/**
+ * @brief 一次异步调用的状态，调用结果和调用线程回到事件循环两件事都发生后才记录
+ */
+struct PendingCallState {
+    QString interface;
+    QString method;
+    QElapsedTimer timer;
+    std::atomic<int> remaining {1};
+    std::atomic<bool> blocked {false};
+    qint64 latency = 0;
+    bool error = false;
+};
+
+static void finishPendingCall(const std::shared_ptr<PendingCallState> &state)
+{
+    if (--state->remaining == 0)
+        DBusMetrics::instance()->record(state->interface, state->method, state->blocked, state->error, state->latency);
+}
+
+DBusMetrics::DBusMetrics(QObject *parent)
+    : QObject(parent)
+    , m_thread(new QThread)
+{
+    m_thread->setObjectName("DBusMetrics");
+    m_thread->start(QThread::LowPriority);
+}
+
+DBusMetrics::~DBusMetrics()
+{
+    m_thread->quit();
+    m_thread->wait();
+    delete m_thread;
+}
+
+DBusMetrics *DBusMetrics::instance()
+{
+    static DBusMetrics metrics;
+    return &metrics;
+}
+
+/**
+ * @brief 统计一次调用的耗时
+ * 调用结果在统计线程中接收，耗时不受调用线程是否阻塞影响。
+ * 在界面线程发起的调用，如果回到事件循环之前结果就已经返回，说明界面线程等待了这次调用，按同步调用统计。
+ *
+ * @param call 调用
+ * @param interface 接口名
+ * @param method 方法名
+ */
+void DBusMetrics::watch(const QDBusPendingCall &call, const QString &interface, const QString &method)
+{
+    auto state = std::make_shared<PendingCallState>();
+    state->interface = interface;
+    state->method = method;
+    state->timer.start();
+
+    const bool checkBlocking = QCoreApplication::instance() && QThread::currentThread() == QCoreApplication::instance()->thread();
+    if (checkBlocking)
+        state->remaining = 2;
+
+    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(call);
+    connect(watcher, &QDBusPendingCallWatcher::finished, watcher, [state](QDBusPendingCallWatcher *watcher) {
+        state->latency = state->timer.nsecsElapsed() / 1000;
+        state->error = watcher->isError();
+        watcher->deleteLater();
+        finishPendingCall(state);
+    });
+    watcher->moveToThread(m_thread);
+
+    if (checkBlocking) {
+        QTimer::singleShot(0, [state, call] {
+            state->blocked = call.isFinished();
+            finishPendingCall(state);
+        });
+    }
+}
+
+/**
+ * @brief 记录一次调用
+ *
+ * @param interface 接口名
+ * @param method 方法名
+ * @param sync 是否阻塞了调用线程
+ * @param error 是否返回错误
+ * @param latency 耗时，单位微秒
+ */
+void DBusMetrics::record(const QString &interface, const QString &method, bool sync, bool error, qint64 latency)
+{
+    QMutexLocker locker(&m_mutex);
+    MethodStats &stats = m_stats[interface + "." + method];
+    if (sync)
+        ++stats.syncCount;
+    else
+        ++stats.asyncCount;
+    if (error)
+        ++stats.errorCount;
+    stats.totalLatency += latency;
+    stats.maxLatency = qMax(stats.maxLatency, latency);
+    ++stats.histogram[static_cast<size_t>(bucketIndex(latency))];
+}
+
+QMap<QString, DBusMetrics::MethodStats> DBusMetrics::stats() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_stats;
+}
+
+/**
+ * @brief 导出成 JSON，耗时单位为毫秒
+ */
+QString DBusMetrics::dump() const
+{
+    QJsonArray buckets;
+    for (int limit : BUCKET_LIMITS)
+        buckets.append(QString("<%1ms").arg(limit));
+    buckets.append(QString(">=%1ms").arg(BUCKET_LIMITS[BucketCount - 2]));
+
+    QJsonObject methods;
+    const QMap<QString, MethodStats> allStats = stats();
+    for (auto it = allStats.constBegin(); it != allStats.constEnd(); ++it) {
+        const MethodStats &stats = it.value();
+        const int count = stats.syncCount + stats.asyncCount;
+        QJsonArray histogram;
+        for (int value : stats.histogram)
+            histogram.append(value);
+        methods.insert(it.key(), QJsonObject {
+            {"sync", stats.syncCount},
+            {"async", stats.asyncCount},
+            {"errors", stats.errorCount},
+            {"avg", count > 0 ? stats.totalLatency / 1000.0 / count : 0},
+            {"max", stats.maxLatency / 1000.0},
+            {"histogram", histogram}
+        });
+    }
+
+    const QJsonObject root {
+        {"buckets", buckets},
+        {"methods", methods}
+    };
+    return QString::fromUtf8(QJsonDocument(root).toJson(QJsonDocument::Compact));
+}
+
+void DBusMetrics::reset()
+{
+    QMutexLocker locker(&m_mutex);
+    m_stats.clear();
+}
+
+DBusCallTimer::DBusCallTimer(const QString &interface, const QString &method)
+    : m_interface(interface)
+    , m_method(method)
+{
+    m_timer.start();
+}
+
+DBusCallTimer::~DBusCallTimer()
+{
+    DBusMetrics::instance()->record(m_interface, m_method, true, false, m_timer.nsecsElapsed() / 1000);
+}
+
+DBusInstrumentedInterface::DBusInstrumentedInterface(const QString &service, const QString &path, const char *interface,
+                                                     const QDBusConnection &connection, QObject *parent)
+    : QDBusAbstractInterface(service, path, interface, connection, parent)
+{
+}
+
+/**
+ * @brief 统计读取 D-Bus 属性的耗时，其它调用直接交给 QDBusAbstractInterface 处理
+ */
+int DBusInstrumentedInterface::qt_metacall(QMetaObject::Call call, int id, void **args)
+{
+    // QDBusAbstractInterface 自身的属性（objectName）不是 D-Bus 属性
+    if (call != QMetaObject::ReadProperty || id < QDBusAbstractInterface::staticMetaObject.propertyCount())
+        return QDBusAbstractInterface::qt_metacall(call, id, args);
+
+    const QMetaProperty property = metaObject()->property(id);
+    // 读取成功时不会清除 lastError，只统计这次读取新产生的错误
+    const bool hadError = lastError().isValid();
+    QElapsedTimer timer;
+    timer.start();
+    const int ret = QDBusAbstractInterface::qt_metacall(call, id, args);
+    DBusMetrics::instance()->record(interface(), QString("Get:") + property.name(), true, !hadError && lastError().isValid(),
+                                    timer.nsecsElapsed() / 1000);
+    return ret;
+}
+
+QDBusPendingCall DBusInstrumentedInterface::asyncCallWithArgumentList(const QString &method, const QList<QVariant> &args)
+{
+    const QDBusPendingCall call = QDBusAbstractInterface::asyncCallWithArgumentList(method, args);
+    DBusMetrics::instance()->watch(call, interface(), method);
+    return call;
+}
+
+QDBusMessage DBusInstrumentedInterface::callWithArgumentList(QDBus::CallMode mode, const QString &method, const QList<QVariant> &args)
+{
+    QElapsedTimer timer;
+    timer.start();
+    const QDBusMessage reply = QDBusAbstractInterface::callWithArgumentList(mode, method, args);
+    DBusMetrics::instance()->record(interface(), method, true, reply.type() == QDBusMessage::ErrorMessage, timer.nsecsElapsed() / 1000);
+    return reply;
+}
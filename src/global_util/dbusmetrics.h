@@ -0,0 +1,117 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef DBUSMETRICS_H
+#define DBUSMETRICS_H
+
+#include <QDBusAbstractInterface>
+#include <QDBusPendingCall>
+#include <QElapsedTimer>
+#include <QMap>
+#include <QMutex>
+#include <QObject>
+
+#include <array>
+#include <utility>
+
+class QThread;
+
+/**
+ * @brief D-Bus 调用耗时统计
+ * 按“接口.方法”统计调用次数、阻塞（同步）和异步调用的次数、出错次数以及耗时分布，
+ * 用于在现场找出卡住锁屏界面的同步调用。通过 org.deepin.dde.LockFront1 的 DBusMetrics 方法导出。
+ * 所有接口都是线程安全的。
+ */
+class DBusMetrics : public QObject
+{
+    Q_OBJECT
+public:
+    // 耗时分布：<1ms、<4ms、<16ms、<64ms、<256ms、<1024ms、>=1024ms
+    static constexpr int BucketCount = 7;
+
+    struct MethodStats {
+        int syncCount = 0;
+        int asyncCount = 0;
+        int errorCount = 0;
+        qint64 totalLatency = 0;    // 单位微秒
+        qint64 maxLatency = 0;      // 单位微秒
+        std::array<int, BucketCount> histogram {};
+    };
+
+    static DBusMetrics *instance();
+
+    void watch(const QDBusPendingCall &call, const QString &interface, const QString &method);
+    void record(const QString &interface, const QString &method, bool sync, bool error, qint64 latency);
+
+    QMap<QString, MethodStats> stats() const;
+    QString dump() const;
+    void reset();
+
+private:
+    explicit DBusMetrics(QObject *parent = nullptr);
+    ~DBusMetrics() override;
+
+private:
+    mutable QMutex m_mutex;
+    QMap<QString, MethodStats> m_stats;
+    QThread *m_thread;      // 在单独的线程接收调用结果，界面线程阻塞时耗时也是准确的
+};
+
+/**
+ * @brief 统计一次阻塞调用的耗时，用于读取属性等无法拿到 QDBusPendingCall 的同步调用
+ */
+class DBusCallTimer
+{
+public:
+    DBusCallTimer(const QString &interface, const QString &method);
+    ~DBusCallTimer();
+
+private:
+    Q_DISABLE_COPY(DBusCallTimer)
+
+    QString m_interface;
+    QString m_method;
+    QElapsedTimer m_timer;
+};
+
+/**
+ * @brief 统计耗时的 D-Bus 代理基类
+ * qdbusxml2cpp 生成的代理继承这个类后，方法调用都会经过这里的 asyncCallWithArgumentList/callWithArgumentList，
+ * call/asyncCall 也转到这两个方法。QDBusAbstractInterface 的这些方法不是虚函数，这里只是按名字隐藏，
+ * 通过 QDBusAbstractInterface 指针调用时不会统计，需要统计的地方要使用代理类型的指针。
+ * 读取属性时 QDBusAbstractInterface 在虚函数 qt_metacall 中发起同步调用，这里重写 qt_metacall 统计，
+ * 和指针类型无关，方法名记为“Get:属性名”。
+ * 这个类没有 Q_OBJECT，子类 moc 生成的 qt_metacall 会直接调用这里的 qt_metacall。
+ */
+class DBusInstrumentedInterface : public QDBusAbstractInterface
+{
+public:
+    DBusInstrumentedInterface(const QString &service, const QString &path, const char *interface,
+                              const QDBusConnection &connection, QObject *parent);
+
+    int qt_metacall(QMetaObject::Call call, int id, void **args) override;
+
+    QDBusPendingCall asyncCallWithArgumentList(const QString &method, const QList<QVariant> &args);
+    QDBusMessage callWithArgumentList(QDBus::CallMode mode, const QString &method, const QList<QVariant> &args);
+
+    template <typename... Args>
+    QDBusMessage call(const QString &method, Args &&...args)
+    {
+        return callWithArgumentList(QDBus::AutoDetect, method, {QVariant(std::forward<Args>(args))...});
+    }
+
+    template <typename... Args>
+    QDBusMessage call(QDBus::CallMode mode, const QString &method, Args &&...args)
+    {
+        return callWithArgumentList(mode, method, {QVariant(std::forward<Args>(args))...});
+    }
+
+    template <typename... Args>
+    QDBusPendingCall asyncCall(const QString &method, Args &&...args)
+    {
+        return asyncCallWithArgumentList(method, {QVariant(std::forward<Args>(args))...});
+    }
+};
+
+#endif // DBUSMETRICS_H
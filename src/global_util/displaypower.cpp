@@ -0,0 +1,75 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "displaypower.h"
+
+#include <DGuiApplicationHelper>
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QX11Info>
+
+#include <X11/Xlib.h>
+#include <X11/extensions/dpms.h>
+
+DGUI_USE_NAMESPACE
+
+static qint64 monotonicNow()
+{
+    static const QElapsedTimer clock = [] {
+        QElapsedTimer timer;
+        timer.start();
+        return timer;
+    }();
+    return clock.nsecsElapsed();
+}
+
+DisplayPower::DisplayPower(QObject *parent)
+    : QObject(parent)
+    , m_wakeUpCount(0)
+{
+    // 可能在 PAM 线程中首次创建，确保操作在界面线程执行
+    moveToThread(qApp->thread());
+}
+
+DisplayPower *DisplayPower::instance()
+{
+    static DisplayPower displayPower;
+    return &displayPower;
+}
+
+/**
+ * @brief 点亮屏幕，异步执行
+ */
+void DisplayPower::wakeUp()
+{
+    const qint64 requestTime = monotonicNow();
+    QMetaObject::invokeMethod(this, [this, requestTime] {
+        doWakeUp(requestTime);
+    }, Qt::QueuedConnection);
+}
+
+void DisplayPower::doWakeUp(qint64 requestTime)
+{
+    if (!DGuiApplicationHelper::isXWindowPlatform()) {
+        // Wayland 下由合成器在输入事件到来时点亮屏幕
+        qDebug() << "Skip waking up the display on non-X11 platform";
+        return;
+    }
+
+    Display *display = QX11Info::display();
+    int eventBase = 0;
+    int errorBase = 0;
+    if (!display || !DPMSQueryExtension(display, &eventBase, &errorBase) || !DPMSCapable(display)) {
+        qWarning() << "DPMS is not supported, can not wake up the display";
+        return;
+    }
+    DPMSEnable(display);
+    DPMSForceLevel(display, DPMSModeOn);
+    XSync(display, False);
+
+    qInfo() << "Wake up the display, count:" << ++m_wakeUpCount
+            << ", latency:" << (monotonicNow() - requestTime) / 1000 << "us";
+}
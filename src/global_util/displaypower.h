@@ -0,0 +1,32 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef DISPLAYPOWER_H
+#define DISPLAYPOWER_H
+
+#include <QObject>
+
+/**
+ * @brief 显示器电源管理，用于在认证过程中点亮屏幕
+ * 替代 system("xset dpms force on")，避免在认证路径上创建进程。
+ * wakeUp 可以在任意线程调用，实际操作在界面线程异步执行。
+ */
+class DisplayPower : public QObject
+{
+    Q_OBJECT
+public:
+    static DisplayPower *instance();
+
+    void wakeUp();
+
+private:
+    explicit DisplayPower(QObject *parent = nullptr);
+
+    void doWakeUp(qint64 requestTime);
+
+private:
+    quint64 m_wakeUpCount;
+};
+
+#endif // DISPLAYPOWER_H
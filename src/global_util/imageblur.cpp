@@ -0,0 +1,160 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "imageblur.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+static const int BLUR_DOWNSCALE = 4;    // 在缩小后的图片上模糊，放大后的效果和在原图上模糊接近
+
+static inline int clampIndex(int index, int length)
+{
+    return qBound(0, index, length - 1);
+}
+
+/**
+ * @brief 一行（或一列）像素的盒式模糊，使用滑动窗口求和，每个像素的计算量和半径无关
+ *
+ * @param src 源像素
+ * @param dst 目标像素
+ * @param length 像素个数
+ * @param stride 相邻像素的间隔，按行处理时为 1，按列处理时为每行的像素数
+ * @param radius 模糊半径
+ */
+static void boxBlurLineScalar(const quint32 *src, quint32 *dst, int length, int stride, int radius)
+{
+    const float inv = 1.0f / (2 * radius + 1);
+    int sum[4] = {0, 0, 0, 0};
+    auto accumulate = [&](int index, int sign) {
+        const quint32 pixel = src[clampIndex(index, length) * stride];
+        for (int c = 0; c < 4; ++c)
+            sum[c] += sign * static_cast<int>((pixel >> (c * 8)) & 0xff);
+    };
+
+    for (int i = -radius; i <= radius; ++i)
+        accumulate(i, 1);
+
+    for (int x = 0; x < length; ++x) {
+        quint32 pixel = 0;
+        for (int c = 0; c < 4; ++c)
+            pixel |= static_cast<quint32>(qRound(sum[c] * inv)) << (c * 8);
+        dst[x * stride] = pixel;
+
+        accumulate(x + radius + 1, 1);
+        accumulate(x - radius, -1);
+    }
+}
+
+#if defined(__SSE2__)
+static void boxBlurLineSimd(const quint32 *src, quint32 *dst, int length, int stride, int radius)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128 inv = _mm_set1_ps(1.0f / (2 * radius + 1));
+    // 一个像素的四个通道展开成四个 32 位整数同时计算
+    auto load = [&](int index) {
+        const __m128i pixel = _mm_cvtsi32_si128(static_cast<int>(src[clampIndex(index, length) * stride]));
+        return _mm_unpacklo_epi16(_mm_unpacklo_epi8(pixel, zero), zero);
+    };
+
+    __m128i sum = zero;
+    for (int i = -radius; i <= radius; ++i)
+        sum = _mm_add_epi32(sum, load(i));
+
+    for (int x = 0; x < length; ++x) {
+        __m128i value = _mm_cvtps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(sum), inv));
+        value = _mm_packs_epi32(value, value);
+        value = _mm_packus_epi16(value, value);
+        dst[x * stride] = static_cast<quint32>(_mm_cvtsi128_si32(value));
+
+        sum = _mm_add_epi32(sum, _mm_sub_epi32(load(x + radius + 1), load(x - radius)));
+    }
+}
+#elif defined(__ARM_NEON)
+static void boxBlurLineSimd(const quint32 *src, quint32 *dst, int length, int stride, int radius)
+{
+    const float32x4_t inv = vdupq_n_f32(1.0f / (2 * radius + 1));
+    const float32x4_t half = vdupq_n_f32(0.5f);
+    // 一个像素的四个通道展开成四个 32 位整数同时计算
+    auto load = [&](int index) {
+        const uint8x8_t pixel = vreinterpret_u8_u32(vdup_n_u32(src[clampIndex(index, length) * stride]));
+        return vmovl_u16(vget_low_u16(vmovl_u8(pixel)));
+    };
+
+    uint32x4_t sum = vdupq_n_u32(0);
+    for (int i = -radius; i <= radius; ++i)
+        sum = vaddq_u32(sum, load(i));
+
+    for (int x = 0; x < length; ++x) {
+        const uint32x4_t value = vcvtq_u32_f32(vaddq_f32(vmulq_f32(vcvtq_f32_u32(sum), inv), half));
+        const uint16x4_t value16 = vmovn_u32(value);
+        const uint8x8_t value8 = vmovn_u16(vcombine_u16(value16, value16));
+        dst[x * stride] = vget_lane_u32(vreinterpret_u32_u8(value8), 0);
+
+        sum = vaddq_u32(sum, vsubq_u32(load(x + radius + 1), load(x - radius)));
+    }
+}
+#endif
+
+/**
+ * @brief 多次盒式模糊，三次以上的效果接近高斯模糊
+ *
+ * @param image 原图
+ * @param radius 模糊半径
+ * @param passes 模糊次数
+ * @param backend 是否使用 SIMD
+ * @return QImage 模糊后的图片，格式为 Format_ARGB32_Premultiplied
+ */
+QImage ImageBlur::boxBlur(const QImage &image, int radius, int passes, Backend backend)
+{
+    if (image.isNull() || radius < 1 || passes < 1)
+        return image;
+
+    auto blurLine = boxBlurLineScalar;
+#if defined(__SSE2__) || defined(__ARM_NEON)
+    if (backend == Auto)
+        blurLine = boxBlurLineSimd;
+#else
+    Q_UNUSED(backend)
+#endif
+
+    QImage result = image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+    QImage temp(result.size(), result.format());
+    const int width = result.width();
+    const int height = result.height();
+    const int stride = result.bytesPerLine() / 4;
+    for (int pass = 0; pass < passes; ++pass) {
+        for (int y = 0; y < height; ++y) {
+            blurLine(reinterpret_cast<const quint32 *>(result.constScanLine(y)),
+                     reinterpret_cast<quint32 *>(temp.scanLine(y)), width, 1, radius);
+        }
+        const quint32 *tempBits = reinterpret_cast<const quint32 *>(temp.constBits());
+        quint32 *resultBits = reinterpret_cast<quint32 *>(result.bits());
+        for (int x = 0; x < width; ++x) {
+            blurLine(tempBits + x, resultBits + x, height, stride, radius);
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief 模糊壁纸，先缩小再模糊，最后放大回原来的尺寸
+ *
+ * @param image 屏幕尺寸的壁纸
+ * @param radius 相对原图的模糊半径
+ */
+QImage ImageBlur::blur(const QImage &image, int radius)
+{
+    if (image.isNull())
+        return image;
+
+    const QSize smallSize = (image.size() / BLUR_DOWNSCALE).expandedTo(QSize(1, 1));
+    const QImage small = image.scaled(smallSize, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+    const QImage blurred = boxBlur(small, qMax(1, radius / BLUR_DOWNSCALE));
+    return blurred.scaled(image.size(), Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+}
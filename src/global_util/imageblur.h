@@ -0,0 +1,28 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef IMAGEBLUR_H
+#define IMAGEBLUR_H
+
+#include <QImage>
+
+/**
+ * @brief 进程内的壁纸模糊
+ * ImageEffect1 服务第一次生成模糊壁纸比较慢，这里先缩小图片，多次盒式模糊近似高斯模糊后再放大，
+ * 在服务返回结果之前作为临时的模糊壁纸。盒式模糊在 x86 上使用 SSE2，在 ARM 上使用 NEON，其它平台使用标量实现。
+ * 所有接口都是线程安全的。
+ */
+class ImageBlur
+{
+public:
+    enum Backend {
+        Auto,       // 平台支持时使用 SIMD
+        Scalar      // 只使用标量实现
+    };
+
+    static QImage blur(const QImage &image, int radius = 40);
+    static QImage boxBlur(const QImage &image, int radius, int passes = 3, Backend backend = Auto);
+};
+
+#endif // IMAGEBLUR_H
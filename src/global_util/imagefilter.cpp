@@ -0,0 +1,104 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "imagefilter.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+/**
+ * @brief 一行预乘 alpha 像素的灰度
+ * 预乘后的颜色分量按 alpha 等比例缩放，直接计算灰度即可，结果不会大于 alpha。
+ *
+ * @param src 源像素
+ * @param dst 目标像素，可以和源像素相同
+ * @param length 像素个数
+ */
+static void filterLineScalar(const quint32 *src, quint32 *dst, int length)
+{
+    for (int x = 0; x < length; ++x) {
+        const QRgb pixel = src[x];
+        const uint gray = static_cast<uint>(qGray(pixel));
+        dst[x] = (pixel & 0xff000000) | gray << 16 | gray << 8 | gray;
+    }
+}
+
+#if defined(__SSE2__)
+static void filterLineSimd(const quint32 *src, quint32 *dst, int length)
+{
+    const __m128i channelMask = _mm_set1_epi32(0xff);
+    const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(0xff000000));
+    const __m128i redFactor = _mm_set1_epi32(11);
+    const __m128i blueFactor = _mm_set1_epi32(5);
+
+    int x = 0;
+    for (; x + 4 <= length; x += 4) {
+        const __m128i pixel = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + x));
+        // 每个像素占一个 32 位整数，分量和权重的乘积不超过 16 位，可以用 16 位乘法
+        const __m128i blue = _mm_and_si128(pixel, channelMask);
+        const __m128i green = _mm_and_si128(_mm_srli_epi32(pixel, 8), channelMask);
+        const __m128i red = _mm_and_si128(_mm_srli_epi32(pixel, 16), channelMask);
+        __m128i gray = _mm_add_epi16(_mm_mullo_epi16(red, redFactor), _mm_slli_epi32(green, 4));
+        gray = _mm_srli_epi32(_mm_add_epi16(gray, _mm_mullo_epi16(blue, blueFactor)), 5);
+
+        __m128i result = _mm_or_si128(gray, _mm_or_si128(_mm_slli_epi32(gray, 8), _mm_slli_epi32(gray, 16)));
+        result = _mm_or_si128(result, _mm_and_si128(pixel, alphaMask));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + x), result);
+    }
+
+    filterLineScalar(src + x, dst + x, length - x);
+}
+#elif defined(__ARM_NEON)
+static void filterLineSimd(const quint32 *src, quint32 *dst, int length)
+{
+    int x = 0;
+    for (; x + 8 <= length; x += 8) {
+        // 按分量拆开 8 个像素，val[0] 到 val[3] 依次为 B、G、R、A
+        uint8x8x4_t pixels = vld4_u8(reinterpret_cast<const uint8_t *>(src + x));
+        uint16x8_t sum = vmull_u8(pixels.val[2], vdup_n_u8(11));
+        sum = vmlal_u8(sum, pixels.val[1], vdup_n_u8(16));
+        sum = vmlal_u8(sum, pixels.val[0], vdup_n_u8(5));
+        const uint8x8_t gray = vshrn_n_u16(sum, 5);
+
+        for (int c = 0; c < 3; ++c)
+            pixels.val[c] = gray;
+        vst4_u8(reinterpret_cast<uint8_t *>(dst + x), pixels);
+    }
+
+    filterLineScalar(src + x, dst + x, length - x);
+}
+#endif
+
+/**
+ * @brief 转成灰度图，透明度保持不变
+ *
+ * @param image 原图，任意格式
+ * @param backend 是否使用 SIMD
+ * @return QImage 灰度图，格式为 Format_ARGB32_Premultiplied
+ */
+QImage ImageFilter::grayscale(const QImage &image, Backend backend)
+{
+    if (image.isNull())
+        return image;
+
+    auto filterLine = filterLineScalar;
+#if defined(__SSE2__) || defined(__ARM_NEON)
+    if (backend == ImageFilter::Auto)
+        filterLine = filterLineSimd;
+#else
+    Q_UNUSED(backend)
+#endif
+
+    // 其它格式（Indexed8、RGB888、ARGB32 等）先转成预乘 alpha 的格式
+    QImage result = image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+    for (int y = 0; y < result.height(); ++y) {
+        quint32 *line = reinterpret_cast<quint32 *>(result.scanLine(y));
+        filterLine(line, line, result.width());
+    }
+
+    return result;
+}
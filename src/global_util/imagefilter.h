@@ -0,0 +1,27 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef IMAGEFILTER_H
+#define IMAGEFILTER_H
+
+#include <QImage>
+
+/**
+ * @brief 头像等小图片的逐像素滤镜
+ * 支持 QImage 能转换的所有格式，结果统一为 Format_ARGB32_Premultiplied，可以直接缓存后绘制。
+ * 灰度和 qGray 的计算结果完全一致，在 x86 上使用 SSE2，在 ARM 上使用 NEON，其它平台使用标量实现。
+ * 所有接口都是线程安全的。
+ */
+class ImageFilter
+{
+public:
+    enum Backend {
+        Auto,       // 平台支持时使用 SIMD
+        Scalar      // 只使用标量实现
+    };
+
+    static QImage grayscale(const QImage &image, Backend backend = Auto);
+};
+
+#endif // IMAGEFILTER_H
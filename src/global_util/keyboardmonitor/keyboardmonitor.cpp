@@ -7,7 +7,7 @@
 
 DGUI_USE_NAMESPACE
 
-KeyboardMonitor::KeyboardMonitor() : QThread()
+KeyboardMonitor::KeyboardMonitor() : QObject()
 {
     if (DGuiApplicationHelper::isXWindowPlatform()) {
         keyBoardPlatform = new KeyboardPlantformX11();
@@ -43,8 +43,3 @@ bool KeyboardMonitor::setNumlockStatus(const bool &on)
 {
     return keyBoardPlatform->setNumlockStatus(on);
 }
-
-void KeyboardMonitor::run()
-{
-    keyBoardPlatform->run();
-}
@@ -5,11 +5,11 @@
 #ifndef KEYBOARDMONITOR_H
 #define KEYBOARDMONITOR_H
 
-#include <QThread>
+#include <QObject>
 #include "keyboardplantform_x11.h"
 #include "keyboardplantform_wayland.h"
 
-class KeyboardMonitor : public QThread
+class KeyboardMonitor : public QObject
 {
     Q_OBJECT
 public:
@@ -23,9 +23,6 @@ signals:
     void capslockStatusChanged(bool on);
     void numlockStatusChanged(bool on);
 
-protected:
-    void run() Q_DECL_OVERRIDE;
-
 private:
     KeyboardMonitor();
     KeyBoardPlatform* keyBoardPlatform = nullptr;
@@ -28,7 +28,3 @@ bool KeyboardPlantformWayland::setNumlockStatus(const bool &on)
     Q_UNUSED(on);
     return false;
 }
-
-void KeyboardPlantformWayland::run()
-{
-}
@@ -21,9 +21,6 @@ public:
 signals:
     void capslockStatusChanged(bool on);
     void numlockStatusChanged(bool on);
-
-protected:
-    void run() Q_DECL_OVERRIDE;
 };
 
 #endif // KEYBOARDPLANTFORM_WAYLAND_H
@@ -4,166 +4,117 @@
 
 #include "keyboardplantform_x11.h"
 
-#include <QX11Info>
+#include <QCoreApplication>
 #include <QDebug>
-
-#include <X11/X.h>
 #include <QX11Info>
-#include <X11/XKBlib.h>
-#include <X11/extensions/XInput.h>
-#include <X11/extensions/XInput2.h>
+
 #include <X11/Xlib.h>
 #include <X11/keysym.h>
 #include <X11/extensions/XTest.h>
 
-#include <stdio.h>
-#include <stdlib.h>
+#include <xcb/xcb.h>
+// xkb.h 中有名为 explicit 的成员，C++ 中无法直接包含
+#define explicit dont_use_cxx_explicit
+#include <xcb/xkb.h>
+#undef explicit
 
-static int xi2_opcode;
+static const quint32 CAPSLOCK_MASK = 0x01;
+static const quint32 NUMLOCK_MASK = 0x02;
 
-int KeyboardPlantformX11::xinput_version(Display *display)
+KeyboardPlantformX11::KeyboardPlantformX11(QObject *parent)
+    : KeyBoardPlatform(parent)
+    , m_xkbEventBase(0)
+    , m_indicatorState(0)
 {
-    XExtensionVersion *version;
-    static int vers = -1;
+    if (initXkb() && QCoreApplication::instance())
+        QCoreApplication::instance()->installNativeEventFilter(this);
+}
 
-    if (vers != -1)
-        return vers;
+KeyboardPlantformX11::~KeyboardPlantformX11()
+{
+    if (QCoreApplication::instance())
+        QCoreApplication::instance()->removeNativeEventFilter(this);
+}
 
-    version = XGetExtensionVersion(display, INAME);
+/**
+ * @brief 订阅指示灯变化并读取当前状态
+ * xkb 事件的订阅只影响 affectWhich 中指定的事件，不会改变 Qt 在同一个连接上订阅的其它 xkb 事件。
+ */
+bool KeyboardPlantformX11::initXkb()
+{
+    xcb_connection_t *connection = QX11Info::connection();
+    if (!connection)
+        return false;
 
-    if (version && (version != (XExtensionVersion*) NoSuchExtension)) {
-        vers = version->major_version;
-        XFree(version);
+    const xcb_query_extension_reply_t *extension = xcb_get_extension_data(connection, &xcb_xkb_id);
+    if (!extension || !extension->present) {
+        qWarning() << "XKB extension not available";
+        return false;
     }
 
-    /* Announce our supported version so the server treats us correctly. */
-    if (vers >= XI_2_Major)
-    {
-        const char *forced_version;
-        int maj = 2, min = 2;
-
-        forced_version = getenv("XINPUT_XI2_VERSION");
-        if (forced_version) {
-            if (sscanf(forced_version, "%d.%d", &maj, &min) != 2) {
-                fprintf(stderr, "Invalid format of XINPUT_XI2_VERSION "
-                                "environment variable. Need major.minor\n");
-                exit(1);
-            }
-            printf("Overriding XI2 version to: %d.%d\n", maj, min);
-        }
-
-        XIQueryVersion(display, &maj, &min);
+    xcb_xkb_use_extension_reply_t *useReply = xcb_xkb_use_extension_reply(connection,
+        xcb_xkb_use_extension(connection, XCB_XKB_MAJOR_VERSION, XCB_XKB_MINOR_VERSION), nullptr);
+    const bool supported = useReply && useReply->supported;
+    free(useReply);
+    if (!supported) {
+        qWarning() << "XKB extension version not supported";
+        return false;
     }
 
-    return vers;
-}
+    xcb_xkb_select_events(connection, XCB_XKB_ID_USE_CORE_KBD,
+                          XCB_XKB_EVENT_TYPE_INDICATOR_STATE_NOTIFY, 0,
+                          XCB_XKB_EVENT_TYPE_INDICATOR_STATE_NOTIFY, 0, 0, nullptr);
 
-void KeyboardPlantformX11::select_events(Display* display)
-{
-    XIEventMask m;
-    m.deviceid = XIAllMasterDevices;
-    m.mask_len = XIMaskLen(XI_LASTEVENT);
-    m.mask = (unsigned char*)calloc(m.mask_len, sizeof(char));
-
-    //    XISetMask(m.mask, XI_RawKeyPress);
-    XISetMask(m.mask, XI_RawKeyRelease);
-    //    XISetMask(m.mask, XI_RawButtonPress);
-    //    XISetMask(m.mask, XI_RawButtonRelease);
-    //    XISetMask(m.mask, XI_RawMotion);
-    //    XISetMask(m.mask, XI_RawTouchBegin);
-    //    XISetMask(m.mask, XI_RawTouchUpdate);
-    //    XISetMask(m.mask, XI_RawTouchEnd);
-
-    XISelectEvents(display, DefaultRootWindow(display), &m, 1);
-
-    free(m.mask);
-    XSync(display, False);
+    xcb_xkb_get_indicator_state_reply_t *stateReply = xcb_xkb_get_indicator_state_reply(connection,
+        xcb_xkb_get_indicator_state(connection, XCB_XKB_ID_USE_CORE_KBD), nullptr);
+    if (stateReply) {
+        m_indicatorState = stateReply->state;
+        free(stateReply);
+    }
+
+    m_xkbEventBase = extension->first_event;
+    return true;
 }
 
-int KeyboardPlantformX11::listen(Display *display)
+bool KeyboardPlantformX11::nativeEventFilter(const QByteArray &eventType, void *message, long *result)
 {
-    Window root = DefaultRootWindow(display);
-    int root_x, root_y, nouse;
-    Window noused_window;
-    unsigned int mask;
-
-    while(1)
-    {
-        XEvent ev;
-        XGenericEventCookie *cookie = static_cast<XGenericEventCookie*>(&ev.xcookie);
-        XNextEvent(display, static_cast<XEvent*>(&ev));
-
-        if (XGetEventData(display, cookie) &&
-                cookie->type == GenericEvent &&
-                cookie->extension == xi2_opcode)
-        {
-            XQueryPointer(display, root, &noused_window, &noused_window, &root_x, &root_y, &nouse, &nouse, &mask);
-            XIRawEvent* event = static_cast<XIRawEvent*>(cookie->data);
-            switch (cookie->evtype)
-            {
-            case XI_RawButtonPress:
-                /*printf("Button press: Detail(%d), X(%d), Y(%d), Mask(%u)\n", event->detail, root_x, root_y, mask);*/
-                break;
-            case XI_RawButtonRelease:
-                /*printf("Button release: Detail(%d), X(%d), Y(%d), Mask(%u)\n", event->detail, root_x, root_y, mask);*/
-                break;
-            case XI_RawKeyPress:
-                break;
-            case XI_RawKeyRelease:
-                if (event->detail == 66) { // check if the key pressed is capslock first.
-                    emit capslockStatusChanged(isCapslockOn());
-                } else if (event->detail == 77) {
-                    emit numlockStatusChanged(isNumlockOn());
-                }
-                /*printf("Key release: Detail(%d), X(%d), Y(%d), Mask(%u)\n", event->detail, root_x, root_y, mask);*/
-                break;
-            case XI_RawTouchBegin:
-                //                printf("Touch begin: Detail(%d), X(%d), Y(%d), Mask(%u)\n", event->detail, root_x, root_y, mask);
-                break;
-            case XI_RawTouchUpdate:
-                //                printf("Touch update: Detail(%d), X(%d), Y(%d), Mask(%u)\n", event->detail, root_x, root_y, mask);
-                break;
-            case XI_RawTouchEnd:
-                //                printf("Touch end: Detail(%d), X(%d), Y(%d), Mask(%u)\n", event->detail, root_x, root_y, mask);
-                break;
-            }
-        }
-
-        XFreeEventData(display, cookie);
-    }
-    return EXIT_SUCCESS;
+    Q_UNUSED(result)
+
+    if (m_xkbEventBase == 0 || eventType != "xcb_generic_event_t")
+        return false;
+
+    xcb_generic_event_t *event = static_cast<xcb_generic_event_t *>(message);
+    if ((event->response_type & ~0x80) != m_xkbEventBase)
+        return false;
+
+    // 所有 xkb 事件的 response_type 相同，第二个字节是 xkb 事件类型
+    xcb_xkb_indicator_state_notify_event_t *notify = reinterpret_cast<xcb_xkb_indicator_state_notify_event_t *>(event);
+    if (notify->xkbType == XCB_XKB_INDICATOR_STATE_NOTIFY)
+        updateIndicatorState(notify->state);
+
+    // Qt 自己也需要处理 xkb 事件，不能过滤掉
+    return false;
 }
 
-KeyboardPlantformX11::KeyboardPlantformX11(QObject *parent)
-    : KeyBoardPlatform(parent)
+void KeyboardPlantformX11::updateIndicatorState(quint32 state)
 {
+    const quint32 changed = state ^ m_indicatorState;
+    m_indicatorState = state;
 
+    if (changed & CAPSLOCK_MASK)
+        emit capslockStatusChanged(state & CAPSLOCK_MASK);
+    if (changed & NUMLOCK_MASK)
+        emit numlockStatusChanged(state & NUMLOCK_MASK);
 }
 
 bool KeyboardPlantformX11::isCapslockOn()
 {
-    bool result = false;
-    unsigned int n = 0;
-    static Display *d = QX11Info::display();
-    if (d != nullptr) {
-        XkbGetIndicatorState(d, XkbUseCoreKbd, &n);
-        result = (n & 0x01) != 0;
-    }
-    return result;
+    return m_indicatorState & CAPSLOCK_MASK;
 }
 
 bool KeyboardPlantformX11::isNumlockOn()
 {
-    bool result;
-    unsigned int n = 0;
-    static Display* d = QX11Info::display();
-    if (!d)
-        return false;
-
-    XkbGetIndicatorState(d, XkbUseCoreKbd, &n);
-    result = (n & 0x02) != 0;
-
-    return result;
+    return m_indicatorState & NUMLOCK_MASK;
 }
 
 bool KeyboardPlantformX11::setNumlockStatus(const bool &on)
@@ -172,6 +123,7 @@ bool KeyboardPlantformX11::setNumlockStatus(const bool &on)
     if (!d)
         return false;
 
+    // 连续切换时指示灯事件可能还没有收到，这里直接读取服务器上的状态
     XKeyboardState x;
     XGetKeyboardControl(d, &x);
     const bool numLockEnabled = x.led_mask & 2;
@@ -193,22 +145,3 @@ bool KeyboardPlantformX11::setNumlockStatus(const bool &on)
 
     return pressExit == 0 && releseExit == 0;
 }
-
-void KeyboardPlantformX11::run()
-{
-    Display* display = XOpenDisplay(nullptr);
-    int event, error;
-
-    if (!XQueryExtension(display, "XInputExtension", &xi2_opcode, &event, &error)) {
-        fprintf(stderr, "XInput2 not available.\n");
-        return;
-    }
-
-    if (!xinput_version(display)) {
-        fprintf(stderr, "XInput2 extension not available\n");
-        return;
-    }
-
-    select_events(display);
-    listen(display);
-}
@@ -7,23 +7,33 @@
 
 #include "keyboardplatform.h"
 
-typedef struct _XDisplay Display;
+#include <QAbstractNativeEventFilter>
 
-class KeyboardPlantformX11 : public KeyBoardPlatform
+/**
+ * @brief X11 下的大小写、数字锁定状态
+ * 在 Qt 自己的 xcb 连接上订阅 XkbIndicatorStateNotify，通过 Qt 的原生事件过滤器接收指示灯变化，
+ * 状态缓存在界面线程中，查询时不需要和 X 服务器交互。
+ */
+class KeyboardPlantformX11 : public KeyBoardPlatform, public QAbstractNativeEventFilter
 {
     Q_OBJECT
 public:
     KeyboardPlantformX11(QObject *parent = nullptr);
+    ~KeyboardPlantformX11() override;
 
     bool isCapslockOn() override;
     bool isNumlockOn() override;
     bool setNumlockStatus(const bool &on) override;
-    void run() override;
+
+    bool nativeEventFilter(const QByteArray &eventType, void *message, long *result) override;
+
+private:
+    bool initXkb();
+    void updateIndicatorState(quint32 state);
 
 private:
-    int listen(Display *display);
-    static int xinput_version(Display *display);
-    static void select_events(Display* display);
+    quint8 m_xkbEventBase;      // xkb 扩展的事件编号，为 0 表示扩展不可用
+    quint32 m_indicatorState;   // 指示灯状态，第 0 位是大小写锁定，第 1 位是数字锁定
 };
 
 #endif // KEYBOARDPLANTFORM_X11_H
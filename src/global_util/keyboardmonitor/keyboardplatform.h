@@ -17,7 +17,6 @@ public:
     virtual bool isCapslockOn() = 0;
     virtual bool isNumlockOn() = 0;
     virtual bool setNumlockStatus(const bool &on) = 0;
-    virtual void run() = 0;
 
 signals:
     void capslockStatusChanged(bool on);
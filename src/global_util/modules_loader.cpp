@@ -5,19 +5,49 @@
 #include "modules_loader.h"
 
 #include "base_module_interface.h"
+#include "modulesindex.h"
+#include "public_func.h"
+#include "tracer.h"
 #include "tray_module_interface.h"
 
 #include <QDebug>
 #include <QDir>
-#include <QLibrary>
+#include <QElapsedTimer>
 #include <QPluginLoader>
+#include <QThreadPool>
+#include <QtConcurrent>
 
 namespace dss {
 namespace module {
 
 const QString ModulesDir = "/usr/lib/dde-session-shell/modules";
+
+struct LoadResult
+{
+    BaseModuleInterface *module = nullptr;
+    QString version;
+    QString error;
+};
+
+/**
+ * @brief 加载插件并创建插件实例，在线程池中执行
+ */
+static LoadResult loadModule(const QString &path)
+{
+    DSS_TRACE_SCOPE("loadModule");
+    QPluginLoader loader(path);
+    LoadResult result;
+    result.module = dynamic_cast<BaseModuleInterface *>(loader.instance());
+    result.version = loader.metaData().value("MetaData").toObject().value("api").toString();
+    if (!result.module)
+        result.error = loader.errorString();
+
+    return result;
+}
+
 ModulesLoader::ModulesLoader(QObject *parent)
     : QThread(parent)
+    , m_indexFileName(ModulesIndex::defaultFileName())
 {
     QString localDir = QCoreApplication::applicationDirPath() + "/modules";
     addModulePath(localDir);
@@ -50,11 +80,31 @@ QHash<QString, BaseModuleInterface *> ModulesLoader::findModulesByType(const int
     return modules;
 }
 
+/**
+ * @brief 分两步加载插件
+ * 第一步只读取插件的元数据，过滤掉版本不对、类型不对或者被禁用的插件，这一步不会加载插件的动态库；
+ * 第二步在线程池中并行加载剩下的插件，再按扫描的顺序处理结果，保证 moduleFound 信号的顺序稳定。
+ */
 void ModulesLoader::run()
 {
+    DSS_TRACE_SCOPE("ModulesLoader::run");
+    QElapsedTimer timer;
+    timer.start();
+
+    const QStringList disabledModules = getDConfigValue(getDefaultConfigFileName(), "disabledModules", QStringList()).toStringList();
+    ModulesIndex index(m_indexFileName);
+    QSet<QString> keys;
+    QStringList paths;
+    TraceSpan findSpan("findModule");
     for (const auto &path : m_modulePaths) {
-        findModule(path);
+        paths.append(findModule(path, index, disabledModules, keys));
     }
+    index.save();
+    findSpan.end();
+    qInfo() << "Found" << paths.size() << "modules from metadata, cost:" << timer.elapsed() << "ms";
+
+    loadModules(paths);
+    qInfo() << "Load modules finished, cost:" << timer.elapsed() << "ms";
 }
 
 bool ModulesLoader::checkVersion(const QString &target, const QString &base)
@@ -76,35 +126,78 @@ bool ModulesLoader::checkVersion(const QString &target, const QString &base)
     return true;
 }
 
-void ModulesLoader::findModule(const QString &path)
+/**
+ * @brief 只读取插件的元数据，返回需要加载的插件
+ * 目录没有变化时直接使用索引中的元数据，不需要遍历目录和打开动态库
+ *
+ * @param path 插件目录
+ * @param index 插件元数据索引
+ * @param disabledModules 配置中禁用的插件，可以是插件的 key 或者文件名
+ * @param keys 已经找到的插件的 key，多个目录中有相同 key 的插件时只加载第一个
+ * @return QStringList 需要加载的插件路径
+ */
+QStringList ModulesLoader::findModule(const QString &path, ModulesIndex &index, const QStringList &disabledModules, QSet<QString> &keys)
 {
+    QStringList paths;
     QDir dir(path);
     if (!dir.exists()) {
         qDebug() << path << "is not exists.";
-        return;
+        return paths;
+    }
+
+    QList<ModuleMetaData> modules;
+    if (!index.modules(path, modules)) {
+        modules = ModulesIndex::scan(path);
+        index.setModules(path, modules);
     }
-    const QFileInfoList modules = dir.entryInfoList();
-    for (QFileInfo module : modules) {
-        const QString path = module.absoluteFilePath();
-        if (!QLibrary::isLibrary(path)) {
+
+    for (const ModuleMetaData &module : modules) {
+        qInfo() << module.path << "is found";
+        if (!ValidVersions.contains(module.api)) {
+            qWarning() << "The module version is error!";
             continue;
         }
-        qInfo() << module << "is found";
-        QPluginLoader loader(path);
-        const QJsonObject &meta = loader.metaData().value("MetaData").toObject();
-        QString moduleVersion = meta.value("api").toString();
-        if (!ValidVersions.contains(moduleVersion)) {
-            qWarning() << "The module version is error!";
+
+        // 元数据中可以提供 key 和 enabled，在加载插件之前去重和过滤
+        if (!module.enabled || disabledModules.contains(QFileInfo(module.path).baseName())
+                || (!module.key.isEmpty() && disabledModules.contains(module.key))) {
+            qInfo() << "plugin :" << module.path << " is disabled";
             continue;
         }
+        if (!module.key.isEmpty()) {
+            if (keys.contains(module.key) || m_modules.contains(module.key))
+                continue;
+            keys.insert(module.key);
+        }
+
+        paths.append(module.path);
+    }
+
+    return paths;
+}
+
+/**
+ * @brief 在线程池中并行加载插件，按照传入的顺序发送 moduleFound 信号
+ */
+void ModulesLoader::loadModules(const QStringList &paths)
+{
+    DSS_TRACE_SCOPE("loadModules");
+    QThreadPool threadPool;
+    QList<QFuture<LoadResult>> futures;
+    for (const QString &path : paths) {
+        futures.append(QtConcurrent::run(&threadPool, loadModule, path));
+    }
 
-        BaseModuleInterface *moduleInstance = dynamic_cast<BaseModuleInterface *>(loader.instance());
+    for (int i = 0; i < futures.size(); ++i) {
+        const LoadResult result = futures[i].result();
+        BaseModuleInterface *moduleInstance = result.module;
         if (!moduleInstance) {
-            qWarning() << loader.errorString();
+            qWarning() << result.error;
             continue;
         }
 
         // 新版本BaseModuleInterface，新增isNeedInitPlugin来判断插件是否需要加载。
+        const QString &moduleVersion = result.version;
         if (moduleVersion == "1.0.1" && !moduleInstance->isNeedInitPlugin()) {
             qInfo() << "plugin :" << moduleInstance->key() << " version:"
                     << moduleVersion << " is valid, but not need load";
@@ -6,12 +6,14 @@
 #define MODULES_LOADER_H
 
 #include <QHash>
+#include <QSet>
 #include <QThread>
 
 namespace dss {
 namespace module {
 
 class BaseModuleInterface;
+class ModulesIndex;
 class ModulesLoader : public QThread
 {
     Q_OBJECT
@@ -23,6 +25,7 @@ public:
     QHash<QString, BaseModuleInterface *> findModulesByType(const int type) const;
     inline void setModulePaths(const QStringList &paths) { m_modulePaths.clear(); m_modulePaths.append(paths); }
     inline void addModulePath(const QString &path) { m_modulePaths.append(path); }
+    inline void setIndexFileName(const QString &fileName) { m_indexFileName = fileName; }
 
 signals:
     void moduleFound(BaseModuleInterface *);
@@ -37,11 +40,13 @@ private:
     ModulesLoader &operator=(const ModulesLoader &) = delete;
 
     bool checkVersion(const QString &target, const QString &base);
-    void findModule(const QString &path);
+    QStringList findModule(const QString &path, ModulesIndex &index, const QStringList &disabledModules, QSet<QString> &keys);
+    void loadModules(const QStringList &paths);
 
 private:
     QHash<QString, BaseModuleInterface *> m_modules;
     QStringList m_modulePaths;
+    QString m_indexFileName;    // 插件元数据索引文件
 };
 
 } // namespace module
@@ -0,0 +1,173 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "modulesindex.h"
+
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QLibrary>
+#include <QPluginLoader>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+namespace dss {
+namespace module {
+
+static const int INDEX_VERSION = 1;   // 索引格式变化时修改，旧的索引自动失效
+
+static qint64 lastModified(const QFileInfo &info)
+{
+    return info.lastModified().toMSecsSinceEpoch();
+}
+
+ModulesIndex::ModulesIndex(const QString &fileName)
+    : m_fileName(fileName)
+    , m_changed(false)
+{
+    QFile file(m_fileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return;
+
+    const QJsonObject root = QJsonDocument::fromJson(file.readAll()).object();
+    if (root.value("version").toInt() != INDEX_VERSION) {
+        qInfo() << "Modules index version changed, ignore it:" << m_fileName;
+        return;
+    }
+    m_dirs = root.value("dirs").toObject();
+}
+
+/**
+ * @brief 获取索引中的插件
+ *
+ * @param dir 插件目录
+ * @param modules 目录中的插件
+ * @return bool 目录或者其中的插件有变化时返回 false，需要重新扫描
+ */
+bool ModulesIndex::modules(const QString &dir, QList<ModuleMetaData> &modules) const
+{
+    const QJsonObject dirObject = m_dirs.value(dir).toObject();
+    const QFileInfo dirInfo(dir);
+    // 增加、删除、替换插件都会修改目录的修改时间
+    if (dirObject.isEmpty() || dirObject.value("mtime").toVariant().toLongLong() != lastModified(dirInfo))
+        return false;
+
+    QList<ModuleMetaData> result;
+    for (const QJsonValue &value : dirObject.value("modules").toArray()) {
+        const QJsonObject object = value.toObject();
+        ModuleMetaData module;
+        module.path = object.value("path").toString();
+        module.mtime = object.value("mtime").toVariant().toLongLong();
+        module.size = object.value("size").toVariant().toLongLong();
+        module.iid = object.value("iid").toString();
+        module.api = object.value("api").toString();
+        module.key = object.value("key").toString();
+        module.icon = object.value("icon").toString();
+        module.enabled = object.value("enabled").toBool(true);
+
+        // 插件被直接覆盖时目录的修改时间不变，需要检查每个插件
+        const QFileInfo info(module.path);
+        if (!info.exists() || lastModified(info) != module.mtime || info.size() != module.size) {
+            qInfo() << "Modules index is stale:" << module.path;
+            return false;
+        }
+        result.append(module);
+    }
+
+    modules = result;
+    return true;
+}
+
+void ModulesIndex::setModules(const QString &dir, const QList<ModuleMetaData> &modules)
+{
+    QJsonArray array;
+    for (const ModuleMetaData &module : modules) {
+        QJsonObject object;
+        object.insert("path", module.path);
+        object.insert("mtime", module.mtime);
+        object.insert("size", module.size);
+        object.insert("iid", module.iid);
+        object.insert("api", module.api);
+        object.insert("key", module.key);
+        object.insert("icon", module.icon);
+        object.insert("enabled", module.enabled);
+        array.append(object);
+    }
+
+    QJsonObject dirObject;
+    dirObject.insert("mtime", lastModified(QFileInfo(dir)));
+    dirObject.insert("modules", array);
+    m_dirs.insert(dir, dirObject);
+    m_changed = true;
+}
+
+/**
+ * @brief 保存修改过的索引
+ */
+bool ModulesIndex::save()
+{
+    if (!m_changed)
+        return true;
+
+    if (!QDir().mkpath(QFileInfo(m_fileName).absolutePath()))
+        return false;
+
+    QJsonObject root;
+    root.insert("version", INDEX_VERSION);
+    root.insert("dirs", m_dirs);
+
+    QSaveFile file(m_fileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "Failed to create modules index:" << m_fileName << file.errorString();
+        return false;
+    }
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    if (!file.commit()) {
+        qWarning() << "Failed to save modules index:" << m_fileName << file.errorString();
+        return false;
+    }
+
+    m_changed = false;
+    return true;
+}
+
+/**
+ * @brief 遍历目录，读取每个动态库的元数据，不加载动态库
+ */
+QList<ModuleMetaData> ModulesIndex::scan(const QString &dir)
+{
+    QList<ModuleMetaData> modules;
+    const QFileInfoList infos = QDir(dir).entryInfoList();
+    for (const QFileInfo &info : infos) {
+        const QString path = info.absoluteFilePath();
+        if (!QLibrary::isLibrary(path))
+            continue;
+
+        const QJsonObject metaData = QPluginLoader(path).metaData();
+        const QJsonObject meta = metaData.value("MetaData").toObject();
+        ModuleMetaData module;
+        module.path = path;
+        module.mtime = lastModified(info);
+        module.size = info.size();
+        module.iid = metaData.value("IID").toString();
+        module.api = meta.value("api").toString();
+        module.key = meta.value("key").toString();
+        module.icon = meta.value("icon").toString();
+        module.enabled = meta.value("enabled").toBool(true);
+        modules.append(module);
+    }
+
+    return modules;
+}
+
+QString ModulesIndex::defaultFileName()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/modules.index";
+}
+
+} // namespace module
+} // namespace dss
@@ -0,0 +1,55 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef MODULESINDEX_H
+#define MODULESINDEX_H
+
+#include <QJsonObject>
+#include <QList>
+#include <QString>
+
+namespace dss {
+namespace module {
+
+/**
+ * @brief 插件元数据，不是插件的动态库 iid 为空
+ */
+struct ModuleMetaData
+{
+    QString path;
+    qint64 mtime = 0;
+    qint64 size = 0;
+    QString iid;
+    QString api;
+    QString key;
+    QString icon;
+    bool enabled = true;
+};
+
+/**
+ * @brief 插件元数据的磁盘索引
+ * 按目录保存插件的路径、修改时间、大小和元数据，目录和其中的插件都没有变化时直接使用索引，
+ * 不需要再遍历目录、打开每个动态库解析元数据。安装软件包会修改插件目录，索引随之失效。
+ */
+class ModulesIndex
+{
+public:
+    explicit ModulesIndex(const QString &fileName = defaultFileName());
+
+    bool modules(const QString &dir, QList<ModuleMetaData> &modules) const;
+    void setModules(const QString &dir, const QList<ModuleMetaData> &modules);
+    bool save();
+
+    static QList<ModuleMetaData> scan(const QString &dir);
+    static QString defaultFileName();
+
+private:
+    QString m_fileName;
+    QJsonObject m_dirs;
+    bool m_changed;
+};
+
+} // namespace module
+} // namespace dss
+#endif // MODULESINDEX_H
@@ -0,0 +1,157 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "timerscheduler.h"
+
+#include <QEvent>
+#include <QTimer>
+#include <QWidget>
+
+static const qint64 WAKEUP_WINDOW = 60 * 1000;     // 统计唤醒次数的时间窗口
+
+TimerScheduler::TimerScheduler(QObject *parent)
+    : QObject(parent)
+    , m_blackMode(false)
+    , m_sessionActive(true)
+{
+    m_clock.start();
+}
+
+TimerScheduler *TimerScheduler::instance()
+{
+    static TimerScheduler timerScheduler;
+    return &timerScheduler;
+}
+
+/**
+ * @brief 启动定时器，条件不满足时先记录下来，等条件满足后再启动
+ *
+ * @param timer 定时器
+ * @param widget 定时器所属的控件，不可见时暂停定时器
+ * @param msec 间隔，小于 0 时使用定时器当前的间隔
+ */
+void TimerScheduler::start(QTimer *timer, QWidget *widget, int msec)
+{
+    if (!timer || !widget)
+        return;
+
+    if (!m_timers.contains(timer)) {
+        connect(timer, &QTimer::timeout, this, [this, timer] {
+            onTimeout(timer);
+        });
+        connect(timer, &QObject::destroyed, this, [this, timer] {
+            m_timers.remove(timer);
+        });
+    }
+    widget->installEventFilter(this);
+
+    m_timers[timer] = {widget, msec < 0 ? timer->interval() : msec};
+    if (isRunnable(timer)) {
+        timer->start(m_timers[timer].interval);
+    } else {
+        timer->stop();
+    }
+}
+
+/**
+ * @brief 停止定时器，条件恢复后也不再启动
+ */
+void TimerScheduler::stop(QTimer *timer)
+{
+    if (!timer)
+        return;
+
+    if (m_timers.remove(timer))
+        disconnect(timer, nullptr, this, nullptr);
+    timer->stop();
+}
+
+/**
+ * @brief 最近一分钟内定时器触发的次数
+ */
+int TimerScheduler::wakeupsPerMinute()
+{
+    const qint64 now = m_clock.elapsed();
+    while (!m_wakeups.isEmpty() && now - m_wakeups.head() > WAKEUP_WINDOW)
+        m_wakeups.dequeue();
+
+    return m_wakeups.size();
+}
+
+void TimerScheduler::setBlackMode(bool blackMode)
+{
+    if (m_blackMode == blackMode)
+        return;
+
+    const bool suspended = isSuspended();
+    m_blackMode = blackMode;
+    updateTimers();
+    if (suspended != isSuspended())
+        Q_EMIT suspendedChanged(isSuspended());
+}
+
+void TimerScheduler::setSessionActive(bool active)
+{
+    if (m_sessionActive == active)
+        return;
+
+    const bool suspended = isSuspended();
+    m_sessionActive = active;
+    updateTimers();
+    if (suspended != isSuspended())
+        Q_EMIT suspendedChanged(isSuspended());
+}
+
+bool TimerScheduler::eventFilter(QObject *watched, QEvent *event)
+{
+    // 父控件显示和隐藏时子控件也会收到事件
+    if (event->type() == QEvent::Show || event->type() == QEvent::Hide) {
+        for (auto it = m_timers.constBegin(); it != m_timers.constEnd(); ++it) {
+            if (it.value().widget != watched)
+                continue;
+
+            if (event->type() == QEvent::Hide) {
+                it.key()->stop();
+            } else if (!it.key()->isActive() && isRunnable(it.key())) {
+                resumeTimer(it.key());
+            }
+        }
+    }
+
+    return QObject::eventFilter(watched, event);
+}
+
+bool TimerScheduler::isRunnable(QTimer *timer) const
+{
+    const QPointer<QWidget> &widget = m_timers.value(timer).widget;
+    return !isSuspended() && widget && widget->isVisible();
+}
+
+void TimerScheduler::resumeTimer(QTimer *timer)
+{
+    timer->start(timer->isSingleShot() ? 0 : m_timers.value(timer).interval);
+}
+
+void TimerScheduler::updateTimers()
+{
+    for (auto it = m_timers.constBegin(); it != m_timers.constEnd(); ++it) {
+        if (!isRunnable(it.key())) {
+            it.key()->stop();
+        } else if (!it.key()->isActive()) {
+            resumeTimer(it.key());
+        }
+    }
+}
+
+void TimerScheduler::onTimeout(QTimer *timer)
+{
+    m_wakeups.enqueue(m_clock.elapsed());
+    wakeupsPerMinute();
+
+    // 单次定时器触发后不再需要恢复，使用者在此之前重新启动的除外
+    if (timer->isSingleShot() && !timer->isActive()) {
+        m_timers.remove(timer);
+        disconnect(timer, nullptr, this, nullptr);
+    }
+}
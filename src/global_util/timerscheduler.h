@@ -0,0 +1,66 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef TIMERSCHEDULER_H
+#define TIMERSCHEDULER_H
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QObject>
+#include <QPointer>
+#include <QQueue>
+
+class QTimer;
+class QWidget;
+
+/**
+ * @brief 界面定时器调度
+ * 定时器所属的控件不可见、待机黑屏或者会话不活跃时暂停定时器，条件恢复后再继续，减少不必要的唤醒。
+ * 恢复时单次定时器立即触发，由使用者重新计算下一次触发的时间；重复定时器按原来的间隔继续。
+ * 同时统计最近一分钟内定时器的触发次数，用于确认唤醒次数。
+ */
+class TimerScheduler : public QObject
+{
+    Q_OBJECT
+public:
+    static TimerScheduler *instance();
+
+    void start(QTimer *timer, QWidget *widget, int msec = -1);
+    void stop(QTimer *timer);
+
+    inline bool isSuspended() const { return m_blackMode || !m_sessionActive; }
+    int wakeupsPerMinute();
+
+public Q_SLOTS:
+    void setBlackMode(bool blackMode);
+    void setSessionActive(bool active);
+
+Q_SIGNALS:
+    void suspendedChanged(bool suspended);
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+private:
+    explicit TimerScheduler(QObject *parent = nullptr);
+
+    bool isRunnable(QTimer *timer) const;
+    void resumeTimer(QTimer *timer);
+    void updateTimers();
+    void onTimeout(QTimer *timer);
+
+private:
+    struct TimerInfo {
+        QPointer<QWidget> widget;   // 定时器所属的控件
+        int interval;               // 使用者要求的间隔
+    };
+
+    QHash<QTimer *, TimerInfo> m_timers;   // 使用者要求运行的定时器
+    bool m_blackMode;
+    bool m_sessionActive;
+    QElapsedTimer m_clock;
+    QQueue<qint64> m_wakeups;              // 最近一分钟内定时器触发的时间
+};
+
+#endif // TIMERSCHEDULER_H
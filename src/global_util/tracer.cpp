@@ -0,0 +1,205 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "tracer.h"
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QTimer>
+
+#include <atomic>
+#include <chrono>
+
+#include <sys/syscall.h>
+#include <unistd.h>
+
+static const char *TRACE_FILE_ENV = "DSS_TRACE_FILE";
+
+static thread_local int traceDepth = 0;
+
+static qint64 currentThreadId()
+{
+    static thread_local const qint64 tid = static_cast<qint64>(syscall(SYS_gettid));
+    return tid;
+}
+
+Tracer::Tracer()
+    : m_fileName(qEnvironmentVariable(TRACE_FILE_ENV))
+{
+}
+
+Tracer *Tracer::instance()
+{
+    static Tracer tracer;
+    return &tracer;
+}
+
+static std::atomic<bool> &enabledFlag()
+{
+    static std::atomic<bool> enabled(!qEnvironmentVariableIsEmpty(TRACE_FILE_ENV));
+    return enabled;
+}
+
+bool Tracer::isEnabled()
+{
+    return enabledFlag().load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief 不依赖环境变量开启或关闭记录，没有设置 DSS_TRACE_FILE 时只记录在内存中，用于测试
+ */
+void Tracer::setEnabled(bool enabled)
+{
+    enabledFlag().store(enabled, std::memory_order_relaxed);
+}
+
+/**
+ * @brief 单调时钟的当前时间，单位微秒，同一台机器上不同进程的时间可以直接比较
+ */
+qint64 Tracer::now()
+{
+    using namespace std::chrono;
+    return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+void Tracer::addSpan(const QByteArray &name, qint64 begin, qint64 end, int depth)
+{
+    QMutexLocker locker(&m_mutex);
+    m_events.append({name, begin, end - begin, currentThreadId(), depth});
+}
+
+/**
+ * @brief 记录一个瞬时事件，比如启动完成
+ */
+void Tracer::addMark(const QByteArray &name)
+{
+    if (!isEnabled())
+        return;
+
+    QMutexLocker locker(&m_mutex);
+    m_events.append({name, now(), -1, currentThreadId(), traceDepth});
+}
+
+QVector<Tracer::Event> Tracer::events() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_events;
+}
+
+/**
+ * @brief 保存到环境变量 DSS_TRACE_FILE 指定的文件
+ */
+bool Tracer::save() const
+{
+    if (!isEnabled() || m_fileName.isEmpty())
+        return false;
+
+    return save(m_fileName);
+}
+
+/**
+ * @brief 保存成 Chrome trace event 格式
+ *
+ * @param fileName 文件路径
+ * @return bool 是否保存成功
+ */
+bool Tracer::save(const QString &fileName) const
+{
+    const qint64 pid = QCoreApplication::applicationPid();
+    QJsonArray traceEvents;
+    if (QCoreApplication::instance()) {
+        traceEvents.append(QJsonObject {
+            {"name", "process_name"},
+            {"ph", "M"},
+            {"pid", pid},
+            {"args", QJsonObject {{"name", QCoreApplication::applicationName()}}}
+        });
+    }
+
+    for (const Event &event : events()) {
+        QJsonObject object {
+            {"name", QString::fromUtf8(event.name)},
+            {"cat", "startup"},
+            {"ts", event.begin},
+            {"pid", pid},
+            {"tid", event.tid},
+            {"args", QJsonObject {{"depth", event.depth}}}
+        };
+        if (event.duration < 0) {
+            object.insert("ph", "i");
+            object.insert("s", "p");
+        } else {
+            object.insert("ph", "X");
+            object.insert("dur", event.duration);
+        }
+        traceEvents.append(object);
+    }
+
+    QJsonObject root {
+        {"traceEvents", traceEvents},
+        {"displayTimeUnit", "ms"}
+    };
+
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "Failed to open trace file:" << fileName << file.errorString();
+        return false;
+    }
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    if (!file.commit()) {
+        qWarning() << "Failed to save trace file:" << fileName << file.errorString();
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief 启动完成，事件循环开始后保存一次，之后延迟加载的插件等在程序退出时再保存
+ */
+void Tracer::finishStartup()
+{
+    if (!isEnabled() || !QCoreApplication::instance())
+        return;
+
+    addMark("startup finished");
+    QTimer::singleShot(0, QCoreApplication::instance(), [this] {
+        save();
+    });
+    QObject::connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, [this] {
+        save();
+    });
+}
+
+TraceSpan::TraceSpan(const char *name)
+    : m_name(nullptr)
+    , m_begin(0)
+    , m_depth(0)
+{
+    if (!Tracer::isEnabled())
+        return;
+
+    m_name = name;
+    m_depth = traceDepth++;
+    m_begin = Tracer::now();
+}
+
+TraceSpan::~TraceSpan()
+{
+    end();
+}
+
+void TraceSpan::end()
+{
+    if (!m_name)
+        return;
+
+    Tracer::instance()->addSpan(m_name, m_begin, Tracer::now(), m_depth);
+    --traceDepth;
+    m_name = nullptr;
+}
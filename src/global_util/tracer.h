@@ -0,0 +1,76 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef TRACER_H
+#define TRACER_H
+
+#include <QByteArray>
+#include <QMutex>
+#include <QString>
+#include <QVector>
+
+/**
+ * @brief 启动阶段的耗时追踪
+ * 设置了环境变量 DSS_TRACE_FILE 时记录每个阶段的开始时间（单调时钟）、耗时、线程和嵌套层级，
+ * 保存成 Chrome trace event 格式的 JSON 文件，可以用 chrome://tracing 或 Perfetto 打开比较。
+ * 没有设置环境变量时 TraceSpan 只做一次判断，不记录任何数据。测试中可以用 setEnabled 在内存中记录。
+ * 所有接口都是线程安全的。
+ */
+class Tracer
+{
+public:
+    struct Event {
+        QByteArray name;
+        qint64 begin;       // 单位微秒
+        qint64 duration;    // 单位微秒，小于 0 时是瞬时事件
+        qint64 tid;
+        int depth;
+    };
+
+    static Tracer *instance();
+    static bool isEnabled();
+    static void setEnabled(bool enabled);
+    static qint64 now();
+
+    void addSpan(const QByteArray &name, qint64 begin, qint64 end, int depth);
+    void addMark(const QByteArray &name);
+    QVector<Event> events() const;
+
+    bool save() const;
+    bool save(const QString &fileName) const;
+    void finishStartup();
+
+private:
+    Tracer();
+
+private:
+    mutable QMutex m_mutex;
+    QVector<Event> m_events;
+    QString m_fileName;
+};
+
+/**
+ * @brief 一个阶段的耗时，构造时开始，析构或调用 end 时结束
+ */
+class TraceSpan
+{
+public:
+    explicit TraceSpan(const char *name);
+    ~TraceSpan();
+
+    void end();
+
+private:
+    Q_DISABLE_COPY(TraceSpan)
+
+    const char *m_name;
+    qint64 m_begin;
+    int m_depth;
+};
+
+#define DSS_TRACE_CONCAT_IMPL(a, b) a##b
+#define DSS_TRACE_CONCAT(a, b) DSS_TRACE_CONCAT_IMPL(a, b)
+#define DSS_TRACE_SCOPE(name) TraceSpan DSS_TRACE_CONCAT(_traceSpan, __LINE__)(name)
+
+#endif // TRACER_H
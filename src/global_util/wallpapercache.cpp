@@ -0,0 +1,173 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "wallpapercache.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <QMutex>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+#include <utime.h>
+
+static const char CACHE_MAGIC[8] = {'D', 'D', 'E', 'W', 'P', 'C', '0', '1'};
+static const qint64 CACHE_MAX_SIZE = 256 * 1024 * 1024;  // 缓存目录最大占用
+static const int CACHE_MAX_AGE_DAYS = 30;                 // 超过这个天数未使用的缓存会被删除
+
+struct CacheHeader
+{
+    char magic[8];
+    qint32 width;
+    qint32 height;
+    qint32 bytesPerLine;
+    qint32 format;
+};
+
+static QMutex cacheDirMutex;
+static QString customCacheDir;
+
+QString WallpaperCache::cacheDir()
+{
+    QMutexLocker locker(&cacheDirMutex);
+    if (!customCacheDir.isEmpty())
+        return customCacheDir;
+
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/wallpapers";
+}
+
+void WallpaperCache::setCacheDir(const QString &dir)
+{
+    QMutexLocker locker(&cacheDirMutex);
+    customCacheDir = dir;
+}
+
+/**
+ * @brief 缓存文件路径，图片内容变化（修改时间或大小变化）后对应新的缓存文件
+ */
+QString WallpaperCache::cacheFile(const QString &path, const QSize &size)
+{
+    const QFileInfo info(path);
+    if (!info.exists())
+        return QString();
+
+    const QString key = QString("%1|%2|%3|%4x%5")
+                            .arg(info.absoluteFilePath())
+                            .arg(info.lastModified().toMSecsSinceEpoch())
+                            .arg(info.size())
+                            .arg(size.width())
+                            .arg(size.height());
+    const QByteArray hash = QCryptographicHash::hash(key.toUtf8(), QCryptographicHash::Sha1).toHex();
+    return cacheDir() + "/" + QString::fromLatin1(hash) + ".raw";
+}
+
+static void releaseMappedFile(void *info)
+{
+    delete static_cast<QFile *>(info);
+}
+
+/**
+ * @brief 读取缓存的壁纸，像素数据直接映射到内存
+ *
+ * @param path 原图路径
+ * @param size 屏幕物理像素尺寸
+ * @return QImage 没有缓存时返回空图片
+ */
+QImage WallpaperCache::load(const QString &path, const QSize &size)
+{
+    const QString fileName = cacheFile(path, size);
+    if (fileName.isEmpty())
+        return QImage();
+
+    QFile *file = new QFile(fileName);
+    if (!file->open(QIODevice::ReadOnly) || file->size() < static_cast<qint64>(sizeof(CacheHeader))) {
+        delete file;
+        return QImage();
+    }
+
+    uchar *data = file->map(0, file->size());
+    if (!data) {
+        delete file;
+        return QImage();
+    }
+
+    CacheHeader header;
+    memcpy(&header, data, sizeof(CacheHeader));
+    const qint64 dataSize = static_cast<qint64>(header.bytesPerLine) * header.height;
+    if (memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0
+            || header.width != size.width() || header.height != size.height()
+            || header.format <= QImage::Format_Invalid || header.format >= QImage::NImageFormats
+            || file->size() != static_cast<qint64>(sizeof(CacheHeader)) + dataSize) {
+        qWarning() << "Invalid wallpaper cache:" << fileName;
+        delete file;
+        QFile::remove(fileName);
+        return QImage();
+    }
+
+    // 更新修改时间，淘汰缓存时按最近使用时间排序
+    utime(QFile::encodeName(fileName).constData(), nullptr);
+
+    // 映射的内存随图片释放
+    return QImage(static_cast<const uchar *>(data) + sizeof(CacheHeader), header.width, header.height, header.bytesPerLine,
+                  static_cast<QImage::Format>(header.format), releaseMappedFile, file);
+}
+
+/**
+ * @brief 保存屏幕尺寸的壁纸，保存后淘汰过期的缓存
+ *
+ * @param path 原图路径
+ * @param size 屏幕物理像素尺寸
+ * @param image 缩放后的壁纸
+ */
+void WallpaperCache::save(const QString &path, const QSize &size, const QImage &image)
+{
+    if (image.isNull() || image.size() != size)
+        return;
+
+    const QString fileName = cacheFile(path, size);
+    if (fileName.isEmpty() || !QDir().mkpath(cacheDir()))
+        return;
+
+    CacheHeader header;
+    memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    header.width = image.width();
+    header.height = image.height();
+    header.bytesPerLine = image.bytesPerLine();
+    header.format = image.format();
+
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "Failed to create wallpaper cache:" << fileName << file.errorString();
+        return;
+    }
+    file.write(reinterpret_cast<const char *>(&header), sizeof(CacheHeader));
+    file.write(reinterpret_cast<const char *>(image.constBits()), image.sizeInBytes());
+    if (!file.commit()) {
+        qWarning() << "Failed to save wallpaper cache:" << fileName << file.errorString();
+        return;
+    }
+
+    evict();
+}
+
+/**
+ * @brief 删除长时间未使用的缓存，总大小超过限制时从最久未使用的开始删除
+ */
+void WallpaperCache::evict()
+{
+    QDir dir(cacheDir());
+    const QFileInfoList files = dir.entryInfoList({"*.raw"}, QDir::Files, QDir::Time);
+    const QDateTime expiredTime = QDateTime::currentDateTime().addDays(-CACHE_MAX_AGE_DAYS);
+    qint64 totalSize = 0;
+    for (const QFileInfo &info : files) {
+        totalSize += info.size();
+        if (totalSize > CACHE_MAX_SIZE || info.lastModified() < expiredTime) {
+            qDebug() << "Remove wallpaper cache:" << info.fileName();
+            QFile::remove(info.absoluteFilePath());
+        }
+    }
+}
@@ -0,0 +1,31 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef WALLPAPERCACHE_H
+#define WALLPAPERCACHE_H
+
+#include <QImage>
+#include <QString>
+
+/**
+ * @brief 屏幕尺寸壁纸的磁盘缓存
+ * 缓存按图片路径、修改时间和屏幕物理像素尺寸区分，保存未压缩的像素数据，
+ * 启动时直接映射到内存，不需要再解码和缩放原图。
+ * 所有接口都是线程安全的，可以在线程池中调用。
+ */
+class WallpaperCache
+{
+public:
+    static QImage load(const QString &path, const QSize &size);
+    static void save(const QString &path, const QSize &size, const QImage &image);
+    static void evict();
+
+    static QString cacheDir();
+    static void setCacheDir(const QString &dir);
+
+private:
+    static QString cacheFile(const QString &path, const QSize &size);
+};
+
+#endif // WALLPAPERCACHE_H
@@ -5,153 +5,266 @@
 #include <locale.h>
 #include <libintl.h>
 
-#include <QDomDocument>
-#include <QDomElement>
+#include <QDataStream>
 #include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QXmlStreamReader>
+#include <QtConcurrent>
 
 #include "xkbparser.h"
 
-XkbParser::XkbParser(QObject *parent)
-    : QObject(parent)
+static const quint32 INDEX_MAGIC = 0x786b6269;  // "xkbi"
+static const quint32 INDEX_VERSION = 1;
+static const char XKB_DOMAIN[] = "xkeyboard-config";
+
+/**
+ * @brief 添加一个布局或变体，同名的键值和描述只保留第一个，和按顺序查找的结果一致
+ */
+void XkbParser::Catalog::append(const QString &layout, const QString &variant, const QString &description)
 {
+    const QString key = layout + ";" + variant;
+    items.append(qMakePair(key, description));
+    if (!descriptions.contains(key))
+        descriptions.insert(key, description);
+    if (!keys.contains(description))
+        keys.insert(description, layout + "|" + variant);
 }
 
-QStringList XkbParser::lookUpKeyboardList(QStringList keyboardList_key) {
-    if (KeyboardLayoutList.isEmpty()) {
-        parse();
-    }
+XkbParser *XkbParser::instance()
+{
+    static XkbParser parser(BaseFile, defaultIndexFileName());
+    return &parser;
+}
+
+/**
+ * @param baseFile xkb 规则文件
+ * @param indexFile 索引文件，为空时不使用索引
+ */
+XkbParser::XkbParser(const QString &baseFile, const QString &indexFile)
+    : m_baseFile(baseFile)
+    , m_indexFile(indexFile)
+    , m_loaded(false)
+{
+}
+
+/**
+ * @brief 在线程池中提前解析，第一次查找时还没有完成会等待解析结果
+ */
+void XkbParser::preload()
+{
+    if (m_loaded || m_future.isStarted())
+        return;
+
+    m_future = QtConcurrent::run(&XkbParser::load, m_baseFile, m_indexFile);
+}
+
+/**
+ * @brief 根据 "布局;变体" 格式的键值获取翻译后的描述，找不到的键值会被忽略
+ */
+QStringList XkbParser::lookUpKeyboardList(const QStringList &keyboardList)
+{
+    const Catalog &data = catalog();
 
     QStringList result;
-    setlocale(LC_ALL, "");
-    const char xkbDomain[] = "xkeyboard-config";
-
-    for (int k = 0; k < keyboardList_key.length(); k++) {
-        QString tmpKey, head_key, tail_key;
-        tmpKey = keyboardList_key[k];
-        QStringList tmpKeyList = tmpKey.split(";");
-        if (tmpKeyList.length() == 2) {
-            head_key = tmpKeyList[0];
-            tail_key = tmpKeyList[1];
-
-            for (int i = 0; i < KeyboardLayoutList.length(); i++) {
-                if (KeyboardLayoutList[i].name == head_key) {
-                    if (tail_key.isEmpty()) {
-                        result << dgettext(xkbDomain, KeyboardLayoutList[i].description.toLatin1());
-                        break;
-                    } else {
-                        for (int j = 0; j < KeyboardLayoutList[i].variantItemList.length(); j++) {
-                            if (KeyboardLayoutList[i].variantItemList[j].name == tail_key) {
-                                result << dgettext(xkbDomain, KeyboardLayoutList[i].variantItemList[j].description.toLatin1());
-                            }
-                        }
-                        break;
-                    }
-                }
-            }
-        } else {
+    for (const QString &key : keyboardList) {
+        if (key.count(';') != 1)
             continue;
-        }
+
+        auto it = data.descriptions.constFind(key);
+        if (it != data.descriptions.constEnd())
+            result << translate(it.value());
     }
 
     return result;
 }
-QString XkbParser::lookUpKeyboardKey(const QString &keyboard_value)
-{
-    if (KeyboardLayoutList.isEmpty()) {
-        parse();
-    }
 
-    QString keyboard_key = "";
-    for (int i = 0; i < KeyboardLayoutList.length(); i++) {
-        if (KeyboardLayoutList[i].description == keyboard_value) {
-            keyboard_key = QString("%1|").arg(KeyboardLayoutList[i].name);
-            qDebug() << "keyboard_key:" << keyboard_key;
-            return keyboard_key;
-        } else {
-            for (int j = 0; j < KeyboardLayoutList[i].variantItemList.length(); j++) {
-                if (KeyboardLayoutList[i].variantItemList[j].description == keyboard_value) {
-                    keyboard_key = QString("%1|%2").arg(KeyboardLayoutList[i].name).arg(KeyboardLayoutList[i].variantItemList[j].name);
-                    return keyboard_key;
-                }
-            }
-        }
-    }
-    return keyboard_key;
+/**
+ * @brief 根据描述获取 "布局|变体" 格式的键值
+ */
+QString XkbParser::lookUpKeyboardKey(const QString &description)
+{
+    return catalog().keys.value(description);
 }
 
-bool XkbParser::parse() {
+const XkbParser::Catalog &XkbParser::catalog()
+{
+    if (!m_loaded) {
+        m_catalog = m_future.isStarted() ? m_future.result() : load(m_baseFile, m_indexFile);
+        m_future = QFuture<Catalog>();
+        m_loaded = true;
+    }
 
-    QFile baseFile(kBaseFile);
+    return m_catalog;
+}
 
-    QDomDocument document;
+QString XkbParser::translate(const QString &description)
+{
+    auto it = m_translations.constFind(description);
+    if (it != m_translations.constEnd())
+        return it.value();
 
-    if (baseFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        document.setContent(&baseFile);
-    } else {
-        qDebug() << "Failed to open base.xml";
-        return false;
+    static bool localeInitialized = false;
+    if (!localeInitialized) {
+        setlocale(LC_ALL, "");
+        localeInitialized = true;
     }
 
-    QDomElement rootElement = document.documentElement();
+    const QString translation = QString::fromUtf8(dgettext(XKB_DOMAIN, description.toUtf8().constData()));
+    m_translations.insert(description, translation);
+    return translation;
+}
 
-    if (rootElement.isNull()) {
-        qDebug() << "root element is null.";
-        return false;
+/**
+ * @brief 流式解析 base.xml，只读取 layoutList 中布局和变体的名称和描述
+ */
+XkbParser::Catalog XkbParser::parse(const QString &baseFile)
+{
+    Catalog catalog;
+
+    QFile file(baseFile);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "Failed to open" << baseFile;
+        return catalog;
     }
 
-    QDomElement layoutListElement = rootElement.firstChildElement("layoutList");
+    QXmlStreamReader xml(&file);
+    QStringList path;
+    QString layoutName;
+    QString variantName;
+    QString description;
+    while (!xml.atEnd()) {
+        const QXmlStreamReader::TokenType token = xml.readNext();
+        if (token == QXmlStreamReader::StartElement) {
+            const QString element = xml.name().toString();
+            // configItem 的 name 和 description 子元素
+            if (path.size() >= 2 && path.last() == "configItem" && path.contains("layoutList")
+                    && (element == "name" || element == "description")) {
+                const bool isVariant = path.at(path.size() - 2) == "variant";
+                const QString text = xml.readElementText();
+                if (element == "name")
+                    (isVariant ? variantName : layoutName) = text;
+                else if (description.isEmpty())     // 旧版本的 base.xml 有多个带 xml:lang 的描述，只使用第一个
+                    description = text;
+                continue;
+            }
+            if (element == "layout" || element == "variant") {
+                description.clear();
+                variantName.clear();
+                if (element == "layout")
+                    layoutName.clear();
+            }
+            path.append(element);
+        } else if (token == QXmlStreamReader::EndElement) {
+            if (path.isEmpty())
+                break;
+            path.removeLast();
+            // 布局的 configItem 结束时添加布局，在它的变体之前
+            if (xml.name() == "configItem" && !path.isEmpty() && path.last() == "layout" && path.contains("layoutList")) {
+                catalog.append(layoutName, QString(), description);
+            } else if (xml.name() == "variant" && path.contains("layoutList") && !variantName.isEmpty()) {
+                catalog.append(layoutName, variantName, description);
+            }
+        }
+    }
 
-    QDomNodeList layoutNodes = layoutListElement.elementsByTagName("layout");
+    if (xml.hasError())
+        qWarning() << "Failed to parse" << baseFile << xml.errorString();
 
-    if (layoutNodes.isEmpty()) {
-        qDebug() << "layout list is empty.";
-        return false;
-    }
+    return catalog;
+}
 
-    QDomNode layoutNode;
-    for (int layoutIndex = 0; layoutIndex < layoutNodes.size(); ++layoutIndex) {
-        VariantItem tmpVariantItem;
+/**
+ * @brief 读取键盘布局目录，索引有效时使用索引，否则解析 base.xml 并更新索引
+ */
+XkbParser::Catalog XkbParser::load(const QString &baseFile, const QString &indexFile)
+{
+    QElapsedTimer timer;
+    timer.start();
 
-        LayoutItem tmpLayoutItem;
+    Catalog catalog;
+    if (!indexFile.isEmpty() && loadIndex(baseFile, indexFile, catalog)) {
+        qInfo() << "Load xkb layouts from index, count:" << catalog.items.size() << ", cost:" << timer.elapsed() << "ms";
+        return catalog;
+    }
 
-        layoutNode = layoutNodes.at(layoutIndex);
+    catalog = parse(baseFile);
+    qInfo() << "Parse xkb layouts, count:" << catalog.items.size() << ", cost:" << timer.elapsed() << "ms";
+    if (!indexFile.isEmpty() && !catalog.items.isEmpty())
+        saveIndex(baseFile, indexFile, catalog);
 
-        QDomElement configElement = layoutNode.firstChildElement("configItem");
-        QDomElement nameElement = configElement.firstChildElement("name");
-        //get the Layout element: name
-        tmpLayoutItem.name = nameElement.text();
+    return catalog;
+}
 
-        QDomElement descriptionElement = configElement.firstChildElement("description");
-        //get the Layout element: description
-        tmpLayoutItem.description = descriptionElement.text();
+/**
+ * @brief 读取索引，base.xml 的修改时间或者大小和索引中记录的不一致时索引无效
+ */
+bool XkbParser::loadIndex(const QString &baseFile, const QString &indexFile, Catalog &catalog)
+{
+    const QFileInfo baseInfo(baseFile);
+    QFile file(indexFile);
+    if (!baseInfo.exists() || !file.open(QIODevice::ReadOnly))
+        return false;
 
-        QDomElement variantListElement = layoutNode.firstChildElement("variantList");
-        QDomNodeList variantNodes = variantListElement.elementsByTagName("variant");
-        QDomNode variantNode;
-        for (int variantIndex = 0; variantIndex < variantNodes.size(); ++variantIndex) {
-            variantNode = variantNodes.at(variantIndex);
-            if (variantNode.isNull()) {
-                qDebug() << "variant node is null.";
-                continue;
-            }
+    QDataStream stream(&file);
+    quint32 magic = 0;
+    quint32 version = 0;
+    qint64 mtime = 0;
+    qint64 size = 0;
+    qint32 count = 0;
+    stream >> magic >> version;
+    if (magic != INDEX_MAGIC || version != INDEX_VERSION)
+        return false;
 
-            QDomElement variantConfigElement = variantNode.firstChildElement("configItem");
-            if (variantConfigElement.isNull()) {
-                qDebug() << "variant config element is null.";
-                continue;
-            }
-            QDomElement variantNameElement = variantConfigElement.firstChildElement("name");
-            tmpVariantItem.name = variantNameElement.text();
-            QDomElement variantDescriptionElement = variantConfigElement.firstChildElement("description");
-            tmpVariantItem.description = variantDescriptionElement.text();
+    stream.setVersion(QDataStream::Qt_5_11);
+    stream >> mtime >> size >> count;
+    if (stream.status() != QDataStream::Ok || mtime != baseInfo.lastModified().toMSecsSinceEpoch()
+            || size != baseInfo.size() || count < 0)
+        return false;
 
-            tmpLayoutItem.variantItemList.append(tmpVariantItem);
-        }
-        KeyboardLayoutList.append(tmpLayoutItem);
+    Catalog result;
+    result.items.reserve(count);
+    result.descriptions.reserve(count);
+    result.keys.reserve(count);
+    for (qint32 i = 0; i < count; ++i) {
+        QString key;
+        QString description;
+        stream >> key >> description;
+        const int separator = key.indexOf(';');
+        if (stream.status() != QDataStream::Ok || separator < 0)
+            return false;
+        result.append(key.left(separator), key.mid(separator + 1), description);
     }
+
+    catalog = result;
     return true;
 }
 
-XkbParser::~XkbParser() {
+bool XkbParser::saveIndex(const QString &baseFile, const QString &indexFile, const Catalog &catalog)
+{
+    const QFileInfo baseInfo(baseFile);
+    QDir().mkpath(QFileInfo(indexFile).absolutePath());
+    QSaveFile file(indexFile);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "Failed to open xkb index:" << indexFile << file.errorString();
+        return false;
+    }
+
+    QDataStream stream(&file);
+    stream << INDEX_MAGIC << INDEX_VERSION;
+    stream.setVersion(QDataStream::Qt_5_11);
+    stream << baseInfo.lastModified().toMSecsSinceEpoch() << baseInfo.size() << static_cast<qint32>(catalog.items.size());
+    for (const auto &item : catalog.items)
+        stream << item.first << item.second;
 
+    return file.commit();
+}
+
+QString XkbParser::defaultIndexFileName()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/xkb.index";
 }
@@ -5,36 +5,58 @@
 #ifndef XKBPARSER_H
 #define XKBPARSER_H
 
-#include <QtXml>
-#include <QtXmlDepends>
-#include <QObject>
-#include <QFile>
-
-class XkbParser: public QObject
+#include <QFuture>
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+/**
+ * @brief 键盘布局目录
+ * 从 xkb 的 base.xml 读取键盘布局和变体的描述，进程内共用一份。
+ * base.xml 比较大，使用 QXmlStreamReader 流式解析，可以调用 preload 提前在线程池中解析；
+ * 解析结果保存到索引文件，base.xml 没有变化时直接读取索引。
+ * 查找使用哈希表，翻译结果也会缓存。查找接口只在界面线程使用。
+ */
+class XkbParser
 {
 public:
-    XkbParser(QObject *parent = nullptr);
-    ~XkbParser() override;
+    struct Catalog {
+        QVector<QPair<QString, QString>> items;     // 按 base.xml 中的顺序，键值为 "布局;变体"，布局本身的变体为空
+        QHash<QString, QString> descriptions;       // "布局;变体" -> 描述
+        QHash<QString, QString> keys;               // 描述 -> "布局|变体"
 
-    struct VariantItem {
-        QString name;
-        QString description;
-    };
-    struct LayoutItem {
-        QString name;
-        QString description;
-        QList<VariantItem> variantItemList;
+        void append(const QString &layout, const QString &variant, const QString &description);
     };
-    QList<LayoutItem> KeyboardLayoutList;
 
-public slots:
-    QStringList lookUpKeyboardList(QStringList keyboardList_key);
-    QString lookUpKeyboardKey(const QString &keyboard_value);
+    static XkbParser *instance();
+
+    explicit XkbParser(const QString &baseFile = BaseFile, const QString &indexFile = QString());
+
+    void preload();
+
+    QStringList lookUpKeyboardList(const QStringList &keyboardList);
+    QString lookUpKeyboardKey(const QString &description);
+
+    static Catalog parse(const QString &baseFile);
+    static Catalog load(const QString &baseFile, const QString &indexFile);
+    static bool loadIndex(const QString &baseFile, const QString &indexFile, Catalog &catalog);
+    static bool saveIndex(const QString &baseFile, const QString &indexFile, const Catalog &catalog);
+    static QString defaultIndexFileName();
+
+    static constexpr const char *BaseFile = "/usr/share/X11/xkb/rules/base.xml";
 
 private:
-    const char* kBaseFile = "/usr/share/X11/xkb/rules/base.xml";
+    const Catalog &catalog();
+    QString translate(const QString &description);
 
-    bool parse();
+private:
+    QString m_baseFile;
+    QString m_indexFile;
+    QFuture<Catalog> m_future;
+    bool m_loaded;
+    Catalog m_catalog;
+    QHash<QString, QString> m_translations;     // 描述 -> 翻译后的描述
 };
 
 #endif // XKBPARSER_H
@@ -0,0 +1,205 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "authstatemachine.h"
+
+#include "authcommon.h"
+
+#include <QDebug>
+#include <QTimer>
+
+using namespace AuthCommon;
+
+const int AuthStateMachine::EndTimeout;
+const int AuthStateMachine::MaxEventCount;
+
+AuthStateMachine::AuthStateMachine(QObject *parent)
+    : QObject(parent)
+    , m_endTimer(new QTimer(this))
+{
+    m_endTimer->setSingleShot(true);
+    connect(m_endTimer, &QTimer::timeout, this, &AuthStateMachine::onEndTimeout);
+    m_clock.start();
+}
+
+/**
+ * @brief 处理认证服务发来的状态
+ * 先转发给 worker 处理，如果这个因子在等待 Ended，再更新界面和重新开启认证
+ *
+ * @param type      认证类型
+ * @param state     认证状态
+ * @param message   认证消息
+ */
+void AuthStateMachine::handleStatus(const int type, const int state, const QString &message)
+{
+    appendEvent({Event::Status, type, state, message, false});
+
+    switch (state) {
+    case AS_Started:
+        m_factorStates[type] = FS_Running;
+        break;
+    case AS_Ended:
+        if (!m_pendings.contains(type))
+            m_factorStates[type] = FS_Idle;
+        break;
+    case AS_Cancel:
+        if (type == AT_All) {
+            m_factorStates.clear();
+            m_pendings.clear();
+            m_endTimer->stop();
+        }
+        break;
+    default:
+        break;
+    }
+
+    emit statusChanged(type, state, message);
+
+    if (state == AS_Ended && m_pendings.contains(type))
+        completeFactor(type);
+}
+
+/**
+ * @brief 结束一个因子，收到 Ended 之后再发送 state 并按需重新开启
+ *
+ * @param type      认证类型
+ * @param state     Ended 之后要更新的状态，AS_None 表示不需要更新
+ * @param message   认证消息
+ * @param restart   是否重新开启
+ */
+void AuthStateMachine::finishFactor(const int type, const int state, const QString &message, const bool restart)
+{
+    appendEvent({Event::Finish, type, state, message, restart});
+
+    m_factorStates[type] = FS_Ending;
+    m_pendings[type] = {state, message, restart, m_clock.elapsed() + EndTimeout};
+    scheduleEndTimer();
+
+    emit requestEndAuthentication(type);
+}
+
+/**
+ * @brief 不使用认证框架时结束认证不会发送 Ended，由 worker 调用这个接口直接完成
+ */
+void AuthStateMachine::markEnded(const int type)
+{
+    appendEvent({Event::Ended, type, AS_Ended, QString(), false});
+
+    if (m_pendings.contains(type))
+        completeFactor(type);
+    else
+        m_factorStates[type] = FS_Idle;
+}
+
+/**
+ * @brief 创建或者销毁认证会话时清空所有因子的状态
+ */
+void AuthStateMachine::reset()
+{
+    appendEvent({Event::Reset, AT_All, AS_None, QString(), false});
+
+    m_factorStates.clear();
+    m_pendings.clear();
+    m_endTimer->stop();
+}
+
+AuthStateMachine::FactorState AuthStateMachine::factorState(const int type) const
+{
+    return m_factorStates.value(type, FS_Idle);
+}
+
+QList<AuthStateMachine::Event> AuthStateMachine::events() const
+{
+    return m_events;
+}
+
+/**
+ * @brief 按顺序回放事件，用于复现现场记录的时序
+ */
+void AuthStateMachine::replay(const QList<Event> &events)
+{
+    for (const Event &event : events) {
+        switch (event.kind) {
+        case Event::Status:
+            handleStatus(event.type, event.state, event.message);
+            break;
+        case Event::Finish:
+            finishFactor(event.type, event.state, event.message, event.restart);
+            break;
+        case Event::Ended:
+            markEnded(event.type);
+            break;
+        case Event::Timeout:
+            appendEvent(event);
+            expireFactor(event.type);
+            break;
+        case Event::Reset:
+            reset();
+            break;
+        }
+    }
+}
+
+/**
+ * @brief 认证服务没有发送 Ended 时，超时后按已经结束处理，避免界面停在失败前的状态
+ * 只处理已经到截止时间的因子，其它因子继续等待
+ */
+void AuthStateMachine::onEndTimeout()
+{
+    const qint64 now = m_clock.elapsed();
+    const QList<int> types = m_pendings.keys();
+    for (const int type : types) {
+        // 前面的因子完成时可能已经重新开启或者重置了其它因子
+        if (!m_pendings.contains(type) || m_pendings.value(type).deadline > now)
+            continue;
+
+        appendEvent({Event::Timeout, type, AS_None, QString(), false});
+        expireFactor(type);
+    }
+    scheduleEndTimer();
+}
+
+void AuthStateMachine::expireFactor(const int type)
+{
+    if (!m_pendings.contains(type))
+        return;
+
+    qWarning() << "Wait for auth ended timeout, type:" << type;
+    completeFactor(type);
+}
+
+void AuthStateMachine::completeFactor(const int type)
+{
+    const Pending pending = m_pendings.take(type);
+    m_factorStates[type] = FS_Idle;
+    scheduleEndTimer();
+
+    if (pending.restart)
+        emit requestStartAuthentication(type);
+    if (pending.state != AS_None)
+        emit deferredStateChanged(type, pending.state, pending.message);
+}
+
+/**
+ * @brief 按最早的截止时间重新设置定时器，没有等待的因子时停止
+ */
+void AuthStateMachine::scheduleEndTimer()
+{
+    if (m_pendings.isEmpty()) {
+        m_endTimer->stop();
+        return;
+    }
+
+    qint64 deadline = m_pendings.first().deadline;
+    for (const Pending &pending : m_pendings)
+        deadline = qMin(deadline, pending.deadline);
+    m_endTimer->start(static_cast<int>(qMax<qint64>(0, deadline - m_clock.elapsed())));
+}
+
+void AuthStateMachine::appendEvent(const Event &event)
+{
+    if (m_events.size() >= MaxEventCount)
+        m_events.removeFirst();
+    m_events.append(event);
+}
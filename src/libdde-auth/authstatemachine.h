@@ -0,0 +1,91 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef AUTHSTATEMACHINE_H
+#define AUTHSTATEMACHINE_H
+
+#include <QElapsedTimer>
+#include <QList>
+#include <QMap>
+#include <QObject>
+#include <QString>
+
+class QTimer;
+
+/**
+ * @brief 认证会话状态机，锁屏和登录共用
+ * 记录每种认证因子的状态。认证失败或者被锁定后先结束这个因子，收到认证服务的 Ended 之后
+ * 立即更新界面并按需重新开启认证，不再依赖固定的延时来保证信号时序（Bug 89056）。
+ * 每个因子单独计算等待 Ended 的超时，结束其它因子不会推迟已经在等待的因子。
+ * 所有输入都记录在事件日志中，可以回放。
+ */
+class AuthStateMachine : public QObject
+{
+    Q_OBJECT
+public:
+    enum FactorState {
+        FS_Idle,        // 未开启
+        FS_Running,     // 认证中
+        FS_Ending       // 已经调用 End，等待 Ended
+    };
+
+    struct Event {
+        enum Kind {
+            Status,     // 认证服务发来的状态
+            Finish,     // 结束某个因子
+            Ended,      // 结束时没有 Ended 信号，直接按已经结束处理
+            Timeout,    // 某个因子等待 Ended 超时
+            Reset       // 创建或者销毁认证会话
+        };
+
+        Kind kind;
+        int type;
+        int state;
+        QString message;
+        bool restart;
+    };
+
+    static const int EndTimeout = 1000;       // 等待 Ended 的最长时间，单位毫秒
+    static const int MaxEventCount = 256;     // 事件日志保留的条数
+
+    explicit AuthStateMachine(QObject *parent = nullptr);
+
+    void handleStatus(const int type, const int state, const QString &message);
+    void finishFactor(const int type, const int state, const QString &message, const bool restart);
+    void markEnded(const int type);
+    void reset();
+
+    FactorState factorState(const int type) const;
+    QList<Event> events() const;
+    void replay(const QList<Event> &events);
+
+signals:
+    void statusChanged(const int type, const int state, const QString &message);
+    void deferredStateChanged(const int type, const int state, const QString &message);
+    void requestStartAuthentication(const int type);
+    void requestEndAuthentication(const int type);
+
+private:
+    struct Pending {
+        int state;
+        QString message;
+        bool restart;
+        qint64 deadline;    // 等待 Ended 的截止时间，相对 m_clock，单位毫秒
+    };
+
+    void onEndTimeout();
+    void expireFactor(const int type);
+    void completeFactor(const int type);
+    void scheduleEndTimer();
+    void appendEvent(const Event &event);
+
+private:
+    QMap<int, FactorState> m_factorStates;
+    QMap<int, Pending> m_pendings;      // 等待 Ended 的因子，Ended 之后要更新的状态以及是否重新开启
+    QTimer *m_endTimer;                 // 在最早的截止时间触发
+    QElapsedTimer m_clock;
+    QList<Event> m_events;
+};
+
+#endif // AUTHSTATEMACHINE_H
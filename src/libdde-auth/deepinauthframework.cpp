@@ -5,10 +5,13 @@
 #include "deepinauthframework.h"
 
 #include "authcommon.h"
+#include "dbusmetrics.h"
+#include "displaypower.h"
+#include "encryptionprovider.h"
 #include "public_func.h"
 
-#include <dlfcn.h>
-
+#include <QDBusPendingCallWatcher>
+#include <QMutexLocker>
 #include <QThread>
 #include <QTimer>
 
@@ -26,9 +29,6 @@
 
 #define PAM_SERVICE_SYSTEM_NAME "password-auth"
 #define PAM_SERVICE_DEEPIN_NAME "dde-lock"
-#define PKCS1_HEADER "-----BEGIN RSA PUBLIC KEY-----"
-#define PKCS8_HEADER "-----BEGIN PUBLIC KEY-----"
-#define OPENSSLNAME "libssl.so"
 
 Q_LOGGING_CATEGORY(auth, "dss.auth")
 
@@ -38,15 +38,9 @@ DeepinAuthFramework::DeepinAuthFramework(QObject *parent)
     : QObject(parent)
     , m_authenticateInter(new AuthInter(AUTHRNTICATESERVICE, "/org/deepin/dde/Authenticate1", QDBusConnection::systemBus(), this))
     , m_watcher(new QDBusServiceWatcher(AUTHRNTICATESERVICE, QDBusConnection::systemBus(), QDBusServiceWatcher::WatchForOwnerChange, this))
-    , m_PAMAuthThread(0)
     , m_authenticateControllers(new QMap<QString, AuthControllerInter *>())
-    , m_cancelAuth(false)
-    , m_waitToken(true)
+    , m_authControllerSerial(0)
     , m_retryActivateFramework(false)
-    , m_encryptionHandle(nullptr)
-    , m_AES(new AES_KEY)
-    , m_BIO(nullptr)
-    , m_RSA(nullptr)
 {
     connect(m_watcher, &QDBusServiceWatcher::serviceOwnerChanged, this, [=](const QString &service, const QString &oldOwner, const QString &newOwner){
         qCInfo(auth) << "Service " << service << "owner changed, old owner:" << oldOwner << ", new owner:" << newOwner;
@@ -81,7 +75,6 @@ DeepinAuthFramework::~DeepinAuthFramework()
         m_authenticateControllers->remove(key);
     }
     delete m_authenticateControllers;
-    delete m_AES;
 
     DestroyAuthenticate();
 }
@@ -93,50 +86,59 @@ DeepinAuthFramework::~DeepinAuthFramework()
  */
 void DeepinAuthFramework::CreateAuthenticate(const QString &account)
 {
-    if (account == m_account && m_PAMAuthThread != 0) {
-        return;
+    if (m_PAMSession && m_PAMSession->account == account) {
+        QMutexLocker locker(&m_PAMSession->mutex);
+        if (!m_PAMSession->finished)
+            return;
     }
-    qInfo() << "Create PAM authenticate thread:" << account << m_PAMAuthThread;
-    m_account = account;
+    qInfo() << "Create PAM authenticate thread:" << account;
     DestroyAuthenticate();
-    m_cancelAuth = false;
-    m_waitToken = true;
-    int rc = pthread_create(&m_PAMAuthThread, nullptr, &PAMAuthWorker, this);
 
+    m_PAMSession = std::make_shared<PAMSession>();
+    m_PAMSession->account = account;
+    m_PAMSession->framework = this;
+
+    pthread_t thread;
+    auto arg = new std::shared_ptr<PAMSession>(m_PAMSession);
+    int rc = pthread_create(&thread, nullptr, &PAMAuthWorker, arg);
     if (rc != 0) {
-        qCritical() << "failed to create the authentication thread: %s" << strerror(errno);
+        qCritical() << "failed to create the authentication thread: %s" << strerror(rc);
+        delete arg;
+        m_PAMSession.reset();
+        return;
     }
+    // 线程通过取消标志退出，不需要等待
+    pthread_detach(thread);
 }
 
 /**
- * @brief 传入用户名
+ * @brief PAM 线程入口
  *
- * @param arg   当前对象的指针
+ * @param arg   PAM 认证共享状态的引用，由线程释放
  * @return void*
  */
 void *DeepinAuthFramework::PAMAuthWorker(void *arg)
 {
-    DeepinAuthFramework *authFramework = static_cast<DeepinAuthFramework *>(arg);
-    if (authFramework != nullptr) {
-        authFramework->PAMAuthentication(authFramework->m_account);
-    } else {
-        qCritical() << "pam auth worker deepin framework is nullptr";
-    }
+    auto sessionRef = static_cast<std::shared_ptr<PAMSession> *>(arg);
+    const std::shared_ptr<PAMSession> session = *sessionRef;
+    delete sessionRef;
+
+    PAMAuthentication(session);
     return nullptr;
 }
 
 /**
  * @brief 执行 PAM 认证
  *
- * @param account
+ * @param session
  */
-void DeepinAuthFramework::PAMAuthentication(const QString &account)
+void DeepinAuthFramework::PAMAuthentication(const std::shared_ptr<PAMSession> &session)
 {
     pam_handle_t *m_pamHandle = nullptr;
-    pam_conv conv = {PAMConversation, static_cast<void *>(this)};
+    pam_conv conv = {PAMConversation, static_cast<void *>(session.get())};
     const char *serviceName = isDeepinAuth() ? PAM_SERVICE_DEEPIN_NAME : PAM_SERVICE_SYSTEM_NAME;
 
-    int ret = pam_start(serviceName, account.toLocal8Bit().data(), &conv, &m_pamHandle);
+    int ret = pam_start(serviceName, session->account.toLocal8Bit().data(), &conv, &m_pamHandle);
     if (ret != PAM_SUCCESS) {
         qCritical() << "PAM start failed:" << pam_strerror(m_pamHandle, ret) << ret;
     } else {
@@ -146,7 +148,8 @@ void DeepinAuthFramework::PAMAuthentication(const QString &account)
     int rc = pam_authenticate(m_pamHandle, 0);
     if (rc != PAM_SUCCESS) {
         qWarning() << "PAM authenticate failed:" << pam_strerror(m_pamHandle, rc) << rc;
-        if (m_message.isEmpty()) m_message = pam_strerror(m_pamHandle, rc);
+        QMutexLocker locker(&session->mutex);
+        if (session->message.isEmpty()) session->message = pam_strerror(m_pamHandle, rc);
     } else {
         qDebug() << "PAM authenticate finished.";
     }
@@ -158,14 +161,33 @@ void DeepinAuthFramework::PAMAuthentication(const QString &account)
         qDebug() << "PAM end...";
     }
 
-    if (rc == 0) {
-        UpdateAuthState(AS_Success, m_message);
-    } else {
-        UpdateAuthState(AS_Failure, m_message);
+    QMutexLocker locker(&session->mutex);
+    session->finished = true;
+    // 主动取消的认证不再上报结果，与之前直接结束线程的行为保持一致
+    if (session->cancel || !session->framework) {
+        qInfo() << "PAM authenticate canceled";
+        return;
     }
 
-    m_PAMAuthThread = 0;
-    system("xset dpms force on");
+    session->framework->UpdateAuthState(rc == PAM_SUCCESS ? AS_Success : AS_Failure, session->message);
+    // finished 已经设置，之后 CreateAuthenticate 会创建新的线程，不会因为旧线程还在运行而直接返回
+    emit session->framework->PAMAuthenticationFinished();
+    locker.unlock();
+
+    DisplayPower::instance()->wakeUp();
+}
+
+/**
+ * @brief 在 PAM 线程中上报认证状态，认证被取消后不再上报
+ */
+void DeepinAuthFramework::UpdatePAMState(PAMSession *session, const int state, const QString &message)
+{
+    QMutexLocker locker(&session->mutex);
+    if (session->cancel || !session->framework)
+        return;
+
+    session->message = message;
+    session->framework->UpdateAuthState(state, message);
 }
 
 /**
@@ -179,13 +201,12 @@ void DeepinAuthFramework::PAMAuthentication(const QString &account)
  */
 int DeepinAuthFramework::PAMConversation(int num_msg, const pam_message **msg, pam_response **resp, void *app_data)
 {
-    DeepinAuthFramework *app_ptr = static_cast<DeepinAuthFramework *>(app_data);
+    PAMSession *session = static_cast<PAMSession *>(app_data);
     struct pam_response *aresp = nullptr;
     int idx = 0;
 
-    QPointer<DeepinAuthFramework> isThreadAlive(app_ptr);
-    if (!isThreadAlive) {
-        qWarning() << "pam: application is null";
+    if (!session) {
+        qWarning() << "pam: session is null";
         return PAM_CONV_ERR;
     }
 
@@ -204,24 +225,28 @@ int DeepinAuthFramework::PAMConversation(int num_msg, const pam_message **msg, p
         case PAM_PROMPT_ECHO_ON:
         case PAM_PROMPT_ECHO_OFF: {
             qDebug() << "pam auth echo:" << message;
-            app_ptr->UpdateAuthState(AS_Prompt, message);
-            /* 等待用户输入密码 */
-            while (app_ptr->m_waitToken) {
-                qDebug() << "Waiting for the password...";
-                if (app_ptr->m_cancelAuth) {
-                    app_ptr->m_cancelAuth = false;
-                    return PAM_ABORT;
-                }
-                sleep(1);
+            {
+                QMutexLocker locker(&session->mutex);
+                if (!session->cancel && session->framework)
+                    session->framework->UpdateAuthState(AS_Prompt, message);
             }
-            app_ptr->m_waitToken = true;
-
-            if (!QPointer<DeepinAuthFramework>(app_ptr)) {
-                qCritical() << "pam: deepin auth framework is null";
-                return PAM_CONV_ERR;
+            /* 等待用户输入密码，由 SendToken 或 DestroyAuthenticate 唤醒 */
+            QMutexLocker locker(&session->mutex);
+            qDebug() << "Waiting for the password...";
+            while (session->waitToken && !session->cancel) {
+                session->condition.wait(&session->mutex);
+            }
+            if (session->cancel) {
+                for (int i = 0; i < idx; ++i) {
+                    free(aresp[i].resp);
+                }
+                free(aresp);
+                return PAM_ABORT;
             }
+            session->waitToken = true;
 
-            aresp[idx].resp = strdup(app_ptr->m_token.toLocal8Bit().data());
+            aresp[idx].resp = strdup(session->token.toLocal8Bit().data());
+            locker.unlock();
 
             if (aresp[idx].resp == nullptr) {
                 goto fail;
@@ -232,15 +257,13 @@ int DeepinAuthFramework::PAMConversation(int num_msg, const pam_message **msg, p
         }
         case PAM_ERROR_MSG: {
             qDebug() << "pam auth error: " << message;
-            app_ptr->m_message = message;
-            app_ptr->UpdateAuthState(AS_Failure, message);
+            UpdatePAMState(session, AS_Failure, message);
             aresp[idx].resp_retcode = PAM_SUCCESS;
             break;
         }
         case PAM_TEXT_INFO: {
             qDebug() << "pam auth info: " << message;
-            app_ptr->m_message = message;
-            app_ptr->UpdateAuthState(AS_Prompt, message);
+            UpdatePAMState(session, AS_Prompt, message);
             aresp[idx].resp_retcode = PAM_SUCCESS;
             break;
         }
@@ -268,12 +291,17 @@ fail:
  */
 void DeepinAuthFramework::SendToken(const QString &token)
 {
-    if (!m_waitToken) {
+    if (!m_PAMSession) {
+        return;
+    }
+    QMutexLocker locker(&m_PAMSession->mutex);
+    if (!m_PAMSession->waitToken) {
         return;
     }
     qInfo() << "Send token to PAM";
-    m_token = token;
-    m_waitToken = false;
+    m_PAMSession->token = token;
+    m_PAMSession->waitToken = false;
+    m_PAMSession->condition.wakeAll();
 }
 
 /**
@@ -289,17 +317,21 @@ void DeepinAuthFramework::UpdateAuthState(const int state, const QString &messag
 
 /**
  * @brief 结束 PAM 认证服务
+ * 只通知线程取消并唤醒等待密码的线程，不等待线程退出，避免 pam_fail_delay 等阻塞界面线程
  */
 void DeepinAuthFramework::DestroyAuthenticate()
 {
-    if (m_PAMAuthThread == 0) {
+    if (!m_PAMSession) {
         return;
     }
     qInfo() << "Destroy PAM authenticate thread";
-    m_cancelAuth = true;
-    pthread_cancel(m_PAMAuthThread);
-    pthread_join(m_PAMAuthThread, nullptr);
-    m_PAMAuthThread = 0;
+    {
+        QMutexLocker locker(&m_PAMSession->mutex);
+        m_PAMSession->cancel = true;
+        m_PAMSession->framework = nullptr;
+        m_PAMSession->condition.wakeAll();
+    }
+    m_PAMSession.reset();
 }
 
 /**
@@ -315,70 +347,159 @@ void DeepinAuthFramework::setEncryption(const int type, ArrayInt method)
 }
 
 /**
- * @brief 初始化加密服务
+ * @brief 加密对称加密的密钥并发送给认证服务
+ *
+ * @param account
  */
-void DeepinAuthFramework::initEncryptionService()
+void DeepinAuthFramework::encryptSymmtricKey(const QString &account)
 {
-    if ((m_encryptionHandle = dlopen(OPENSSLNAME, RTLD_NOW)) == nullptr) {
-        qCritical() << "Failed to load" << OPENSSLNAME;
+    const QByteArray ciphertext = EncryptionProvider::instance()->encryptSymmetricKey(m_symmetricKey);
+    if (ciphertext.isEmpty()) {
+        qCritical() << "Failed to encrypt the symmetric key!";
         return;
     }
-    m_F_AES_cbc_encrypt = reinterpret_cast<FUNC_AES_CBC_ENCRYPT>(dlsym(m_encryptionHandle, "AES_cbc_encrypt"));
-    m_F_AES_set_encrypt_key = reinterpret_cast<FUNC_AES_SET_ENCRYPT_KEY>(dlsym(m_encryptionHandle, "AES_set_encrypt_key"));
-    m_F_BIO_new = reinterpret_cast<FUNC_BIO_NEW>(dlsym(m_encryptionHandle, "BIO_new"));
-    m_F_BIO_puts = reinterpret_cast<FUNC_BIO_PUTS>(dlsym(m_encryptionHandle, "BIO_puts"));
-    m_F_BIO_s_mem = reinterpret_cast<FUNC_BIO_S_MEM>(dlsym(m_encryptionHandle, "BIO_s_mem"));
-    m_F_PEM_read_bio_RSAPublicKey = reinterpret_cast<FUNC_PEM_READ_BIO_RSAPUBLICKEY>(dlsym(m_encryptionHandle, "PEM_read_bio_RSAPublicKey"));
-    m_F_PEM_read_bio_RSA_PUBKEY = reinterpret_cast<FUNC_PEM_READ_BIO_RSA_PUBKEY>(dlsym(m_encryptionHandle, "PEM_read_bio_RSA_PUBKEY"));
-    m_F_RSA_public_encrypt = reinterpret_cast<FUNC_RSA_PUBLIC_ENCRYPT>(dlsym(m_encryptionHandle, "RSA_public_encrypt"));
-    m_F_RSA_size = reinterpret_cast<FUNC_RSA_SIZE>(dlsym(m_encryptionHandle, "RSA_size"));
-    m_F_RSA_free = reinterpret_cast<FUNC_RSA_FREE>(dlsym(m_encryptionHandle, "RSA_free"));
-    m_F_BIO_free = reinterpret_cast<FUNC_RSA_FREE>(dlsym(m_encryptionHandle, "BIO_free"));
-
-    m_BIO = m_F_BIO_new(m_F_BIO_s_mem());
-    m_F_BIO_puts(m_BIO, m_publicKey.toLatin1().data());
+    m_authenticateControllers->value(account)->SetSymmetricKey(ciphertext);
+}
 
-    if (strncmp(m_publicKey.toLatin1().data(), PKCS8_HEADER, strlen(PKCS8_HEADER)) == 0) {
-        m_RSA = m_F_PEM_read_bio_RSA_PUBKEY(m_BIO, nullptr, nullptr, nullptr);
-    } else if (strncmp(m_publicKey.toLatin1().data(), PKCS1_HEADER, strlen(PKCS1_HEADER)) == 0) {
-        m_RSA = m_F_PEM_read_bio_RSAPublicKey(m_BIO, nullptr, nullptr, nullptr);
+/**
+ * @brief 异步创建认证服务，不阻塞界面线程
+ * 创建会话后并行获取会话的全部属性和公钥，属性就绪后发送 MFAFlagChanged 等信号，
+ * 全部完成后发送 AuthControllerReady 信号。创建过程中请求开启的认证会在创建完成后开启。
+ * 认证服务已存在时直接发送 AuthControllerReady 信号。
+ *
+ * @param account     用户名
+ * @param authType    认证方式（多因、单因，一种或多种）
+ * @param appType     发起认证的应用类型
+ */
+void DeepinAuthFramework::CreateAuthControllerAsync(const QString &account, const int authType, const int appType)
+{
+    if (m_pendingAuthControllers.contains(account)) {
+        return;
     }
-
-    /* 生成对称加密的密钥 */
-    srand(static_cast<unsigned int>(time(nullptr)));
-    int randNum = (10000000 + rand() % 10000000) % 100000000;
-    m_symmetricKey = QString::number(randNum) + QString::number(randNum);
+    if (authSessionExist(account)) {
+        emit AuthControllerReady(account, true);
+        return;
+    }
+    PendingAuthController &pending = m_pendingAuthControllers[account];
+    pending.serial = ++m_authControllerSerial;
+    pending.timer.start();
+    const quint64 serial = pending.serial;
+
+    const QDBusPendingCall authenticateCall = m_authenticateInter->Authenticate(account, authType, appType);
+    DBusMetrics::instance()->watch(authenticateCall, AUTHRNTICATESERVICE, "Authenticate");
+    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(authenticateCall, this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [this, account, authType, appType, serial](QDBusPendingCallWatcher *call) {
+        const QDBusPendingReply<QString> reply = *call;
+        call->deleteLater();
+        if (reply.isError()) {
+            qCWarning(auth) << "Failed to create authenticate session:" << account << reply.error().message();
+            if (m_pendingAuthControllers.value(account).serial == serial) {
+                m_pendingAuthControllers.remove(account);
+                emit AuthControllerReady(account, false);
+            }
+            return;
+        }
+        qInfo() << "Create Authenticate Session:" << account << authType << appType << reply.value();
+        onAuthControllerCreated(account, serial, reply.value());
+    });
 }
 
 /**
- * @brief 加密对称加密的密钥并发送给认证服务
+ * @brief 认证会话已创建，并行获取会话属性和公钥
  *
- * @param account
+ * @param account  用户名
+ * @param serial   本次创建的序号，用于丢弃过期的回复
+ * @param path     认证会话的路径
  */
-void DeepinAuthFramework::encryptSymmtricKey(const QString &account)
+void DeepinAuthFramework::onAuthControllerCreated(const QString &account, const quint64 serial, const QString &path)
 {
-    int size = m_F_RSA_size(m_RSA);
-    char *ciphertext = new char[static_cast<unsigned long>(size)];
-    m_F_RSA_public_encrypt(m_symmetricKey.length(), reinterpret_cast<unsigned char *>(m_symmetricKey.toLatin1().data()), reinterpret_cast<unsigned char *>(ciphertext), m_RSA, 1);
-    m_authenticateControllers->value(account)->SetSymmetricKey(QByteArray(ciphertext, size));
-    delete[] ciphertext;
+    if (m_pendingAuthControllers.value(account).serial != serial) {
+        // 创建过程中已被销毁，退出多余的认证会话
+        qCInfo(auth) << "Authenticate session is outdated, quit it:" << account << path;
+        QDBusConnection::systemBus().asyncCall(QDBusMessage::createMethodCall(AUTHRNTICATESERVICE, path, AUTHRNTICATEINTERFACE, "Quit"));
+        return;
+    }
+    AuthControllerInter *authControllerInter = initAuthController(account, path);
+    m_pendingAuthControllers[account].pendingReplies = 2;
+
+    QDBusMessage message = QDBusMessage::createMethodCall(AUTHRNTICATESERVICE, path, "org.freedesktop.DBus.Properties", "GetAll");
+    message << QString(AUTHRNTICATEINTERFACE);
+    const QDBusPendingCall propertiesCall = QDBusConnection::systemBus().asyncCall(message);
+    DBusMetrics::instance()->watch(propertiesCall, AUTHRNTICATEINTERFACE, "GetAll");
+    QDBusPendingCallWatcher *propertiesWatcher = new QDBusPendingCallWatcher(propertiesCall, this);
+    connect(propertiesWatcher, &QDBusPendingCallWatcher::finished, this, [this, account, serial](QDBusPendingCallWatcher *call) {
+        const QDBusPendingReply<QVariantMap> reply = *call;
+        call->deleteLater();
+        if (m_pendingAuthControllers.value(account).serial != serial) {
+            return;
+        }
+        if (reply.isError()) {
+            qCWarning(auth) << "Failed to get authenticate session properties:" << account << reply.error().message();
+        } else {
+            const QVariantMap properties = reply.value();
+            emit MFAFlagChanged(properties.value("IsMFA").toBool());
+            emit FactorsInfoChanged(qdbus_cast<MFAInfoList>(properties.value("FactorsInfo")));
+            emit FuzzyMFAChanged(properties.value("IsFuzzyMFA").toBool());
+            emit PINLenChanged(properties.value("PINLen").toInt());
+            emit PromptChanged(properties.value("Prompt").toString());
+        }
+        onAuthControllerReplyFinished(account, serial);
+    });
+
+    const QDBusPendingCall encryptCall = authControllerInter->EncryptKey(m_encryptType, m_encryptMethod);
+    DBusMetrics::instance()->watch(encryptCall, AUTHRNTICATEINTERFACE, "EncryptKey");
+    QDBusPendingCallWatcher *encryptWatcher = new QDBusPendingCallWatcher(encryptCall, this);
+    connect(encryptWatcher, &QDBusPendingCallWatcher::finished, this, [this, account, serial](QDBusPendingCallWatcher *call) {
+        const QDBusPendingReply<int, ArrayInt, QString> reply = *call;
+        call->deleteLater();
+        if (m_pendingAuthControllers.value(account).serial != serial) {
+            return;
+        }
+        if (reply.isError()) {
+            qCWarning(auth) << "Failed to get the encrypt key:" << account << reply.error().message();
+        } else {
+            m_publicKey = reply.argumentAt<2>();
+            initEncryption(account, reply.argumentAt<0>(), reply.argumentAt<1>());
+        }
+        onAuthControllerReplyFinished(account, serial);
+    });
 }
 
 /**
- * @brief 创建认证服务
+ * @brief 异步创建过程中的一个回复已处理，全部处理完成后认证服务可用
  *
- * @param account     用户名
- * @param authType    认证方式（多因、单因，一种或多种）
- * @param encryptType 加密方式
+ * @param account  用户名
+ * @param serial   本次创建的序号
  */
-void DeepinAuthFramework::CreateAuthController(const QString &account, const int authType, const int appType)
+void DeepinAuthFramework::onAuthControllerReplyFinished(const QString &account, const quint64 serial)
 {
-    if (m_authenticateControllers->contains(account) && m_authenticateControllers->value(account)->isValid()) {
+    auto it = m_pendingAuthControllers.find(account);
+    if (it == m_pendingAuthControllers.end() || it->serial != serial || --it->pendingReplies > 0) {
         return;
     }
-    const QString authControllerInterPath = m_authenticateInter->Authenticate(account, authType, appType);
-    qInfo() << "Create Authenticate Session:" << account << authType << appType << authControllerInterPath;
-    AuthControllerInter *authControllerInter = new AuthControllerInter("org.deepin.dde.Authenticate1", authControllerInterPath, QDBusConnection::systemBus(), this);
+    const PendingAuthController pending = *it;
+    qCInfo(auth) << "Authenticate session is ready:" << account << ", cost:" << pending.timer.elapsed() << "ms";
+    m_pendingAuthControllers.erase(it);
+
+    emit AuthControllerReady(account, true);
+    if (pending.startAuthType != AT_None) {
+        StartAuthentication(account, pending.startAuthType, pending.startTimeout);
+    }
+    for (const PendingToken &token : pending.tokens) {
+        SendTokenToAuth(account, token.authType, token.token);
+    }
+}
+
+/**
+ * @brief 创建认证会话的 DBus 对象并关联信号
+ *
+ * @param account  用户名
+ * @param path     认证会话的路径
+ * @return AuthControllerInter*
+ */
+AuthControllerInter *DeepinAuthFramework::initAuthController(const QString &account, const QString &path)
+{
+    AuthControllerInter *authControllerInter = new AuthControllerInter(AUTHRNTICATESERVICE, path, QDBusConnection::systemBus(), this);
     m_authenticateControllers->insert(account, authControllerInter);
 
     connect(authControllerInter, &AuthControllerInter::FactorsInfoChanged, this, &DeepinAuthFramework::FactorsInfoChanged);
@@ -392,20 +513,22 @@ void DeepinAuthFramework::CreateAuthController(const QString &account, const int
         // 当人脸或者虹膜认证成功 或者 指纹识别失败/成功 时唤醒屏幕
         if (((AT_Face == flag || AT_Iris == flag) && AS_Success == state)
             || (AT_Fingerprint == flag && (AS_Failure == state || AS_Success == state))) {
-            system("xset dpms force on");
+            DisplayPower::instance()->wakeUp();
         }
     });
 
-    emit MFAFlagChanged(authControllerInter->isMFA());
-    emit FactorsInfoChanged(authControllerInter->factorsInfo());
-    emit FuzzyMFAChanged(authControllerInter->isFuzzyMFA());
-    emit PINLenChanged(authControllerInter->pINLen());
-    emit PromptChanged(authControllerInter->prompt());
+    return authControllerInter;
+}
 
-    int encryptType;
-    ArrayInt encryptMethod;
-    QDBusReply<int> reply = authControllerInter->EncryptKey(m_encryptType, m_encryptMethod, encryptMethod, m_publicKey);
-    encryptType = reply.value();
+/**
+ * @brief 根据认证服务返回的加密方式和公钥，初始化加密服务并发送对称加密的密钥
+ *
+ * @param account        用户名
+ * @param encryptType    认证服务支持的加密类型
+ * @param encryptMethod  认证服务支持的加密方式
+ */
+void DeepinAuthFramework::initEncryption(const QString &account, const int encryptType, const ArrayInt &encryptMethod)
+{
     if (encryptType != m_encryptType || encryptMethod != m_encryptMethod) {
         qWarning() << "The current encryption method is not supported, use the default encryption method.";
         m_encryptType = encryptType;
@@ -415,8 +538,12 @@ void DeepinAuthFramework::CreateAuthController(const QString &account, const int
         qCritical() << "Failed to get the public key!";
         return;
     }
+    if (!EncryptionProvider::instance()->setPublicKey(m_publicKey)) {
+        return;
+    }
 
-    initEncryptionService();
+    /* 每个认证会话使用新的对称加密的密钥，会话内复用 */
+    m_symmetricKey = EncryptionProvider::generateSymmetricKey();
     encryptSymmtricKey(account);
 }
 
@@ -427,21 +554,17 @@ void DeepinAuthFramework::CreateAuthController(const QString &account, const int
  */
 void DeepinAuthFramework::DestroyAuthController(const QString &account)
 {
+    // 丢弃尚未完成的异步创建，其后续回复会被忽略
+    m_pendingAuthControllers.remove(account);
     if (!m_authenticateControllers->contains(account)) {
         return;
     }
     AuthControllerInter *authControllerInter = m_authenticateControllers->value(account);
     qInfo() << "Destroy Authenticate Session:" << account << authControllerInter->path();
-    authControllerInter->End(AT_All);
-    authControllerInter->Quit();
+    DBusMetrics::instance()->watch(authControllerInter->End(AT_All), AUTHRNTICATEINTERFACE, "End");
+    DBusMetrics::instance()->watch(authControllerInter->Quit(), AUTHRNTICATEINTERFACE, "Quit");
     m_authenticateControllers->remove(account);
     delete authControllerInter;
-
-    if (m_encryptionHandle) {
-        m_F_RSA_free(m_RSA);
-        m_F_BIO_free(m_BIO);
-        dlclose(m_encryptionHandle);
-    }
 }
 
 /**
@@ -453,10 +576,23 @@ void DeepinAuthFramework::DestroyAuthController(const QString &account)
  */
 void DeepinAuthFramework::StartAuthentication(const QString &account, const int authType, const int timeout)
 {
+    if (m_pendingAuthControllers.contains(account)) {
+        // 认证服务还在创建中，创建完成后再开启
+        PendingAuthController &pending = m_pendingAuthControllers[account];
+        pending.startAuthType |= authType;
+        pending.startTimeout = timeout;
+        return;
+    }
     if (!m_authenticateControllers->contains(account)) {
         return;
     }
-    int ret = m_authenticateControllers->value(account)->Start(authType, timeout);
+    AuthControllerInter *authControllerInter = m_authenticateControllers->value(account);
+    int ret = 0;
+    {
+        // 只统计 D-Bus 调用的耗时
+        DBusCallTimer callTimer(AUTHRNTICATEINTERFACE, "Start");
+        ret = authControllerInter->Start(authType, timeout);
+    }
     qInfo() << "Start Authenticate Session:" << account << authType << ret;
 }
 
@@ -468,10 +604,18 @@ void DeepinAuthFramework::StartAuthentication(const QString &account, const int
  */
 void DeepinAuthFramework::EndAuthentication(const QString &account, const int authType)
 {
+    if (m_pendingAuthControllers.contains(account)) {
+        PendingAuthController &pending = m_pendingAuthControllers[account];
+        pending.startAuthType &= ~authType;
+        for (auto it = pending.tokens.begin(); it != pending.tokens.end();) {
+            it = (it->authType & authType) ? pending.tokens.erase(it) : std::next(it);
+        }
+    }
     if (!m_authenticateControllers->contains(account)) {
         return;
     }
     qInfo() << "End Authentication:" << account << authType;
+    DBusCallTimer callTimer(AUTHRNTICATEINTERFACE, "End");
     m_authenticateControllers->value(account)->End(authType).waitForFinished();
 }
 
@@ -484,34 +628,23 @@ void DeepinAuthFramework::EndAuthentication(const QString &account, const int au
  */
 void DeepinAuthFramework::SendTokenToAuth(const QString &account, const int authType, const QString &token)
 {
+    if (m_pendingAuthControllers.contains(account)) {
+        // 认证服务还在创建中，创建完成并开启认证后再发送
+        qInfo() << "Queue token until authentication is ready:" << account << authType;
+        m_pendingAuthControllers[account].tokens.append({authType, token});
+        return;
+    }
     if (!m_authenticateControllers->contains(account)) {
         return;
     }
     qInfo() << "Send token to authentication:" << account << authType;
 
-    const int tokenSize = token.size();
-    const int padding = AES_BLOCK_SIZE - tokenSize % AES_BLOCK_SIZE;
-    const int blockCount = token.length() / AES_BLOCK_SIZE + 1;
-    const int bufferSize = blockCount * AES_BLOCK_SIZE;
-    char *tokenBuffer = new char[static_cast<size_t>(bufferSize)];
-    memset(tokenBuffer, padding, static_cast<size_t>(bufferSize));
-    memcpy(tokenBuffer, token.toLatin1().data(), static_cast<size_t>(tokenSize));
-    char *ciphertext = new char[static_cast<size_t>(bufferSize)];
-    memset(ciphertext, 0, static_cast<size_t>(bufferSize));
-    int ret = m_F_AES_set_encrypt_key(reinterpret_cast<unsigned char *>(m_symmetricKey.toLatin1().data()), m_symmetricKey.length() * 8, m_AES);
-    if (ret < 0) {
-        qCritical() << "Failed to set symmetric key!";
-        delete[] tokenBuffer;
-        delete[] ciphertext;
+    const QByteArray ciphertext = EncryptionProvider::instance()->encryptToken(m_symmetricKey, token);
+    if (ciphertext.isEmpty()) {
+        qCritical() << "Failed to encrypt the token!";
         return;
     }
-    unsigned char *iv = new unsigned char[AES_BLOCK_SIZE];
-    memset(iv, 0, AES_BLOCK_SIZE);
-    m_F_AES_cbc_encrypt(reinterpret_cast<unsigned char *>(tokenBuffer), reinterpret_cast<unsigned char *>(ciphertext), static_cast<size_t>(bufferSize), m_AES, iv, AES_ENCRYPT);
-    m_authenticateControllers->value(account)->SetToken(authType, QByteArray(ciphertext, bufferSize));
-    delete[] tokenBuffer;
-    delete[] ciphertext;
-    delete[] iv;
+    DBusMetrics::instance()->watch(m_authenticateControllers->value(account)->SetToken(authType, ciphertext), AUTHRNTICATEINTERFACE, "SetToken");
 }
 
 /**
@@ -535,6 +668,7 @@ void DeepinAuthFramework::SetAuthQuitFlag(const QString &account, const int flag
  */
 int DeepinAuthFramework::GetSupportedMixAuthFlags() const
 {
+    DBusCallTimer callTimer(AUTHRNTICATESERVICE, "SupportedFlags");
     return m_authenticateInter->supportedFlags();
 }
 
@@ -546,6 +680,7 @@ int DeepinAuthFramework::GetSupportedMixAuthFlags() const
  */
 QString DeepinAuthFramework::GetPreOneKeyLogin(const int flag) const
 {
+    DBusCallTimer callTimer(AUTHRNTICATESERVICE, "PreOneKeyLogin");
     return m_authenticateInter->PreOneKeyLogin(flag);
 }
 
@@ -556,6 +691,7 @@ QString DeepinAuthFramework::GetPreOneKeyLogin(const int flag) const
  */
 int DeepinAuthFramework::GetFrameworkState() const
 {
+    DBusCallTimer callTimer(AUTHRNTICATESERVICE, "FrameworkState");
     return m_authenticateInter->frameworkState();
 }
 
@@ -566,6 +702,7 @@ int DeepinAuthFramework::GetFrameworkState() const
  */
 QString DeepinAuthFramework::GetSupportedEncrypts() const
 {
+    DBusCallTimer callTimer(AUTHRNTICATESERVICE, "SupportEncrypts");
     return m_authenticateInter->supportEncrypts();
 }
 
@@ -577,6 +714,7 @@ QString DeepinAuthFramework::GetSupportedEncrypts() const
  */
 QString DeepinAuthFramework::GetLimitedInfo(const QString &account) const
 {
+    DBusCallTimer callTimer(AUTHRNTICATESERVICE, "GetLimits");
     return m_authenticateInter->GetLimits(account);
 }
 
@@ -5,11 +5,13 @@
 #ifndef DEEPINAUTHFRAMEWORK_H
 #define DEEPINAUTHFRAMEWORK_H
 
+#include <QElapsedTimer>
+#include <QMutex>
 #include <QObject>
 #include <QPointer>
+#include <QWaitCondition>
 
 #include <memory>
-#include <openssl/aes.h>
 
 #include "authenticate_interface.h"
 #include "authenticatesession2_interface.h"
@@ -20,17 +22,6 @@
 using AuthInter = org::deepin::dde::Authenticate1;
 using AuthControllerInter = org::deepin::dde::authenticate1::Session;
 
-using FUNC_AES_CBC_ENCRYPT = void (*)(const unsigned char *in, unsigned char *out, size_t length, const void *aes, unsigned char *ivec, const int enc);
-using FUNC_AES_SET_ENCRYPT_KEY = int (*)(const unsigned char *userKey, const int bits, void *aes);
-using FUNC_BIO_S_MEM = void *(*)();
-using FUNC_BIO_NEW = void *(*)(void *);
-using FUNC_BIO_PUTS = int (*)(void *, const char *);
-using FUNC_PEM_READ_BIO_RSA_PUBKEY = void *(*)(void *, void *, void *, void *);
-using FUNC_PEM_READ_BIO_RSAPUBLICKEY = void *(*)(void *, void *, void *, void *);
-using FUNC_RSA_PUBLIC_ENCRYPT = void *(*)(int flen, const unsigned char *from, unsigned char *to, void *rsa, int padding);
-using FUNC_RSA_SIZE = int (*)(void *);
-using FUNC_RSA_FREE = void (*)(void *);
-
 class DeepinAuthFramework : public QObject
 {
     Q_OBJECT
@@ -83,10 +74,13 @@ signals:
     void FactorsInfoChanged(const MFAInfoList &);
     void PINLenChanged(const int);
     void AuthStateChanged(const int, const int, const QString &);
+    void AuthControllerReady(const QString &account, const bool valid);
+    /* PAM */
+    void PAMAuthenticationFinished();   // PAM 线程已经结束认证，可以重新开启
 
 public slots:
     /* New authentication framework */
-    void CreateAuthController(const QString &account, const int authType, const int appType);
+    void CreateAuthControllerAsync(const QString &account, const int authType, const int appType);
     void DestroyAuthController(const QString &account);
     void StartAuthentication(const QString &account, const int authType, const int timeout);
     void EndAuthentication(const QString &account, const int authType);
@@ -95,45 +89,64 @@ public slots:
 
 private:
     /* Compatible with old authentication methods */
+    /**
+     * @brief 一次 PAM 认证的共享状态
+     * PAM 线程和界面线程各持有一个引用。结束认证时只设置取消标志并唤醒线程，不等待线程退出，
+     * 线程从 PAM 模块返回后自行退出；取消后 framework 置空，线程不再上报结果。
+     */
+    struct PAMSession {
+        QString account;
+        QString token;
+        QString message;
+        bool cancel = false;
+        bool waitToken = true;
+        bool finished = false;                      // PAM 认证已经结束，线程不再使用 PAM 句柄
+        DeepinAuthFramework *framework = nullptr;
+        QMutex mutex;                               // 保护以上成员
+        QWaitCondition condition;                   // SendToken/DestroyAuthenticate 唤醒等待密码的 PAM 线程
+    };
+
     static void *PAMAuthWorker(void *arg);
-    void PAMAuthentication(const QString &account);
+    static void PAMAuthentication(const std::shared_ptr<PAMSession> &session);
     static int PAMConversation(int num_msg, const struct pam_message **msg, struct pam_response **resp, void *app_data);
+    static void UpdatePAMState(PAMSession *session, const int state, const QString &message);
     void UpdateAuthState(const int state, const QString &message);
 
-    void initEncryptionService();
+    AuthControllerInter *initAuthController(const QString &account, const QString &path);
+    void initEncryption(const QString &account, const int encryptType, const ArrayInt &encryptMethod);
     void encryptSymmtricKey(const QString &account);
 
+    /* Asynchronous creation of the authentication session */
+    void onAuthControllerCreated(const QString &account, const quint64 serial, const QString &path);
+    void onAuthControllerReplyFinished(const QString &account, const quint64 serial);
+
+    struct PendingToken {
+        int authType;
+        QString token;
+    };
+
+    struct PendingAuthController {
+        quint64 serial = 0;
+        int pendingReplies = 0;
+        int startAuthType = 0; // 创建过程中请求开启的认证类型，创建完成后再开启
+        int startTimeout = -1;
+        QList<PendingToken> tokens; // 创建过程中输入的密码，开启认证之后再发送
+        QElapsedTimer timer;
+    };
+
 private:
     AuthInter *m_authenticateInter;
     QDBusServiceWatcher *m_watcher;
-    pthread_t m_PAMAuthThread;
-    QString m_account;
-    QString m_message;
-    QString m_token;
+    std::shared_ptr<PAMSession> m_PAMSession;
     int m_encryptType;
     QString m_publicKey;
     QString m_symmetricKey;
     ArrayInt m_encryptMethod;
     QMap<QString, AuthControllerInter *> *m_authenticateControllers;
-    bool m_cancelAuth;
-    bool m_waitToken;
+    QMap<QString, PendingAuthController> m_pendingAuthControllers;
+    quint64 m_authControllerSerial;
     bool m_retryActivateFramework;
 
-    void *m_encryptionHandle;
-    FUNC_AES_CBC_ENCRYPT m_F_AES_cbc_encrypt;
-    FUNC_AES_SET_ENCRYPT_KEY m_F_AES_set_encrypt_key;
-    FUNC_BIO_NEW m_F_BIO_new;
-    FUNC_BIO_PUTS m_F_BIO_puts;
-    FUNC_BIO_S_MEM m_F_BIO_s_mem;
-    FUNC_PEM_READ_BIO_RSAPUBLICKEY m_F_PEM_read_bio_RSAPublicKey;
-    FUNC_PEM_READ_BIO_RSA_PUBKEY m_F_PEM_read_bio_RSA_PUBKEY;
-    FUNC_RSA_FREE m_F_RSA_free;
-    FUNC_RSA_FREE m_F_BIO_free;
-    FUNC_RSA_PUBLIC_ENCRYPT m_F_RSA_public_encrypt;
-    FUNC_RSA_SIZE m_F_RSA_size;
-    AES_KEY *m_AES;
-    void *m_BIO;
-    void *m_RSA;
 };
 
 #endif // DEEPINAUTHFRAMEWORK_H
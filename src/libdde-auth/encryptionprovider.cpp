@@ -0,0 +1,221 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "encryptionprovider.h"
+
+#include <QCryptographicHash>
+#include <QDebug>
+#include <QRandomGenerator>
+
+#include <dlfcn.h>
+#include <string.h>
+
+#define PKCS1_HEADER "-----BEGIN RSA PUBLIC KEY-----"
+#define PKCS8_HEADER "-----BEGIN PUBLIC KEY-----"
+#define OPENSSLNAME "libssl.so"
+#define RSA_PKCS1_PADDING_TYPE 1
+
+EncryptionProvider::EncryptionProvider()
+    : m_encryptionHandle(nullptr)
+    , m_F_AES_cbc_encrypt(nullptr)
+    , m_F_AES_set_encrypt_key(nullptr)
+    , m_F_BIO_new(nullptr)
+    , m_F_BIO_puts(nullptr)
+    , m_F_BIO_s_mem(nullptr)
+    , m_F_PEM_read_bio_RSAPublicKey(nullptr)
+    , m_F_PEM_read_bio_RSA_PUBKEY(nullptr)
+    , m_F_RSA_free(nullptr)
+    , m_F_BIO_free(nullptr)
+    , m_F_RSA_public_encrypt(nullptr)
+    , m_F_RSA_size(nullptr)
+    , m_RSA(nullptr)
+{
+}
+
+/**
+ * @brief 静态析构时 OpenSSL 已经执行了自身的 atexit 清理，不能再调用 RSA_free，资源由 release 释放
+ */
+EncryptionProvider::~EncryptionProvider()
+{
+}
+
+EncryptionProvider *EncryptionProvider::instance()
+{
+    static EncryptionProvider provider;
+    return &provider;
+}
+
+/**
+ * @brief 加载 libssl 并解析所需的函数，整个进程只需成功加载一次
+ */
+void EncryptionProvider::loadLibrary()
+{
+    if (m_encryptionHandle) {
+        return;
+    }
+    void *handle = dlopen(OPENSSLNAME, RTLD_NOW);
+    if (!handle) {
+        qCritical() << "Failed to load" << OPENSSLNAME;
+        return;
+    }
+    m_F_AES_cbc_encrypt = reinterpret_cast<FUNC_AES_CBC_ENCRYPT>(dlsym(handle, "AES_cbc_encrypt"));
+    m_F_AES_set_encrypt_key = reinterpret_cast<FUNC_AES_SET_ENCRYPT_KEY>(dlsym(handle, "AES_set_encrypt_key"));
+    m_F_BIO_new = reinterpret_cast<FUNC_BIO_NEW>(dlsym(handle, "BIO_new"));
+    m_F_BIO_puts = reinterpret_cast<FUNC_BIO_PUTS>(dlsym(handle, "BIO_puts"));
+    m_F_BIO_s_mem = reinterpret_cast<FUNC_BIO_S_MEM>(dlsym(handle, "BIO_s_mem"));
+    m_F_PEM_read_bio_RSAPublicKey = reinterpret_cast<FUNC_PEM_READ_BIO_RSAPUBLICKEY>(dlsym(handle, "PEM_read_bio_RSAPublicKey"));
+    m_F_PEM_read_bio_RSA_PUBKEY = reinterpret_cast<FUNC_PEM_READ_BIO_RSA_PUBKEY>(dlsym(handle, "PEM_read_bio_RSA_PUBKEY"));
+    m_F_RSA_public_encrypt = reinterpret_cast<FUNC_RSA_PUBLIC_ENCRYPT>(dlsym(handle, "RSA_public_encrypt"));
+    m_F_RSA_size = reinterpret_cast<FUNC_RSA_SIZE>(dlsym(handle, "RSA_size"));
+    m_F_RSA_free = reinterpret_cast<FUNC_RSA_FREE>(dlsym(handle, "RSA_free"));
+    m_F_BIO_free = reinterpret_cast<FUNC_RSA_FREE>(dlsym(handle, "BIO_free"));
+
+    if (!m_F_AES_cbc_encrypt || !m_F_AES_set_encrypt_key || !m_F_BIO_new || !m_F_BIO_puts || !m_F_BIO_s_mem
+        || !m_F_PEM_read_bio_RSAPublicKey || !m_F_PEM_read_bio_RSA_PUBKEY || !m_F_RSA_public_encrypt
+        || !m_F_RSA_size || !m_F_RSA_free || !m_F_BIO_free) {
+        qCritical() << "Failed to resolve symbols from" << OPENSSLNAME;
+        dlclose(handle);
+        return;
+    }
+    m_encryptionHandle = handle;
+}
+
+/**
+ * @brief 释放解析过的 RSA 公钥和对称密钥并卸载 libssl，在进程退出前调用
+ * 释放后再次设置公钥会重新加载
+ */
+void EncryptionProvider::release()
+{
+    if (!m_encryptionHandle) {
+        return;
+    }
+    for (void *rsa : m_RSACache) {
+        m_F_RSA_free(rsa);
+    }
+    m_RSACache.clear();
+    m_RSA = nullptr;
+    m_AESKeyOwner.clear();
+    memset(&m_AES, 0, sizeof(m_AES));
+    dlclose(m_encryptionHandle);
+    m_encryptionHandle = nullptr;
+}
+
+bool EncryptionProvider::isValid() const
+{
+    return m_encryptionHandle && m_RSA;
+}
+
+/**
+ * @brief 解析 PEM 格式的公钥
+ *
+ * @param publicKey 公钥
+ * @return void* RSA 公钥，解析失败返回 nullptr
+ */
+void *EncryptionProvider::parsePublicKey(const QByteArray &publicKey) const
+{
+    void *bio = m_F_BIO_new(m_F_BIO_s_mem());
+    m_F_BIO_puts(bio, publicKey.constData());
+
+    void *rsa = nullptr;
+    if (publicKey.startsWith(PKCS8_HEADER)) {
+        rsa = m_F_PEM_read_bio_RSA_PUBKEY(bio, nullptr, nullptr, nullptr);
+    } else if (publicKey.startsWith(PKCS1_HEADER)) {
+        rsa = m_F_PEM_read_bio_RSAPublicKey(bio, nullptr, nullptr, nullptr);
+    }
+    m_F_BIO_free(bio);
+
+    return rsa;
+}
+
+/**
+ * @brief 设置认证服务提供的公钥，相同的公钥只解析一次
+ *
+ * @param publicKey 公钥
+ * @return 公钥是否可用
+ */
+bool EncryptionProvider::setPublicKey(const QString &publicKey)
+{
+    loadLibrary();
+    if (!m_encryptionHandle) {
+        return false;
+    }
+
+    const QByteArray key = publicKey.toLatin1();
+    const QByteArray hash = QCryptographicHash::hash(key, QCryptographicHash::Sha256);
+    auto it = m_RSACache.constFind(hash);
+    if (it == m_RSACache.constEnd()) {
+        void *rsa = parsePublicKey(key);
+        if (!rsa) {
+            qCritical() << "Failed to parse the public key!";
+            m_RSA = nullptr;
+            return false;
+        }
+        it = m_RSACache.insert(hash, rsa);
+    }
+    m_RSA = it.value();
+
+    return true;
+}
+
+/**
+ * @brief 使用公钥加密对称加密的密钥
+ *
+ * @param symmetricKey 对称加密的密钥
+ * @return QByteArray 密文，失败时为空
+ */
+QByteArray EncryptionProvider::encryptSymmetricKey(const QString &symmetricKey) const
+{
+    if (!isValid()) {
+        return QByteArray();
+    }
+    const QByteArray plaintext = symmetricKey.toLatin1();
+    QByteArray ciphertext(m_F_RSA_size(m_RSA), '\0');
+    m_F_RSA_public_encrypt(plaintext.size(), reinterpret_cast<const unsigned char *>(plaintext.constData()),
+                           reinterpret_cast<unsigned char *>(ciphertext.data()), m_RSA, RSA_PKCS1_PADDING_TYPE);
+    return ciphertext;
+}
+
+/**
+ * @brief 使用对称加密的密钥加密令牌（AES-CBC，PKCS#7 填充），密钥不变时复用密钥扩展结果
+ *
+ * @param symmetricKey 对称加密的密钥
+ * @param token        令牌（密码、PIN 等）
+ * @return QByteArray 密文，失败时为空
+ */
+QByteArray EncryptionProvider::encryptToken(const QString &symmetricKey, const QString &token)
+{
+    if (!m_encryptionHandle) {
+        return QByteArray();
+    }
+    if (m_AESKeyOwner != symmetricKey) {
+        const QByteArray key = symmetricKey.toLatin1();
+        if (m_F_AES_set_encrypt_key(reinterpret_cast<const unsigned char *>(key.constData()), key.length() * 8, &m_AES) < 0) {
+            qCritical() << "Failed to set symmetric key!";
+            m_AESKeyOwner.clear();
+            return QByteArray();
+        }
+        m_AESKeyOwner = symmetricKey;
+    }
+
+    const QByteArray plaintext = token.toLatin1();
+    const int padding = AES_BLOCK_SIZE - plaintext.size() % AES_BLOCK_SIZE;
+    QByteArray tokenBuffer = plaintext;
+    tokenBuffer.append(padding, static_cast<char>(padding));
+    QByteArray ciphertext(tokenBuffer.size(), '\0');
+    unsigned char iv[AES_BLOCK_SIZE] = {0};
+    m_F_AES_cbc_encrypt(reinterpret_cast<const unsigned char *>(tokenBuffer.constData()), reinterpret_cast<unsigned char *>(ciphertext.data()),
+                        static_cast<size_t>(tokenBuffer.size()), &m_AES, iv, AES_ENCRYPT);
+    return ciphertext;
+}
+
+/**
+ * @brief 生成对称加密的密钥
+ *
+ * @return QString 16 位数字组成的密钥
+ */
+QString EncryptionProvider::generateSymmetricKey()
+{
+    const QString randNum = QString::number(QRandomGenerator::system()->bounded(10000000, 20000000));
+    return randNum + randNum;
+}
@@ -0,0 +1,71 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef ENCRYPTIONPROVIDER_H
+#define ENCRYPTIONPROVIDER_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QString>
+
+#include <openssl/aes.h>
+
+using FUNC_AES_CBC_ENCRYPT = void (*)(const unsigned char *in, unsigned char *out, size_t length, const void *aes, unsigned char *ivec, const int enc);
+using FUNC_AES_SET_ENCRYPT_KEY = int (*)(const unsigned char *userKey, const int bits, void *aes);
+using FUNC_BIO_S_MEM = void *(*)();
+using FUNC_BIO_NEW = void *(*)(void *);
+using FUNC_BIO_PUTS = int (*)(void *, const char *);
+using FUNC_PEM_READ_BIO_RSA_PUBKEY = void *(*)(void *, void *, void *, void *);
+using FUNC_PEM_READ_BIO_RSAPUBLICKEY = void *(*)(void *, void *, void *, void *);
+using FUNC_RSA_PUBLIC_ENCRYPT = void *(*)(int flen, const unsigned char *from, unsigned char *to, void *rsa, int padding);
+using FUNC_RSA_SIZE = int (*)(void *);
+using FUNC_RSA_FREE = void (*)(void *);
+
+/**
+ * @brief 进程内共享的加密服务
+ * 只加载一次 libssl 并解析所需的函数，按公钥的哈希缓存解析后的 RSA 公钥，
+ * 对称密钥不变时复用 AES 的密钥扩展结果，避免每次创建认证服务时重复初始化。
+ */
+class EncryptionProvider
+{
+public:
+    static EncryptionProvider *instance();
+
+    void release();
+    bool isValid() const;
+    bool setPublicKey(const QString &publicKey);
+    QByteArray encryptSymmetricKey(const QString &symmetricKey) const;
+    QByteArray encryptToken(const QString &symmetricKey, const QString &token);
+
+    static QString generateSymmetricKey();
+
+private:
+    EncryptionProvider();
+    ~EncryptionProvider();
+    Q_DISABLE_COPY(EncryptionProvider)
+
+    void loadLibrary();
+    void *parsePublicKey(const QByteArray &publicKey) const;
+
+private:
+    void *m_encryptionHandle;
+    FUNC_AES_CBC_ENCRYPT m_F_AES_cbc_encrypt;
+    FUNC_AES_SET_ENCRYPT_KEY m_F_AES_set_encrypt_key;
+    FUNC_BIO_NEW m_F_BIO_new;
+    FUNC_BIO_PUTS m_F_BIO_puts;
+    FUNC_BIO_S_MEM m_F_BIO_s_mem;
+    FUNC_PEM_READ_BIO_RSAPUBLICKEY m_F_PEM_read_bio_RSAPublicKey;
+    FUNC_PEM_READ_BIO_RSA_PUBKEY m_F_PEM_read_bio_RSA_PUBKEY;
+    FUNC_RSA_FREE m_F_RSA_free;
+    FUNC_RSA_FREE m_F_BIO_free;
+    FUNC_RSA_PUBLIC_ENCRYPT m_F_RSA_public_encrypt;
+    FUNC_RSA_SIZE m_F_RSA_size;
+
+    QHash<QByteArray, void *> m_RSACache; // 公钥哈希 -> RSA 公钥
+    void *m_RSA;                          // 当前使用的 RSA 公钥
+    QString m_AESKeyOwner;                // m_AES 对应的对称密钥
+    AES_KEY m_AES;
+};
+
+#endif // ENCRYPTIONPROVIDER_H
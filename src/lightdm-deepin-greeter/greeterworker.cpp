@@ -6,6 +6,7 @@
 
 #include "authcommon.h"
 #include "keyboardmonitor.h"
+#include "tracer.h"
 #include "userinfo.h"
 
 #include "systempower_interface.h"
@@ -34,6 +35,7 @@ GreeterWorker::GreeterWorker(SessionBaseModel *const model, QObject *parent)
     : AuthInterface(model, parent)
     , m_greeter(new QLightDM::Greeter(this))
     , m_authFramework(new DeepinAuthFramework(this))
+    , m_authStateMachine(new AuthStateMachine(this))
     , m_lockInter(new DBusLockService(LOCKSERVICE_NAME, LOCKSERVICE_PATH, QDBusConnection::systemBus(), this))
     , m_soundPlayerInter(new SoundThemePlayerInter("org.deepin.dde.SoundThemePlayer1", "/org/deepin/dde/SoundThemePlayer1", QDBusConnection::systemBus(), this))
     , m_resetSessionTimer(new QTimer(this))
@@ -41,6 +43,7 @@ GreeterWorker::GreeterWorker(SessionBaseModel *const model, QObject *parent)
     , m_retryAuth(false)
 {
 #ifndef QT_DEBUG
+    DSS_TRACE_SCOPE("Greeter.connectSync");
     if (!m_greeter->connectSync()) {
         qCritical() << "greeter connect fail !!!";
         exit(1);
@@ -116,7 +119,19 @@ void GreeterWorker::initConnections()
     connect(m_authFramework, &DeepinAuthFramework::SupportedEncryptsChanged, m_model, &SessionBaseModel::updateSupportedEncryptionType);
     connect(m_authFramework, &DeepinAuthFramework::SupportedMixAuthFlagsChanged, m_model, &SessionBaseModel::updateSupportedMixAuthFlags);
     /* org.deepin.dde.Authenticate1.Session */
-    connect(m_authFramework, &DeepinAuthFramework::AuthStateChanged, this, &GreeterWorker::onAuthStateChanged);
+    connect(m_authFramework, &DeepinAuthFramework::AuthStateChanged, m_authStateMachine, &AuthStateMachine::handleStatus);
+    connect(m_authStateMachine, &AuthStateMachine::statusChanged, this, &GreeterWorker::onAuthStateChanged);
+    connect(m_authStateMachine, &AuthStateMachine::deferredStateChanged, m_model, &SessionBaseModel::updateAuthState);
+    connect(m_authStateMachine, &AuthStateMachine::requestStartAuthentication, this, [this](const int type) {
+        startAuthentication(m_account, type);
+    });
+    connect(m_authStateMachine, &AuthStateMachine::requestEndAuthentication, this, [this](const int type) {
+        endAuthentication(m_account, type);
+        // 不使用认证框架时 PAM 认证由 lightdm 完成，要等 authenticationComplete 之后才能重新开启
+        if (m_model->getAuthProperty().FrameworkState != Available && type != AT_PAM)
+            m_authStateMachine->markEnded(type);
+    });
+    connect(m_authFramework, &DeepinAuthFramework::AuthControllerReady, this, &GreeterWorker::onAuthControllerReady);
     connect(m_authFramework, &DeepinAuthFramework::FactorsInfoChanged, m_model, &SessionBaseModel::updateFactorsInfo);
     connect(m_authFramework, &DeepinAuthFramework::FuzzyMFAChanged, m_model, &SessionBaseModel::updateFuzzyMFA);
     connect(m_authFramework, &DeepinAuthFramework::MFAFlagChanged, m_model, &SessionBaseModel::updateMFAFlag);
@@ -178,7 +193,8 @@ void GreeterWorker::initConnections()
             emit m_model->authTypeChanged(AT_None);
             m_account = account;
         }
-        QTimer::singleShot(100, this, [ = ] {
+        // 等切换用户的其它信号处理完再切换模式
+        QMetaObject::invokeMethod(this, [this] {
             if (m_model->appType() == AppType::Login) {
                 // 管理员账户且密码过期的情况下，设置当前状态为ResetPasswdMode，从而方便直接跳转到重置密码界面
                 bool showReset = m_model->currentUser()->expiredState() == User::ExpiredState::ExpiredAlready
@@ -187,7 +203,7 @@ void GreeterWorker::initConnections()
             } else {
                 m_model->setCurrentModeState(SessionBaseModel::ModeStatus::PasswordMode);
             }
-        });
+        }, Qt::QueuedConnection);
     });
     /* model */
     connect(m_model, &SessionBaseModel::authTypeChanged, this, [ = ](const int type) {
@@ -225,20 +241,31 @@ void GreeterWorker::initConnections()
 
 void GreeterWorker::initData()
 {
+    DSS_TRACE_SCOPE("GreeterWorker::initData");
+
+    TraceSpan securityEnhanceSpan("SecurityEnhance.Status");
     if (isSecurityEnhanceOpen())
         m_model->setSEType(true);
+    securityEnhanceSpan.end();
 
     /* org.deepin.dde.Accounts */
+    TraceSpan accountsSpan("Accounts1.UserList");
     m_model->updateUserList(m_accountsInter->userList());
+    accountsSpan.end();
+    TraceSpan loginedSpan("Logined.UserList");
     m_model->updateLastLogoutUser(m_loginedInter->lastLogoutUser());
     m_model->updateLoginedUserList(m_loginedInter->userList());
+    loginedSpan.end();
 
     /* com.deepin.udcp.iam */
+    TraceSpan iamSpan("udcp.iam.Enable");
     QDBusInterface ifc("com.deepin.udcp.iam", "/com/deepin/udcp/iam", "com.deepin.udcp.iam", QDBusConnection::systemBus(), this);
     const bool allowShowCustomUser = valueByQSettings<bool>("", "loginPromptInput", false) || ifc.property("Enable").toBool();
     m_model->setAllowShowCustomUser(allowShowCustomUser);
+    iamSpan.end();
 
     /* init current user */
+    TraceSpan currentUserSpan("LockService1.CurrentUser");
     if (DSysInfo::deepinType() == DSysInfo::DeepinServer || m_model->allowShowCustomUser()) {
         std::shared_ptr<User> user(new User());
         m_model->setIsServerModel(DSysInfo::deepinType() == DSysInfo::DeepinServer);
@@ -253,9 +280,13 @@ void GreeterWorker::initData()
         /* org.deepin.dde.LockService1 */
         m_model->updateCurrentUser(m_lockInter->CurrentUser());
     }
+    currentUserSpan.end();
+    TraceSpan soundSpan("SoundThemePlayer1.PrepareShutdownSound");
     m_soundPlayerInter->PrepareShutdownSound(static_cast<int>(m_model->currentUser()->uid()));
+    soundSpan.end();
 
     /* org.deepin.dde.Authenticate1 */
+    DSS_TRACE_SCOPE("Authenticate1");
     if (m_authFramework->isDeepinAuthValid()) {
         m_model->updateFrameworkState(m_authFramework->GetFrameworkState());
         m_model->updateSupportedEncryptionType(m_authFramework->GetSupportedEncrypts());
@@ -390,18 +421,15 @@ void GreeterWorker::createAuthentication(const QString &account)
     }
 
     m_retryAuth = false;
+    m_authStateMachine->reset();
     std::shared_ptr<User> user_ptr = m_model->findUserByName(account);
     if (user_ptr) {
         user_ptr->updatePasswordExpiredInfo();
     }
     switch (m_model->getAuthProperty().FrameworkState) {
     case Available:
-        m_authFramework->CreateAuthController(account, m_authFramework->GetSupportedMixAuthFlags(), Login);
-        m_authFramework->SetAuthQuitFlag(account, DeepinAuthFramework::ManualQuit);
-        if (!m_authFramework->SetPrivilegesEnable(account, QString("/usr/sbin/lightdm"))) {
-            qWarning() << "Failed to set privileges!";
-        }
-        startGreeterAuth(account);
+        // 认证服务创建完成后在 onAuthControllerReady 中开启 lightdm 认证
+        m_authFramework->CreateAuthControllerAsync(account, m_authFramework->GetSupportedMixAuthFlags(), Login);
         break;
     default:
         startGreeterAuth(account);
@@ -410,6 +438,26 @@ void GreeterWorker::createAuthentication(const QString &account)
     }
 }
 
+/**
+ * @brief 认证服务创建完成，设置退出方式和权限后开启 lightdm 认证
+ *
+ * @param account 用户名
+ * @param valid   认证服务是否创建成功
+ */
+void GreeterWorker::onAuthControllerReady(const QString &account, const bool valid)
+{
+    if (account != m_account) {
+        return;
+    }
+    if (valid) {
+        m_authFramework->SetAuthQuitFlag(account, DeepinAuthFramework::ManualQuit);
+        if (!m_authFramework->SetPrivilegesEnable(account, QString("/usr/sbin/lightdm"))) {
+            qWarning() << "Failed to set privileges!";
+        }
+    }
+    startGreeterAuth(account);
+}
+
 /**
  * @brief 退出认证服务
  *
@@ -418,6 +466,7 @@ void GreeterWorker::createAuthentication(const QString &account)
 void GreeterWorker::destroyAuthentication(const QString &account)
 {
     qDebug() << "GreeterWorker::destroyAuthentication:" << account;
+    m_authStateMachine->reset();
     switch (m_model->getAuthProperty().FrameworkState) {
     case Available:
         m_authFramework->DestroyAuthController(account);
@@ -623,7 +672,10 @@ void GreeterWorker::authenticationComplete()
         if (m_retryAuth && !m_model->getAuthProperty().MFAFlag) {
             showMessage(tr("Wrong Password"), QLightDM::Greeter::MessageTypeError);
         }
-        if (!m_model->currentUser()->limitsInfo(AT_Password).locked) {
+        if (m_authStateMachine->factorState(AT_PAM) == AuthStateMachine::FS_Ending) {
+            // 状态机在等待 PAM 认证结束，由状态机按需重新开启
+            m_authStateMachine->markEnded(AT_PAM);
+        } else if (!m_model->currentUser()->limitsInfo(AT_Password).locked) {
             m_greeter->authenticate(m_model->currentUser()->name());
         }
         return;
@@ -708,25 +760,15 @@ void GreeterWorker::onAuthStateChanged(const int type, const int state, const QS
                     m_model->setCurrentModeState(SessionBaseModel::ModeStatus::PasswordMode);
                 }
                 m_model->updateLimitedInfo(m_authFramework->GetLimitedInfo(m_model->currentUser()->name()));
-                endAuthentication(m_account, type);
-                // 人脸和虹膜需要手动重启验证
-                if (!m_model->currentUser()->limitsInfo(type).locked && type != AT_Face && type != AT_Iris) {
-                    QTimer::singleShot(50, this, [this, type] {
-                        startAuthentication(m_account, type);
-                    });
-                }
-                QTimer::singleShot(50, this, [ = ] {
-                    m_model->updateAuthState(type, state, message);
-                });
+                // 收到 Ended 之后再更新界面和重新开启认证，人脸和虹膜需要手动重启验证
+                m_authStateMachine->finishFactor(type, state, message,
+                                                 !m_model->currentUser()->limitsInfo(type).locked && type != AT_Face && type != AT_Iris);
                 break;
             case AS_Locked:
                 if (m_model->currentModeState() != SessionBaseModel::ResetPasswdMode)
                     m_model->setCurrentModeState(SessionBaseModel::ModeStatus::PasswordMode);
-                endAuthentication(m_account, type);
-                // TODO: 信号时序问题,考虑优化,Bug 89056
-                QTimer::singleShot(50, this, [ = ] {
-                    m_model->updateAuthState(type, state, message);
-                });
+                // 锁定的界面状态要在 Ended 之后更新，Bug 89056
+                m_authStateMachine->finishFactor(type, state, message, false);
                 break;
             case AS_Timeout:
             case AS_Error:
@@ -757,13 +799,9 @@ void GreeterWorker::onAuthStateChanged(const int type, const int state, const QS
             break;
         case AS_Failure:
             if (AT_All != type) {
-                endAuthentication(m_account, type);
                 // 人脸和虹膜需要手动重新开启验证
-                if (!m_model->currentUser()->limitsInfo(type).locked && type != AT_Face && type != AT_Iris) {
-                    QTimer::singleShot(50, this, [this, type] {
-                        startAuthentication(m_account, type);
-                    });
-                }
+                m_authStateMachine->finishFactor(type, AS_None, QString(),
+                                                 !m_model->currentUser()->limitsInfo(type).locked && type != AT_Face && type != AT_Iris);
             }
             break;
         case AS_Cancel:
@@ -6,6 +6,7 @@
 #define GREETERWORKEK_H
 
 #include "authinterface.h"
+#include "authstatemachine.h"
 #include "dbuslockservice.h"
 #include "dbuslogin1manager.h"
 #include "deepinauthframework.h"
@@ -56,6 +57,7 @@ public slots:
 
 private slots:
     void onAuthStateChanged(const int type, const int state, const QString &message);
+    void onAuthControllerReady(const QString &account, const bool valid);
     void onReceiptChanged(bool state);
     void onCurrentUserChanged(const std::shared_ptr<User> &user);
 
@@ -80,6 +82,7 @@ private:
 private:
     QLightDM::Greeter *m_greeter;
     DeepinAuthFramework *m_authFramework;
+    AuthStateMachine *m_authStateMachine;
     DBusLockService *m_lockInter;
     SoundThemePlayerInter *m_soundPlayerInter;
     QTimer *m_resetSessionTimer;
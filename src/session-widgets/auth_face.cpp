@@ -163,11 +163,7 @@ void AuthFace::setAnimationState(const bool start)
 {
     m_aniIndex = 1;
 
-    if (start) {
-        m_aniTimer->start(20);
-    } else {
-        m_aniTimer->stop();
-    }
+    setAnimationTimerActive(start);
 }
 
 /**
@@ -204,10 +200,10 @@ void AuthFace::doAnimation()
 {
     if (m_state == AuthCommon::AS_Success) {
         if (m_aniIndex > 10) {
-            m_aniTimer->stop();
+            setAnimationTimerActive(false);
             emit authFinished(AuthCommon::AS_Success);
         } else {
-            setAuthStateStyle(QStringLiteral(":/misc/images/unlock/unlock_%1.svg").arg(m_aniIndex++));
+            setAuthStateFrame(m_aniIndex++);
         }
     }
 }
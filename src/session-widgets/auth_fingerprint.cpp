@@ -157,11 +157,7 @@ void AuthFingerprint::setAnimationState(const bool start)
 {
     m_aniIndex = 1;
 
-    if (start) {
-        m_aniTimer->start(20);
-    } else {
-        m_aniTimer->stop();
-    }
+    setAnimationTimerActive(start);
 }
 
 /**
@@ -214,10 +210,10 @@ void AuthFingerprint::doAnimation()
 {
     if (m_state == AuthCommon::AS_Success) {
         if (m_aniIndex > 10) {
-            m_aniTimer->stop();
+            setAnimationTimerActive(false);
             emit authFinished(AuthCommon::AS_Success);
         } else {
-            setAuthStateStyle(QStringLiteral(":/misc/images/unlock/unlock_%1.svg").arg(m_aniIndex++));
+            setAuthStateFrame(m_aniIndex++);
         }
     }
 }
@@ -3,6 +3,8 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "auth_module.h"
+#include "spritecache.h"
+#include "timerscheduler.h"
 
 #include <DHiDPIHelper>
 
@@ -59,7 +61,7 @@ void AuthModule::initConnections()
     connect(m_unlockTimer, &QTimer::timeout, this, [ this ] {
         updateIntegerMinutes();
         if (m_integerMinutes == 0)
-            m_unlockTimer->stop();
+            TimerScheduler::instance()->stop(m_unlockTimer);
         updateUnlockPrompt();
     });
     /* 解锁动画 */
@@ -76,6 +78,27 @@ void AuthModule::setAnimationState(const bool start)
     Q_UNUSED(start)
 }
 
+/**
+ * @brief 启停认证动画定时器
+ * 控件不可见或者待机黑屏时暂停动画。认证成功的动画播放完才发送认证完成信号，不能暂停。
+ *
+ * @param active
+ */
+void AuthModule::setAnimationTimerActive(const bool active)
+{
+    if (active)
+        preloadUnlockFrames();
+
+    if (active && m_state == AuthCommon::AS_Success) {
+        TimerScheduler::instance()->stop(m_aniTimer);
+        m_aniTimer->start(20);
+    } else if (active) {
+        TimerScheduler::instance()->start(m_aniTimer, this, 20);
+    } else {
+        TimerScheduler::instance()->stop(m_aniTimer);
+    }
+}
+
 /**
  * @brief 设置认证的状态，由派生类重载，自定义认证状态显示样式。
  *
@@ -107,6 +130,53 @@ void AuthModule::setAuthStateStyle(const QString &path)
     m_authStateLabel->setPixmap(pixmap);
 }
 
+/**
+ * @brief 显示解锁动画的一帧
+ * 动画帧按缩放比例光栅化一次后缓存，播放时直接取用对应的帧。
+ *
+ * @param frame 帧编号，从 1 开始，和 unlock_%1.svg 的编号一致
+ */
+void AuthModule::setAuthStateFrame(const int frame)
+{
+    if (!m_authStateLabel)
+        return;
+
+    const SpriteCache::Sprite sprite = SpriteCache::instance()->sprite(AUTH_UNLOCK_FRAMES, AUTH_UNLOCK_FRAME_COUNT, devicePixelRatioF());
+    const QPixmap pixmap = sprite.frame(frame - 1);
+    if (pixmap.isNull()) {
+        setAuthStateStyle(AUTH_UNLOCK_FRAMES.arg(frame));
+        return;
+    }
+
+    m_authStateLabel->setPixmap(pixmap);
+}
+
+/**
+ * @brief 在线程池中提前光栅化解锁动画，认证成功时不需要再等待
+ * 缩放比例取决于控件所在的屏幕，在显示、切换屏幕和动画开始时按当前的缩放比例准备。
+ */
+void AuthModule::preloadUnlockFrames()
+{
+    if (!m_authStateLabel)
+        return;
+
+    SpriteCache::instance()->preload(AUTH_UNLOCK_FRAMES, AUTH_UNLOCK_FRAME_COUNT, devicePixelRatioF());
+}
+
+bool AuthModule::event(QEvent *event)
+{
+    if (event->type() == QEvent::ScreenChangeInternal && isVisible())
+        preloadUnlockFrames();
+
+    return QWidget::event(event);
+}
+
+void AuthModule::showEvent(QShowEvent *event)
+{
+    preloadUnlockFrames();
+    QWidget::showEvent(event);
+}
+
 /**
  * @brief 设置认证受限信息
  *
@@ -144,14 +214,14 @@ void AuthModule::updateUnlockTime()
 {
     if (QDateTime::fromString(m_limitsInfo->unlockTime, Qt::ISODateWithMs) <= QDateTime::currentDateTime()) {
         m_integerMinutes = 0;
-        m_unlockTimer->stop();
+        TimerScheduler::instance()->stop(m_unlockTimer);
         if (m_limitsInfo->locked)
             updateUnlockPrompt();
         return;
     }
     updateIntegerMinutes();
     updateUnlockPrompt();
-    m_unlockTimer->start();
+    TimerScheduler::instance()->start(m_unlockTimer, this);
 }
 
 void AuthModule::updateIntegerMinutes()
@@ -178,6 +248,8 @@ void AuthModule::setAuthStateLabel(DLabel *label)
     /* 认证状态 */
     m_authStateLabel = label;
     setAuthStateStyle(AUTH_LOCK);
+    if (isVisible())
+        preloadUnlockFrames();
 }
 
 void AuthModule::setAuthFactorType(AuthFactorType authFactorType)
@@ -22,6 +22,8 @@
 #define LOGIN_SPINNER QStringLiteral(":/misc/images/login_spinner.svg")
 #define PASSWORD_HINT QStringLiteral(":/misc/images/password_hint.svg")
 #define AUTH_LOCK QStringLiteral(":/misc/images/unlock/unlock_1.svg")
+#define AUTH_UNLOCK_FRAMES QStringLiteral(":/misc/images/unlock/unlock_%1.svg")
+#define AUTH_UNLOCK_FRAME_COUNT 11
 #define UnionID_Auth QStringLiteral(":/misc/images/auth/UnionID.svg")
 #define ResetPassword_Exe_Path QStringLiteral("/usr/lib/dde-control-center/reset-password-dialog")
 
@@ -70,6 +72,7 @@ public:
     virtual void setAnimationState(const bool start);
     virtual void setAuthState(const int state, const QString &result);
     void setAuthStateStyle(const QString &path);
+    void setAuthStateFrame(const int frame);
     virtual void setLimitsInfo(const LimitsInfo &info);
     void setShowAuthState(bool showAuthState);
     void setAuthStatueVisible(bool visible);
@@ -85,11 +88,16 @@ signals:
     void unlockTimeChanged();
 
 protected:
+    bool event(QEvent *event) override;
+    void showEvent(QShowEvent *event) override;
+
     void initConnections();
     virtual void doAnimation() { }
+    void setAnimationTimerActive(const bool active);
     virtual void updateUnlockPrompt();
     void updateUnlockTime();
     void updateIntegerMinutes();
+    void preloadUnlockFrames();
 
 protected:
     int m_inputType;          // 认证信息输入设备类型
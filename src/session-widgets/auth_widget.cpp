@@ -52,7 +52,6 @@ AuthWidget::AuthWidget(QWidget *parent)
     setFocusPolicy(Qt::NoFocus);
 
     m_capslockMonitor = KeyboardMonitor::instance();
-    m_capslockMonitor->start(QThread::LowestPriority);
     m_frameDataBind = FrameDataBind::Instance();
 }
 
@@ -156,7 +155,7 @@ void AuthWidget::setUser(std::shared_ptr<User> user)
     }
     m_connectionList.clear();
     m_user = user;
-    m_connectionList << connect(user.get(), &User::avatarChanged, this, &AuthWidget::setAvatar)
+    m_connectionList << connect(user.get(), &User::avatarChanged, this, &AuthWidget::onAvatarChanged)
                      << connect(user.get(), &User::displayNameChanged, this, &AuthWidget::updateUserNameLabel)
                      << connect(user.get(), &User::passwordHintChanged, this, &AuthWidget::setPasswordHint)
                      << connect(user.get(), &User::limitsInfoChanged, this, &AuthWidget::setLimitsInfo)
@@ -197,6 +196,37 @@ void AuthWidget::setAuthType(const int type)
     Q_UNUSED(type)
 }
 
+/**
+ * @brief 回收当前用户没有的认证因子
+ * 认证因子只隐藏并移出布局，不再销毁，信号连接和样式都保留，回收期间屏蔽它发出的信号。
+ *
+ * @param authModule
+ */
+void AuthWidget::recycleAuthModule(AuthModule *authModule)
+{
+    authModule->setAnimationState(false);
+    authModule->blockSignals(true);
+    if (layout())
+        layout()->removeWidget(authModule);
+    authModule->hide();
+    m_recycledAuthModules.insert(authModule->authType(), authModule);
+}
+
+/**
+ * @brief 取回之前回收的认证因子，调用方需要重置状态并更新和用户相关的信息
+ *
+ * @param type 认证类型
+ * @return AuthModule* 没有回收过这个类型时返回空指针
+ */
+AuthModule *AuthWidget::reuseAuthModule(const int type)
+{
+    AuthModule *authModule = m_recycledAuthModules.take(type);
+    if (authModule)
+        authModule->blockSignals(false);
+
+    return authModule;
+}
+
 /**
  * @brief 设置认证状态
  * @param type
@@ -289,6 +319,16 @@ void AuthWidget::setAvatar(const QString &avatar)
     m_userAvatar->setIcon(avatar);
 }
 
+/**
+ * @brief 头像变化，路径不变时文件可能被原地覆盖，需要重新读取
+ * @param avatar
+ */
+void AuthWidget::onAvatarChanged(const QString &avatar)
+{
+    setAvatar(avatar);
+    m_userAvatar->reloadIcon();
+}
+
 /**
  * @brief 设置用户名字体
  * @param font
@@ -507,7 +547,7 @@ void AuthWidget::syncResetPasswordUI()
  */
 void AuthWidget::syncUKey(const QVariant &value)
 {
-    if (m_passwordAuth)
+    if (m_ukeyAuth)
         m_ukeyAuth->setLineEditInfo(value.toString(), AuthUKey::InputText);
 }
 
@@ -15,6 +15,7 @@
 
 #include <QWidget>
 
+class AuthModule;
 class AuthSingle;
 class AuthIris;
 class AuthFace;
@@ -67,10 +68,13 @@ protected:
     void initConnections();
 
     virtual void checkAuthResult(const int type, const int state);
+    virtual void recycleAuthModule(AuthModule *authModule);
+    virtual AuthModule *reuseAuthModule(const int type);
 
     void setUser(std::shared_ptr<User> user);
     void setLimitsInfo(const QMap<int, User::LimitsInfo> *limitsInfo);
     void setAvatar(const QString &avatar);
+    void onAvatarChanged(const QString &avatar);
     void updateUserNameLabel();
     void setPasswordHint(const QString &hint);
     void setLockButtonType(const int type);
@@ -119,6 +123,7 @@ protected:
 
     QList<QMetaObject::Connection> m_connectionList;
     QMap<QString, int> m_registerFunctions;
+    QMap<int, AuthModule *> m_recycledAuthModules;  // 当前用户没有的认证因子，切换用户时复用
 };
 
 #endif // AUTHWIDGET_H
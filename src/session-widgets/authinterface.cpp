@@ -4,6 +4,8 @@
 
 #include "authinterface.h"
 #include "sessionbasemodel.h"
+#include "timerscheduler.h"
+#include "tracer.h"
 #include "userinfo.h"
 
 #include <grp.h>
@@ -34,6 +36,7 @@ AuthInterface::AuthInterface(SessionBaseModel *const model, QObject *parent)
         QString sessionSelf;
         if (m_model->appType() == AppType::Lock) {
             // v23上m_login1Inter->GetSessionByPID(0)接口已不可用，使用org.deepin.Session获取
+            DSS_TRACE_SCOPE("Session1.GetSessionPath");
             QDBusInterface inter("org.deepin.dde.Session1", "/org/deepin/dde/Session1",
                                  "org.deepin.dde.Session1", QDBusConnection::sessionBus());
             QDBusReply<QString> reply = inter.call("GetSessionPath");
@@ -43,16 +46,22 @@ AuthInterface::AuthInterface(SessionBaseModel *const model, QObject *parent)
                 qWarning() << "org.deepin.dde.Session1 get session path has error!";
         } else {
             // AppType::Login
+            DSS_TRACE_SCOPE("login1.GetSessionByPID");
             sessionSelf = m_login1Inter->GetSessionByPID(0).value().path();
         }
 
         if (!sessionSelf.isEmpty()) {
             m_login1SessionSelf = new Login1SessionSelf("org.freedesktop.login1", sessionSelf, QDBusConnection::systemBus(), this);
             m_login1SessionSelf->setSync(false);
+            // 会话切换到后台时暂停界面定时器
+            connect(m_login1SessionSelf, &Login1SessionSelf::ActiveChanged, TimerScheduler::instance(), &TimerScheduler::setSessionActive);
         }
     } else {
         qWarning() << "m_login1Inter:" << m_login1Inter->lastError().type();
     }
+
+    // 待机黑屏时暂停界面定时器
+    connect(m_model, &SessionBaseModel::blackModeChanged, TimerScheduler::instance(), &TimerScheduler::setBlackMode);
 }
 
 void AuthInterface::setKeyboardLayout(std::shared_ptr<User> user, const QString &layout)
@@ -70,12 +79,17 @@ void AuthInterface::onUserListChanged(const QStringList &list)
             tmpList << ACCOUNTS_DBUS_PREFIX + QString::number(u->uid());
     }
 
+    QStringList addedList;
     for (const QString &u : list) {
         if (!tmpList.contains(u)) {
             tmpList << u;
-            onUserAdded(u);
+            addedList << u;
         }
     }
+    // 只创建轻量的用户对象，显示或选中时再获取全部属性
+    for (const std::shared_ptr<NativeUser> &u : NativeUser::createLazy(addedList)) {
+        addUser(u);
+    }
 
     for (const QString &u : tmpList) {
         if (!list.contains(u)) {
@@ -86,9 +100,16 @@ void AuthInterface::onUserListChanged(const QStringList &list)
 
 void AuthInterface::onUserAdded(const QString &user)
 {
-    std::shared_ptr<User> user_ptr(new NativeUser(user));
-    user_ptr->updateLoginState(isLogined(user_ptr->uid()));
-    m_model->addUser(user_ptr);
+    // 不同步获取属性，先显示占位信息，回复到达后再更新
+    const std::shared_ptr<NativeUser> nativeUser = NativeUser::createLazy(user);
+    nativeUser->materializeAsync();
+    addUser(nativeUser);
+}
+
+void AuthInterface::addUser(std::shared_ptr<User> user)
+{
+    user->updateLoginState(isLogined(user->uid()));
+    m_model->addUser(user);
 }
 
 void AuthInterface::onUserRemove(const QString &user)
@@ -105,12 +126,20 @@ void AuthInterface::onUserRemove(const QString &user)
 
 void AuthInterface::initData()
 {
+    DSS_TRACE_SCOPE("AuthInterface::initData");
+
+    TraceSpan accountsSpan("Accounts1.UserList");
     onUserListChanged(m_accountsInter->userList());
+    accountsSpan.end();
+    TraceSpan loginedSpan("Logined.UserList");
     onLastLogoutUserChanged(m_loginedInter->lastLogoutUser());
     onLoginUserListChanged(m_loginedInter->userList());
+    loginedSpan.end();
 
+    TraceSpan configSpan("checkConfig");
     checkConfig();
     checkPowerInfo();
+    configSpan.end();
 }
 
 void AuthInterface::initDBus()
@@ -54,6 +54,7 @@ public:
 protected:
     void initDBus();
     void initData();
+    void addUser(std::shared_ptr<User> user);
     void onLastLogoutUserChanged(uint uid);
     void onLoginUserListChanged(const QString &list);
 
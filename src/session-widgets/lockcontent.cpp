@@ -59,7 +59,7 @@ LockContent::LockContent(SessionBaseModel *const model, QWidget *parent)
 
     QTimer::singleShot(0, this, [ = ] {
         onCurrentUserChanged(model->currentUser());
-        onUserListChanged(model->isServerModel() ? model->loginedUserList() : model->userList());
+        updateUserSwitchEnable(model->isServerModel() ? model->loginedUserCount() : model->userCount());
     });
 
     m_localServer->setMaxPendingConnections(1);
@@ -120,6 +120,13 @@ void LockContent::initConnections()
 
     connect(m_model, &SessionBaseModel::userListChanged, this, &LockContent::onUserListChanged);
     connect(m_model, &SessionBaseModel::userListLoginedChanged, this, &LockContent::onUserListChanged);
+    // 服务器模式下用户登录、注销只需要刷新已登录用户数量
+    auto onLoginedUserCountChanged = [this] {
+        if (m_model->isServerModel())
+            updateUserSwitchEnable(m_model->loginedUserCount());
+    };
+    connect(m_model, &SessionBaseModel::userLoggedIn, this, onLoginedUserCountChanged);
+    connect(m_model, &SessionBaseModel::userLoggedOut, this, onLoginedUserCountChanged);
     connect(m_model, &SessionBaseModel::authFinished, this, &LockContent::restoreMode);
     connect(m_model, &SessionBaseModel::MFAFlagChanged, this, [this](const bool isMFA) {
         isMFA ? initMFAWidget() : initSFAWidget();
@@ -349,7 +356,7 @@ void LockContent::pushShutdownFrame()
     m_shutdownFrame->setModel(m_model);
     m_shutdownFrame->move(0, 0);
     m_shutdownFrame->onStatusChanged(m_model->currentModeState());
-    onUserListChanged(m_model->isServerModel() ? m_model->loginedUserList() : m_model->userList());
+    updateUserSwitchEnable(m_model->isServerModel() ? m_model->loginedUserCount() : m_model->userCount());
     setCenterContent(m_shutdownFrame.get());
 }
 
@@ -531,18 +538,23 @@ void LockContent::toggleModule(const QString &name)
 }
 
 void LockContent::onUserListChanged(QList<std::shared_ptr<User> > list)
+{
+    updateUserSwitchEnable(list.size());
+}
+
+void LockContent::updateUserSwitchEnable(const int userCount)
 {
     const bool allowShowUserSwitchButton = m_model->allowShowUserSwitchButton();
     const bool alwaysShowUserSwitchButton = m_model->alwaysShowUserSwitchButton();
     bool haveLogindUser = true;
 
     if (m_model->isServerModel() && m_model->appType() == Login) {
-        haveLogindUser = !m_model->loginedUserList().isEmpty();
+        haveLogindUser = m_model->loginedUserCount() > 0;
     }
 
     bool enable = (alwaysShowUserSwitchButton ||
                    (allowShowUserSwitchButton &&
-                    (list.size() > (m_model->isServerModel() ? 0 : 1)))) &&
+                    (userCount > (m_model->isServerModel() ? 0 : 1)))) &&
             haveLogindUser;
 
     m_controlWidget->setUserSwitchEnable(enable);
@@ -75,6 +75,7 @@ protected:
     void updateTimeFormat(bool use24);
     void toggleModule(const QString &name);
     void onUserListChanged(QList<std::shared_ptr<User>> list);
+    void updateUserSwitchEnable(const int userCount);
     void tryGrabKeyboard();
     void hideToplevelWindow();
     void currentWorkspaceChanged();
@@ -77,7 +77,7 @@ void MFAWidget::setAuthType(const int type)
         initFaceAuth();
         m_index++;
     } else if (m_faceAuth) {
-        m_faceAuth->deleteLater();
+        recycleAuthModule(m_faceAuth);
         m_faceAuth = nullptr;
     }
     /* 虹膜 */
@@ -85,7 +85,7 @@ void MFAWidget::setAuthType(const int type)
         initIrisAuth();
         m_index++;
     } else if (m_irisAuth) {
-        m_irisAuth->deleteLater();
+        recycleAuthModule(m_irisAuth);
         m_irisAuth = nullptr;
     }
     /* 指纹 */
@@ -93,7 +93,7 @@ void MFAWidget::setAuthType(const int type)
         initFingerprintAuth();
         m_index++;
     } else if (m_fingerprintAuth) {
-        m_fingerprintAuth->deleteLater();
+        recycleAuthModule(m_fingerprintAuth);
         m_fingerprintAuth = nullptr;
     }
     /* Ukey */
@@ -101,7 +101,7 @@ void MFAWidget::setAuthType(const int type)
         initUKeyAuth();
         m_index++;
     } else if (m_ukeyAuth) {
-        m_ukeyAuth->deleteLater();
+        recycleAuthModule(m_ukeyAuth);
         m_ukeyAuth = nullptr;
     }
     /* 密码 */
@@ -109,7 +109,7 @@ void MFAWidget::setAuthType(const int type)
         initPasswdAuth();
         m_index++;
     } else if (m_passwordAuth) {
-        m_passwordAuth->deleteLater();
+        recycleAuthModule(m_passwordAuth);
         m_passwordAuth = nullptr;
     }
     /* 账户 */
@@ -227,9 +227,15 @@ void MFAWidget::autoUnlock()
  */
 void MFAWidget::initPasswdAuth()
 {
+    if (!m_passwordAuth)
+        m_passwordAuth = static_cast<AuthPassword *>(reuseAuthModule(AT_Password));
     if (m_passwordAuth) {
         m_passwordAuth->reset();
+        m_passwordAuth->setCurrentUid(m_model->currentUser()->uid());
+        m_passwordAuth->setCapsLockVisible(m_capslockMonitor->isCapslockOn());
+        m_passwordAuth->setPasswordHint(m_model->currentUser()->passwordHint());
         m_mainLayout->insertWidget(m_index, m_passwordAuth);
+        m_passwordAuth->show();
         return;
     }
     m_passwordAuth = new AuthPassword(this);
@@ -280,9 +286,12 @@ void MFAWidget::initPasswdAuth()
  */
 void MFAWidget::initFingerprintAuth()
 {
+    if (!m_fingerprintAuth)
+        m_fingerprintAuth = static_cast<AuthFingerprint *>(reuseAuthModule(AT_Fingerprint));
     if (m_fingerprintAuth) {
         m_fingerprintAuth->reset();
         m_mainLayout->insertWidget(m_index, m_fingerprintAuth);
+        m_fingerprintAuth->show();
         return;
     }
     m_fingerprintAuth = new AuthFingerprint(this);
@@ -302,9 +311,13 @@ void MFAWidget::initFingerprintAuth()
  */
 void MFAWidget::initUKeyAuth()
 {
+    if (!m_ukeyAuth)
+        m_ukeyAuth = static_cast<AuthUKey *>(reuseAuthModule(AT_Ukey));
     if (m_ukeyAuth) {
         m_ukeyAuth->reset();
+        m_ukeyAuth->setCapsLockVisible(m_capslockMonitor->isCapslockOn());
         m_mainLayout->insertWidget(m_index, m_ukeyAuth);
+        m_ukeyAuth->show();
         return;
     }
     m_ukeyAuth = new AuthUKey(this);
@@ -349,9 +362,12 @@ void MFAWidget::initUKeyAuth()
  */
 void MFAWidget::initFaceAuth()
 {
+    if (!m_faceAuth)
+        m_faceAuth = static_cast<AuthFace *>(reuseAuthModule(AT_Face));
     if (m_faceAuth) {
         m_faceAuth->reset();
         m_mainLayout->insertWidget(m_index, m_faceAuth);
+        m_faceAuth->show();
         return;
     }
     m_faceAuth = new AuthFace(this);
@@ -371,9 +387,12 @@ void MFAWidget::initFaceAuth()
  */
 void MFAWidget::initIrisAuth()
 {
+    if (!m_irisAuth)
+        m_irisAuth = static_cast<AuthIris *>(reuseAuthModule(AT_Iris));
     if (m_irisAuth) {
         m_irisAuth->reset();
         m_mainLayout->insertWidget(m_index, m_irisAuth);
+        m_irisAuth->show();
         return;
     }
     m_irisAuth = new AuthIris(this);
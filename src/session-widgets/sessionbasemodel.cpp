@@ -51,7 +51,13 @@ SessionBaseModel::~SessionBaseModel()
 
 std::shared_ptr<User> SessionBaseModel::findUserByUid(const uint uid) const
 {
-    for (auto user : qAsConst(*m_users)) {
+    const int count = m_usersByUid.count(uid);
+    if (count <= 1) {
+        return m_usersByUid.value(uid);
+    }
+
+    // 同一个 uid 有多个用户时（如本地用户和域账户），和原来一样返回 m_users 中排在最前的
+    for (const std::shared_ptr<User> &user : qAsConst(*m_users)) {
         if (user->uid() == uid) {
             return user;
         }
@@ -65,12 +71,66 @@ std::shared_ptr<User> SessionBaseModel::findUserByName(const QString &name) cons
         return std::shared_ptr<User>(nullptr);
     }
 
-    for (auto user : qAsConst(*m_users)) {
-        if (user->name() == name) {
-            return user;
+    return m_usersByName.value(name);
+}
+
+/**
+ * @brief 添加用户并更新 uid 和用户名索引
+ *
+ * @param path 用户路径或 Uid
+ * @param user
+ */
+void SessionBaseModel::insertUser(const QString &path, const std::shared_ptr<User> &user)
+{
+    takeUser(path);
+    m_users->insert(path, user);
+    m_usersByUid.insert(user->uid(), user);
+    if (!user->name().isEmpty()) {
+        m_usersByName.insert(user->name(), user);
+    }
+
+    // 只记录弱引用，避免用户对象和连接互相持有
+    const std::weak_ptr<User> weakUser = user;
+    connect(user.get(), &User::nameChanged, this, [this, weakUser](const QString &name, const QString &oldName) {
+        const std::shared_ptr<User> user = weakUser.lock();
+        if (!user) {
+            return;
+        }
+        m_usersByName.remove(oldName, user);
+        if (!name.isEmpty()) {
+            m_usersByName.insert(name, user);
         }
+    });
+    connect(user.get(), &User::uidChanged, this, [this, weakUser](const uid_t uid, const uid_t oldUid) {
+        const std::shared_ptr<User> user = weakUser.lock();
+        if (!user) {
+            return;
+        }
+        m_usersByUid.remove(oldUid, user);
+        m_usersByUid.insert(uid, user);
+    });
+}
+
+/**
+ * @brief 删除用户并更新 uid 和用户名索引
+ *
+ * @param path 用户路径或 Uid
+ */
+void SessionBaseModel::takeUser(const QString &path)
+{
+    const std::shared_ptr<User> user = m_users->take(path);
+    if (!user) {
+        return;
     }
-    return std::shared_ptr<User>(nullptr);
+    disconnect(user.get(), &User::nameChanged, this, nullptr);
+    disconnect(user.get(), &User::uidChanged, this, nullptr);
+    m_usersByUid.remove(user->uid(), user);
+    m_usersByName.remove(user->name(), user);
+}
+
+bool SessionBaseModel::containsUser(const std::shared_ptr<User> &user) const
+{
+    return m_usersByUid.contains(user->uid(), user);
 }
 
 void SessionBaseModel::setAppType(const AppType type)
@@ -273,8 +333,10 @@ void SessionBaseModel::addUser(const QString &path)
     if (m_users->contains(path)) {
         return;
     }
-    std::shared_ptr<NativeUser> user(new NativeUser(path));
-    m_users->insert(path, user);
+    // 不同步获取属性，先显示占位信息，回复到达后再更新
+    const std::shared_ptr<NativeUser> user = NativeUser::createLazy(path);
+    user->materializeAsync();
+    insertUser(path, user);
     emit userAdded(user);
     emit userListChanged(m_users->values());
 }
@@ -288,12 +350,11 @@ void SessionBaseModel::addUser(const std::shared_ptr<User> user)
 {
     qDebug("add user, path: %s, name: %s", qPrintable(user->path()), qPrintable(user->name()));
 
-    const QList<std::shared_ptr<User>> userList = m_users->values();
-    if (userList.contains(user)) {
+    if (containsUser(user)) {
         return;
     }
     const QString path = user->path().isEmpty() ? QString::number(user->uid()) : user->path();
-    m_users->insert(path, user);
+    insertUser(path, user);
     emit userAdded(user);
 }
 
@@ -308,7 +369,7 @@ void SessionBaseModel::removeUser(const QString &path)
         return;
     }
     const std::shared_ptr<User> user = m_users->value(path);
-    m_users->remove(path);
+    takeUser(path);
     emit userRemoved(user);
     emit userListChanged(m_users->values());
 }
@@ -322,13 +383,12 @@ void SessionBaseModel::removeUser(const std::shared_ptr<User> user)
 {
     qDebug("remove user, name: %s, id: %d", qPrintable(user->name()), user->uid());
 
-    const QList<std::shared_ptr<User>> userList = m_users->values();
-    if (!userList.contains(user)) {
+    if (!containsUser(user)) {
         return;
     }
 
     const QString path = user->path().isEmpty() ? QString::number(user->uid()) : user->path();
-    m_users->remove(path);
+    takeUser(path);
     emit userRemoved(user);
 }
 
@@ -393,6 +453,7 @@ bool SessionBaseModel::updateCurrentUser(const std::shared_ptr<User> user)
     }
 
     qDebug() << "SessionBaseModel::updateCurrentUser:" << user->name();
+    user->materialize();
 
     if (m_currentUser && *m_currentUser == *user) {
         return false;
@@ -413,17 +474,23 @@ void SessionBaseModel::updateUserList(const QStringList &list)
 {
     qDebug() << "update user list: " << list;
 
-    QStringList listTmp = m_users->keys();
+    const QSet<QString> pathSet(list.begin(), list.end());
+    const QStringList oldPaths = m_users->keys();
+    for (const QString &path : oldPaths) {
+        if (!pathSet.contains(path)) {
+            takeUser(path);
+        }
+    }
+    QStringList addedPaths;
     for (const QString &path : list) {
-        if (m_users->contains(path)) {
-            listTmp.removeAll(path);
-        } else {
-            std::shared_ptr<NativeUser> user(new NativeUser(path));
-            m_users->insert(path, user);
+        if (!m_users->contains(path)) {
+            addedPaths << path;
         }
     }
-    for (const QString &path : qAsConst(listTmp)) {
-        m_users->remove(path);
+    // 只创建轻量的用户对象，显示或选中时再获取全部属性
+    const QList<std::shared_ptr<NativeUser>> addedUsers = NativeUser::createLazy(addedPaths);
+    for (int i = 0; i < addedPaths.size(); ++i) {
+        insertUser(addedPaths.at(i), addedUsers.at(i));
     }
     emit userListChanged(m_users->values());
 }
@@ -436,13 +503,7 @@ void SessionBaseModel::updateUserList(const QStringList &list)
 void SessionBaseModel::updateLastLogoutUser(const uid_t uid)
 {
     qDebug() << "SessionBaseModel::updateLastLogoutUser:" << uid;
-    QList<std::shared_ptr<User>> userList = m_users->values();
-    auto it = std::find_if(userList.begin(), userList.end(), [uid](std::shared_ptr<User> &user) {
-        return user->uid() == uid;
-    });
-    if (it != userList.end()) {
-        updateLastLogoutUser(it.i->t());
-    }
+    updateLastLogoutUser(findUserByUid(uid));
 }
 
 /**
@@ -456,6 +517,7 @@ void SessionBaseModel::updateLastLogoutUser(const std::shared_ptr<User> lastLogo
         return;
     }
     qInfo() << "last logout user:" << lastLogoutUser->name() << lastLogoutUser->uid();
+    lastLogoutUser->materialize();
 
     m_lastLogoutUser = lastLogoutUser;
 }
@@ -467,42 +529,62 @@ void SessionBaseModel::updateLastLogoutUser(const std::shared_ptr<User> lastLogo
  */
 void SessionBaseModel::updateLoginedUserList(const QString &list)
 {
+    // 终端服务器上这个信号很频繁，内容没变时直接跳过
+    if (list == m_loginedUserListData) {
+        return;
+    }
+    m_loginedUserListData = list;
     qDebug() << "update logined user list: " << list;
 
-    QList<QString> loginedUsersTmp = m_loginedUsers->keys();
     QJsonParseError jsonParseError;
     const QJsonDocument loginedUserListDoc = QJsonDocument::fromJson(list.toUtf8(), &jsonParseError);
     if (jsonParseError.error != QJsonParseError::NoError) {
         qWarning("The logined user list is wrong!");
         return;
     }
+    QSet<uid_t> loginedUids;
     const QJsonObject loginedUserListDocObj = loginedUserListDoc.object();
-    for (const QString &loginedUserListDocKey : loginedUserListDocObj.keys()) {
-        const QJsonArray loginedUserListArr = loginedUserListDocObj.value(loginedUserListDocKey).toArray();
+    for (auto it = loginedUserListDocObj.constBegin(); it != loginedUserListDocObj.constEnd(); ++it) {
+        const QJsonArray loginedUserListArr = it.value().toArray();
         for (const QJsonValue &loginedUserStr : loginedUserListArr) {
             const QJsonObject loginedUserListObj = loginedUserStr.toObject();
             const int uid = loginedUserListObj["Uid"].toInt();
-            const QString &desktop = loginedUserListObj["Desktop"].toString();
-            if ((uid != 0 && uid < 1000) || desktop.isEmpty()) {
+            if ((uid != 0 && uid < 1000) || loginedUserListObj["Desktop"].toString().isEmpty()) {
                 // 排除非正常登录用户
                 continue;
             }
-            const QString path = QString("/org/deepin/dde/Accounts1/User") + QString::number(uid);
-            if (!m_loginedUsers->contains(path)) {
-                // 对于通过自定义窗口输入的账户(域账户), 此时账户还没添加进来，导致下面m_users->value(path)为空指针，调用会导致程序奔溃
-                // 因此在登录时，对于新增的账户，调用addUser先将账户添加进来，然后再去更新对应账户的登录状态
-                addUser(path);
-                m_loginedUsers->insert(path, m_users->value(path));
-                m_users->value(path)->updateLoginState(true);
-            } else {
-                loginedUsersTmp.removeAll(path);
-            }
+            loginedUids.insert(static_cast<uid_t>(uid));
         }
     }
-    for (const QString &path : qAsConst(loginedUsersTmp)) {
-        m_loginedUsers->remove(path);
-        m_users->value(path)->updateLoginState(false);
+    if (loginedUids == m_loginedUids) {
+        return;
+    }
+
+    for (const uid_t uid : qAsConst(m_loginedUids)) {
+        if (loginedUids.contains(uid)) {
+            continue;
+        }
+        const QString path = QString(ACCOUNTS_DBUS_PREFIX) + QString::number(uid);
+        const std::shared_ptr<User> user = m_loginedUsers->take(path);
+        if (user) {
+            user->updateLoginState(false);
+        }
+        emit userLoggedOut(uid);
+    }
+    for (const uid_t uid : qAsConst(loginedUids)) {
+        if (m_loginedUids.contains(uid)) {
+            continue;
+        }
+        // 对于通过自定义窗口输入的账户(域账户), 此时账户还没添加进来，导致下面m_users->value(path)为空指针，调用会导致程序奔溃
+        // 因此在登录时，对于新增的账户，调用addUser先将账户添加进来，然后再去更新对应账户的登录状态
+        const QString path = QString(ACCOUNTS_DBUS_PREFIX) + QString::number(uid);
+        addUser(path);
+        const std::shared_ptr<User> user = m_users->value(path);
+        m_loginedUsers->insert(path, user);
+        user->updateLoginState(true);
+        emit userLoggedIn(uid);
     }
+    m_loginedUids = loginedUids;
 
     qInfo() << "Logined users: " << m_loginedUsers->keys();
     emit loginedUserListChanged(m_loginedUsers->values());
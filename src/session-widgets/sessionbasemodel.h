@@ -11,7 +11,9 @@
 
 #include <DSysInfo>
 
+#include <QMultiHash>
 #include <QObject>
+#include <QSet>
 
 #include <memory>
 
@@ -73,6 +75,8 @@ public:
 
     inline QList<std::shared_ptr<User>> loginedUserList() const { return m_loginedUsers->values(); }
     inline QList<std::shared_ptr<User>> userList() const { return m_users->values(); }
+    inline int loginedUserCount() const { return m_loginedUsers->size(); }
+    inline int userCount() const { return m_users->size(); }
 
     std::shared_ptr<User> findUserByUid(const uint uid) const;
     std::shared_ptr<User> findUserByName(const QString &name) const;
@@ -146,6 +150,8 @@ signals:
     void userRemoved(const std::shared_ptr<User>);
     void userListChanged(const QList<std::shared_ptr<User>>);
     void loginedUserListChanged(const QList<std::shared_ptr<User>>);
+    void userLoggedIn(const uid_t uid);
+    void userLoggedOut(const uid_t uid);
     /* org.deepin.dde.Authenticate1 */
     void MFAFlagChanged(const bool);
     /* others */
@@ -208,6 +214,11 @@ signals:
     void authStateChanged(const int, const int, const QString &);
     void authTypeChanged(const int type);
 
+private:
+    void insertUser(const QString &path, const std::shared_ptr<User> &user);
+    void takeUser(const QString &path);
+    bool containsUser(const std::shared_ptr<User> &user) const;
+
 private:
     bool m_hasSwap;
     bool m_visible;
@@ -235,6 +246,10 @@ private:
     AuthProperty m_authProperty;                    // 认证相关属性的值，初始时通过dbus获取，暂存在model中，供widget初始化界面使用
     QMap<QString, std::shared_ptr<User>> *m_users;
     QMap<QString, std::shared_ptr<User>> *m_loginedUsers;
+    QString m_loginedUserListData;                             // 上一次收到的已登录用户列表原始数据
+    QSet<uid_t> m_loginedUids;                                 // 上一次解析出的已登录用户 uid
+    QMultiHash<uid_t, std::shared_ptr<User>> m_usersByUid;     // m_users 按 uid 的索引
+    QMultiHash<QString, std::shared_ptr<User>> m_usersByName;  // m_users 按用户名的索引
 };
 
 #endif // SESSIONBASEMODEL_H
@@ -21,6 +21,7 @@
 #include <DFontSizeManager>
 #include <DHiDPIHelper>
 
+#include <QButtonGroup>
 #include <QSpacerItem>
 
 using namespace dss::module;
@@ -118,70 +119,56 @@ void SFAWidget::setAuthType(const int type)
     if (type & AT_Password) {
         initPasswdAuth();
     } else if (m_passwordAuth) {
-        delete m_passwordAuth;
+        recycleAuthModule(m_passwordAuth);
         m_passwordAuth = nullptr;
-        m_authButtons.value(AT_Password)->deleteLater();
-        m_authButtons.remove(AT_Password);
         m_frameDataBind->clearValue("SFPasswordAuthState");
         m_frameDataBind->clearValue("SFPasswordAuthMsg");
     }
     if (type & AT_Face) {
         initFaceAuth();
     } else if (m_faceAuth) {
-        delete m_faceAuth;
+        recycleAuthModule(m_faceAuth);
         m_faceAuth = nullptr;
-        m_authButtons.value(AT_Face)->deleteLater();
-        m_authButtons.remove(AT_Face);
         m_frameDataBind->clearValue("SFFaceAuthState");
         m_frameDataBind->clearValue("SFFaceAuthMsg");
     }
     if (type & AT_Iris) {
         initIrisAuth();
     } else if (m_irisAuth) {
-        delete m_irisAuth;
+        recycleAuthModule(m_irisAuth);
         m_irisAuth = nullptr;
-        m_authButtons.value(AT_Iris)->deleteLater();
-        m_authButtons.remove(AT_Iris);
         m_frameDataBind->clearValue("SFIrisAuthState");
         m_frameDataBind->clearValue("SFIrisAuthMsg");
     }
     if (type & AT_Fingerprint) {
         initFingerprintAuth();
     } else if (m_fingerprintAuth) {
-        delete m_fingerprintAuth;
+        recycleAuthModule(m_fingerprintAuth);
         m_fingerprintAuth = nullptr;
-        m_authButtons.value(AT_Fingerprint)->deleteLater();
-        m_authButtons.remove(AT_Fingerprint);
         m_frameDataBind->clearValue("SFFingerprintAuthState");
         m_frameDataBind->clearValue("SFFingerprintAuthMsg");
     }
     if (type & AT_Ukey) {
         initUKeyAuth();
     } else if (m_ukeyAuth) {
-        delete m_ukeyAuth;
+        recycleAuthModule(m_ukeyAuth);
         m_ukeyAuth = nullptr;
-        m_authButtons.value(AT_Ukey)->deleteLater();
-        m_authButtons.remove(AT_Ukey);
         m_frameDataBind->clearValue("SFUKeyAuthState");
         m_frameDataBind->clearValue("SFUKeyAuthMsg");
     }
     if (type & AT_PAM) {
         initSingleAuth();
     } else if (m_singleAuth) {
-        delete m_singleAuth;
+        recycleAuthModule(m_singleAuth);
         m_singleAuth = nullptr;
-        m_authButtons.value(AT_PAM)->deleteLater();
-        m_authButtons.remove(AT_PAM);
         m_frameDataBind->clearValue("SFSingleAuthState");
         m_frameDataBind->clearValue("SFSingleAuthMsg");
     }
     if (ModulesLoader::instance().findModulesByType(BaseModuleInterface::LoginType).size() > 0) {
         initCustomAuth();
     } else if (m_customAuth) {
-        delete m_customAuth;
+        recycleAuthModule(m_customAuth);
         m_customAuth = nullptr;
-        m_authButtons.value(AT_Custom)->deleteLater();
-        m_authButtons.remove(AT_Custom);
         m_frameDataBind->clearValue("SFCustomAuthStatus");
         m_frameDataBind->clearValue("SFCustomAuthMsg");
     }
@@ -303,8 +290,15 @@ void SFAWidget::setAuthState(const int type, const int state, const QString &mes
  */
 void SFAWidget::initSingleAuth()
 {
+    if (!m_singleAuth)
+        m_singleAuth = static_cast<AuthSingle *>(reuseAuthModule(AT_PAM));
     if (m_singleAuth) {
         m_singleAuth->reset();
+        m_singleAuth->setCurrentUid(m_model->currentUser()->uid());
+        m_singleAuth->setKeyboardButtonVisible(m_keyboardList.size() > 1);
+        m_singleAuth->setKeyboardButtonInfo(m_keyboardType);
+        m_singleAuth->setCapsLockVisible(m_capslockMonitor->isCapslockOn());
+        m_singleAuth->setPasswordHint(m_model->currentUser()->passwordHint());
         return;
     }
     m_singleAuth = new AuthSingle(this);
@@ -378,8 +372,13 @@ void SFAWidget::initSingleAuth()
  */
 void SFAWidget::initPasswdAuth()
 {
+    if (!m_passwordAuth)
+        m_passwordAuth = static_cast<AuthPassword *>(reuseAuthModule(AT_Password));
     if (m_passwordAuth) {
         m_passwordAuth->reset();
+        m_passwordAuth->setCurrentUid(m_model->currentUser()->uid());
+        m_passwordAuth->setCapsLockVisible(m_capslockMonitor->isCapslockOn());
+        m_passwordAuth->setPasswordHint(m_model->currentUser()->passwordHint());
         return;
     }
     m_passwordAuth = new AuthPassword(this);
@@ -453,6 +452,8 @@ void SFAWidget::initPasswdAuth()
  */
 void SFAWidget::initFingerprintAuth()
 {
+    if (!m_fingerprintAuth)
+        m_fingerprintAuth = static_cast<AuthFingerprint *>(reuseAuthModule(AT_Fingerprint));
     if (m_fingerprintAuth) {
         m_fingerprintAuth->reset();
         return;
@@ -497,8 +498,11 @@ void SFAWidget::initFingerprintAuth()
  */
 void SFAWidget::initUKeyAuth()
 {
+    if (!m_ukeyAuth)
+        m_ukeyAuth = static_cast<AuthUKey *>(reuseAuthModule(AT_Ukey));
     if (m_ukeyAuth) {
         m_ukeyAuth->reset();
+        m_ukeyAuth->setCapsLockVisible(m_capslockMonitor->isCapslockOn());
         return;
     }
     m_ukeyAuth = new AuthUKey(this);
@@ -561,6 +565,8 @@ void SFAWidget::initUKeyAuth()
  */
 void SFAWidget::initFaceAuth()
 {
+    if (!m_faceAuth)
+        m_faceAuth = static_cast<AuthFace *>(reuseAuthModule(AT_Face));
     if (m_faceAuth) {
         m_chooseAuthButtonBox->setEnabled(true);
         m_faceAuth->reset();
@@ -624,6 +630,8 @@ void SFAWidget::initFaceAuth()
  */
 void SFAWidget::initIrisAuth()
 {
+    if (!m_irisAuth)
+        m_irisAuth = static_cast<AuthIris *>(reuseAuthModule(AT_Iris));
     if (m_irisAuth) {
         m_irisAuth->reset();
         return;
@@ -683,6 +691,8 @@ void SFAWidget::initIrisAuth()
  */
 void SFAWidget::initCustomAuth()
 {
+    if (!m_customAuth)
+        m_customAuth = static_cast<AuthCustom *>(reuseAuthModule(AT_Custom));
     if (m_customAuth) {
         return;
     }
@@ -765,6 +775,43 @@ void SFAWidget::checkAuthResult(const int type, const int state)
     }
 }
 
+/**
+ * @brief 回收认证因子时一并回收它的认证选择按钮
+ * 按钮移出按钮组后才能取消选中，取消选中时不触发结束认证。
+ *
+ * @param authModule
+ */
+void SFAWidget::recycleAuthModule(AuthModule *authModule)
+{
+    AuthWidget::recycleAuthModule(authModule);
+
+    DButtonBoxButton *btn = m_authButtons.take(authModule->authType());
+    if (!btn)
+        return;
+
+    if (btn->group())
+        btn->group()->removeButton(btn);
+    m_chooseAuthButtonBox->layout()->removeWidget(btn);
+    {
+        QSignalBlocker blocker(btn);
+        btn->setChecked(false);
+    }
+    btn->hide();
+    m_recycledAuthButtons.insert(authModule->authType(), btn);
+}
+
+AuthModule *SFAWidget::reuseAuthModule(const int type)
+{
+    AuthModule *authModule = AuthWidget::reuseAuthModule(type);
+    if (authModule && m_recycledAuthButtons.contains(type)) {
+        DButtonBoxButton *btn = m_recycledAuthButtons.take(type);
+        btn->show();
+        m_authButtons.insert(type, btn);
+    }
+
+    return authModule;
+}
+
 /**
  * @brief 多屏同步认证类型
  * @param value
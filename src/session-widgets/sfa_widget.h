@@ -58,6 +58,8 @@ private:
     void initCustomAuth();
 
     void checkAuthResult(const int type, const int state) override;
+    void recycleAuthModule(AuthModule *authModule) override;
+    AuthModule *reuseAuthModule(const int type) override;
 
     void syncAuthType(const QVariant &value);
     void replaceWidget(AuthModule *authModule);
@@ -72,6 +74,7 @@ private:
     DLabel *m_biometricAuthState;      // 生物认证状态
 
     QMap<int, DButtonBoxButton *> m_authButtons;
+    QMap<int, DButtonBoxButton *> m_recycledAuthButtons;   // 回收的认证因子对应的按钮
     DFloatingButton *m_retryButton;
     QSpacerItem *m_bioAuthStatePlaceHolder;
     QSpacerItem *m_bioBottomSpacingHolder;
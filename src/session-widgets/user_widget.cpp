@@ -76,7 +76,7 @@ void UserWidget::initUI()
 
 void UserWidget::initConnections()
 {
-    connect(m_user.get(), &User::avatarChanged, this, &UserWidget::setAvatar);
+    connect(m_user.get(), &User::avatarChanged, this, &UserWidget::onAvatarChanged);
     connect(m_user.get(), &User::displayNameChanged, this, &UserWidget::updateUserNameLabel);
     connect(m_user.get(), &User::loginStateChanged, this, &UserWidget::setLoginState);
     connect(qGuiApp, &QGuiApplication::fontChanged, this, &UserWidget::updateUserNameLabel);
@@ -136,6 +136,16 @@ void UserWidget::setAvatar(const QString &avatar)
     m_avatar->setIcon(avatar);
 }
 
+/**
+ * @brief 头像变化，路径不变时文件可能被原地覆盖，需要重新读取
+ * @param avatar
+ */
+void UserWidget::onAvatarChanged(const QString &avatar)
+{
+    setAvatar(avatar);
+    m_avatar->reloadIcon();
+}
+
 /**
  * @brief 设置用户名字体
  * @param font
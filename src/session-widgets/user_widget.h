@@ -48,6 +48,7 @@ private:
     void initConnections();
 
     void setAvatar(const QString &avatar);
+    void onAvatarChanged(const QString &avatar);
     void updateUserNameLabel();
     void setLoginState(const bool isLogin);
 
@@ -14,6 +14,7 @@
 #include <QScrollArea>
 #include <QScrollBar>
 #include <QScroller>
+#include <QTimer>
 #include <QVBoxLayout>
 
 #include <algorithm>
@@ -34,7 +35,9 @@ static inline int listHeight(int row)
 UserFrameList::UserFrameList(QWidget *parent)
     : QWidget(parent)
     , m_scrollArea(new QScrollArea(this))
+    , m_model(nullptr)
     , m_frameDataBind(FrameDataBind::Instance())
+    , m_materializeTimer(new QTimer(this))
 {
     setObjectName(QStringLiteral("UserFrameList"));
     setAccessibleName(QStringLiteral("UserFrameList"));
@@ -58,6 +61,12 @@ UserFrameList::UserFrameList(QWidget *parent)
         m_frameDataBind->unRegisterFunction("UserFrameList", index);
     });
     connect(this, &UserFrameList::gridBoundChanged, this, &UserFrameList::updateLayout);
+
+    // 只加载可见区域内用户的完整信息，滚动和布局变化合并到下一次事件循环处理
+    m_materializeTimer->setSingleShot(true);
+    m_materializeTimer->setInterval(0);
+    connect(m_materializeTimer, &QTimer::timeout, this, &UserFrameList::materializeVisibleUsers);
+    connect(m_scrollArea->verticalScrollBar(), &QScrollBar::valueChanged, m_materializeTimer, static_cast<void (QTimer::*)()>(&QTimer::start));
 }
 
 void UserFrameList::initUI()
@@ -313,6 +322,36 @@ void UserFrameList::updateLayout()
     int areaHeight = listHeight(qMin(row, MaxDisplayRow));
     m_scrollArea->setFixedSize(areaWidth, areaHeight);
     m_centerWidget->setFixedSize(areaWidth, listHeight(row));
+
+    m_materializeTimer->start();
+}
+
+/**
+ * @brief 加载滚动区域中可见用户的完整信息，不可见的用户保持延迟加载
+ */
+void UserFrameList::materializeVisibleUsers()
+{
+    if (!m_model || !isVisible())
+        return;
+
+    const QRect visibleRect(QPoint(0, m_scrollArea->verticalScrollBar()->value()), m_scrollArea->viewport()->size());
+    QList<std::shared_ptr<User>> users;
+    for (const UserWidget *widget : qAsConst(m_loginWidgets)) {
+        if (!widget->geometry().intersects(visibleRect))
+            continue;
+
+        std::shared_ptr<User> user = m_model->findUserByUid(widget->uid());
+        if (user && !user->isMaterialized())
+            users.append(user);
+    }
+    NativeUser::materializeUsers(users);
+}
+
+void UserFrameList::showEvent(QShowEvent *event)
+{
+    m_materializeTimer->start();
+
+    QWidget::showEvent(event);
 }
 
 void UserFrameList::hideEvent(QHideEvent *event)
@@ -18,6 +18,7 @@ class SessionBaseModel;
 class FrameDataBind;
 class QVBoxLayout;
 class QScrollArea;
+class QTimer;
 
 DWIDGET_USE_NAMESPACE
 
@@ -49,6 +50,7 @@ Q_SIGNALS:
     void gridBoundChanged(QPair<int, int> bound);
 
 protected:
+    void showEvent(QShowEvent *event) override;
     void hideEvent(QHideEvent *event) override;
     void keyPressEvent(QKeyEvent *event) override;
     void focusInEvent(QFocusEvent *event) override;
@@ -69,6 +71,7 @@ private:
     void switchNextUser();
     void switchPreviousUser();
     void setGridBound(QPair<int, int> bound);
+    void materializeVisibleUsers();
 
 private:
     QScrollArea *m_scrollArea;
@@ -82,6 +85,7 @@ private:
     int m_colCount;
     int m_rowCount;
     QPair<int, int> m_gridBound;
+    QTimer *m_materializeTimer;
 };
 
 #endif // USERFRAMELIST_H
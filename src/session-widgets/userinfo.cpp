@@ -6,6 +6,16 @@
 
 #include "constants.h"
 
+#include <QCoreApplication>
+#include <QDBusMessage>
+#include <QDBusPendingCallWatcher>
+#include <QDBusReply>
+#include <QFutureWatcher>
+#include <QHash>
+#include <QVector>
+#include <QtConcurrent>
+
+#include <errno.h>
 #include <grp.h>
 #include <memory>
 #include <pwd.h>
@@ -13,6 +23,8 @@
 
 #define DEFAULT_AVATAR ":/img/default_avatar.svg"
 #define DEFAULT_BACKGROUND "/usr/share/backgrounds/default_background.jpg"
+#define ACCOUNTS_SERVICE "org.deepin.dde.Accounts1"
+#define ACCOUNTS_USER_INTERFACE "org.deepin.dde.Accounts1.User"
 
 User::User(QObject *parent)
     : QObject(parent)
@@ -125,6 +137,15 @@ void User::setLastAuthType(const int type)
     m_lastAuthType = type;
 }
 
+/**
+ * @brief 在未加载的用户上读取了影响登录逻辑的属性，读到的是默认值
+ * 调用方需要先加载这个用户（当前用户、上次登出的用户等），见 NativeUser::materialize
+ */
+void User::warnNotMaterialized(const char *getter) const
+{
+    qWarning() << "User" << m_uid << "is not materialized, read" << getter << "returns the default value";
+}
+
 bool User::checkUserIsNoPWGrp(const User *user) const
 {
     if (user->type() == User::ADDomain) {
@@ -191,31 +212,265 @@ QString User::userPwdName(const uid_t uid) const
 }
 
 NativeUser::NativeUser(const QString &path, QObject *parent)
+    : NativeUser(path, fetchProperties(path), parent)
+{
+}
+
+/**
+ * @brief 使用已获取的账户属性创建用户，不再逐个同步读取属性
+ *
+ * @param path        账户的 DBus 路径
+ * @param properties  账户的全部属性，见 fetchProperties
+ * @param parent
+ */
+NativeUser::NativeUser(const QString &path, const QVariantMap &properties, QObject *parent)
     : User(parent)
     , m_path(path)
-    , m_userInter(new UserInter("org.deepin.dde.Accounts1", path, QDBusConnection::systemBus(), this))
+    , m_userInter(nullptr)
+    , m_propertiesWatcher(nullptr)
 {
-    initConnections();
-    initData();
-    initConfiguration(DDESESSIONCC::CONFIG_FILE + m_name);
+    materialize(properties);
 }
 
 NativeUser::NativeUser(const uid_t &uid, QObject *parent)
-    : User(parent)
-    , m_path("/org/deepin/dde/Accounts1/User" + QString::number(uid))
-    , m_userInter(new UserInter("org.deepin.dde.Accounts1", m_path, QDBusConnection::systemBus(), this))
+    : NativeUser(ACCOUNTS_DBUS_PREFIX + QString::number(uid), parent)
 {
-    initConnections();
-    initData();
-    initConfiguration(DDESESSIONCC::CONFIG_FILE + m_name);
 }
 
 NativeUser::NativeUser(const NativeUser &user)
     : User(user)
     , m_path(user.path())
-    , m_userInter(new UserInter("org.deepin.dde.Accounts1", m_path, QDBusConnection::systemBus(), this))
+    , m_userInter(nullptr)
+    , m_propertiesWatcher(nullptr)
 {
+    if (user.isMaterialized()) {
+        m_userInter = new UserInter(ACCOUNTS_SERVICE, m_path, QDBusConnection::systemBus(), this);
+        initConnections();
+    }
+}
+
+/**
+ * @brief 轻量的用户对象，只保存路径、uid 和用户名，其它属性在 materialize 时获取
+ *
+ * @param path 账户的 DBus 路径
+ * @param uid  用户 uid
+ * @param name 用户名，为空时显示占位的用户名，加载属性后更新
+ */
+NativeUser::NativeUser(const QString &path, const uid_t uid, const QString &name)
+    : User(nullptr)
+    , m_path(path)
+    , m_userInter(nullptr)
+    , m_propertiesWatcher(nullptr)
+{
+    m_uid = uid;
+    if (!name.isEmpty()) {
+        m_name = name;
+    }
+}
+
+/**
+ * @brief 创建轻量的用户对象，用户数量很多时避免为每个用户创建 DBus 对象和获取全部属性
+ *
+ * @param path 账户的 DBus 路径
+ * @return std::shared_ptr<NativeUser>
+ */
+std::shared_ptr<NativeUser> NativeUser::createLazy(const QString &path)
+{
+    return createLazy(QStringList(path)).first();
+}
+
+/**
+ * @brief 用 getpwuid_r 逐个查询用户名，在线程池中执行
+ * 不遍历整个 passwd，LDAP/SSSD 打开枚举时遍历会下载整个目录
+ *
+ * @param uids 用户 uid
+ * @return QHash<uid_t, QString> uid -> 用户名，查不到的用户没有记录
+ */
+static QHash<uid_t, QString> resolveUserNames(const QVector<uid_t> &uids)
+{
+    QHash<uid_t, QString> names;
+    names.reserve(uids.size());
+    const long bufferSize = sysconf(_SC_GETPW_R_SIZE_MAX);
+    QByteArray buffer(bufferSize > 0 ? static_cast<int>(bufferSize) : 16384, Qt::Uninitialized);
+    for (const uid_t uid : uids) {
+        struct passwd pwd;
+        struct passwd *result = nullptr;
+        int ret = 0;
+        while ((ret = getpwuid_r(uid, &pwd, buffer.data(), static_cast<size_t>(buffer.size()), &result)) == ERANGE) {
+            buffer.resize(buffer.size() * 2);
+        }
+        if (ret == 0 && result) {
+            names.insert(uid, QString::fromLocal8Bit(result->pw_name));
+        }
+    }
+    return names;
+}
+
+/**
+ * @brief 批量创建轻量的用户对象，不在调用线程中查询用户名
+ * 用户名先显示占位值，在线程池中查询到之后更新；加载属性后使用 Accounts 中的用户名。
+ *
+ * @param paths 账户的 DBus 路径
+ * @return QList<std::shared_ptr<NativeUser>> 和 paths 的顺序一致
+ */
+QList<std::shared_ptr<NativeUser>> NativeUser::createLazy(const QStringList &paths)
+{
+    QList<std::shared_ptr<NativeUser>> users;
+    users.reserve(paths.size());
+    QVector<uid_t> uids;
+    uids.reserve(paths.size());
+    QList<std::weak_ptr<NativeUser>> weakUsers;
+    weakUsers.reserve(paths.size());
+    for (const QString &path : paths) {
+        const uid_t uid = path.mid(QString(ACCOUNTS_DBUS_PREFIX).length()).toUInt();
+        std::shared_ptr<NativeUser> user(new NativeUser(path, uid, QString()));
+        users.append(user);
+        uids.append(uid);
+        weakUsers.append(user);
+    }
+    if (users.isEmpty() || !QCoreApplication::instance()) {
+        return users;
+    }
+
+    auto watcher = new QFutureWatcher<QHash<uid_t, QString>>(QCoreApplication::instance());
+    QObject::connect(watcher, &QFutureWatcher<QHash<uid_t, QString>>::finished, watcher, [watcher, weakUsers] {
+        watcher->deleteLater();
+        const QHash<uid_t, QString> names = watcher->result();
+        for (const std::weak_ptr<NativeUser> &weakUser : weakUsers) {
+            const std::shared_ptr<NativeUser> user = weakUser.lock();
+            // 已经加载的用户使用 Accounts 中的用户名
+            if (!user || user->isMaterialized()) {
+                continue;
+            }
+            const QString name = names.value(user->uid());
+            if (!name.isEmpty()) {
+                user->updateName(name);
+            }
+        }
+    });
+    watcher->setFuture(QtConcurrent::run(resolveUserNames, uids));
+
+    return users;
+}
+
+/**
+ * @brief 异步获取需要显示的用户的全部属性，GetAll 调用同时发出，不等待回复
+ * 回复到达之前界面显示占位信息，见 materializeAsync
+ *
+ * @param users 需要显示的用户
+ */
+void NativeUser::materializeUsers(const QList<std::shared_ptr<User>> &users)
+{
+    for (const std::shared_ptr<User> &user : users) {
+        if (!user || user->isMaterialized() || user->type() != Native) {
+            continue;
+        }
+        std::static_pointer_cast<NativeUser>(user)->materializeAsync();
+    }
+}
+
+/**
+ * @brief 异步获取用户的全部属性，回复到达后再创建 DBus 对象并通知界面更新
+ * 获取失败时保持未加载的状态，下次显示时重新获取
+ */
+void NativeUser::materializeAsync()
+{
+    if (isMaterialized() || m_propertiesWatcher) {
+        return;
+    }
+
+    QDBusMessage message = QDBusMessage::createMethodCall(ACCOUNTS_SERVICE, m_path, "org.freedesktop.DBus.Properties", "GetAll");
+    message << QString(ACCOUNTS_USER_INTERFACE);
+    m_propertiesWatcher = new QDBusPendingCallWatcher(QDBusConnection::systemBus().asyncCall(message), this);
+    connect(m_propertiesWatcher, &QDBusPendingCallWatcher::finished, this, [this](QDBusPendingCallWatcher *call) {
+        const QDBusPendingReply<QVariantMap> reply = *call;
+        call->deleteLater();
+        m_propertiesWatcher = nullptr;
+        if (reply.isError()) {
+            qWarning() << "Failed to get user properties:" << m_path << reply.error().message();
+            return;
+        }
+        materialize(reply.value());
+    });
+}
+
+/**
+ * @brief 获取用户的全部属性并监听属性变化
+ */
+void NativeUser::materialize()
+{
+    if (isMaterialized()) {
+        return;
+    }
+    materialize(fetchProperties(m_path));
+}
+
+void NativeUser::materialize(const QVariantMap &properties)
+{
+    if (isMaterialized()) {
+        return;
+    }
+
+    const QString name = m_name;
+    const uid_t uid = m_uid;
+    const QString avatar = m_avatar;
+    const QString displayName = this->displayName();
+    const QString greeterBackground = m_greeterBackground;
+    const QString keyboardLayout = m_keyboardLayout;
+    const QStringList keyboardLayoutList = m_keyboardLayoutList;
+    const QString locale = m_locale;
+    const bool isAutomaticLogin = m_isAutomaticLogin;
+    const bool isNoPasswordLogin = m_isNoPasswordLogin;
+    const int accountType = m_accountType;
+
+    m_userInter = new UserInter(ACCOUNTS_SERVICE, m_path, QDBusConnection::systemBus(), this);
     initConnections();
+    initData(properties);
+    initPasswordExpiredInfo();
+    initConfiguration(DDESESSIONCC::CONFIG_FILE + m_name);
+
+    // 通知已经在使用这个用户的界面更新
+    if (name != m_name)
+        emit nameChanged(m_name, name);
+    if (uid != m_uid)
+        emit uidChanged(m_uid, uid);
+    if (avatar != m_avatar)
+        emit avatarChanged(m_avatar);
+    if (displayName != this->displayName())
+        emit displayNameChanged(this->displayName());
+    if (greeterBackground != m_greeterBackground)
+        emit greeterBackgroundChanged(m_greeterBackground);
+    if (keyboardLayout != m_keyboardLayout)
+        emit keyboardLayoutChanged(m_keyboardLayout);
+    if (keyboardLayoutList != m_keyboardLayoutList)
+        emit keyboardLayoutListChanged(m_keyboardLayoutList);
+    if (locale != m_locale)
+        emit localeChanged(m_locale);
+    if (isAutomaticLogin != m_isAutomaticLogin)
+        emit autoLoginStateChanged(m_isAutomaticLogin);
+    if (isNoPasswordLogin != m_isNoPasswordLogin)
+        emit noPasswordLoginChanged(m_isNoPasswordLogin);
+    if (accountType != m_accountType)
+        emit accountTypeChanged(m_accountType);
+}
+
+/**
+ * @brief 通过一次 GetAll 调用同步获取账户的全部属性，只用于当前用户等必须立即可用的情况
+ *
+ * @param path 账户的 DBus 路径
+ * @return QVariantMap 属性名 -> 属性值，失败时为空
+ */
+QVariantMap NativeUser::fetchProperties(const QString &path)
+{
+    QDBusMessage message = QDBusMessage::createMethodCall(ACCOUNTS_SERVICE, path, "org.freedesktop.DBus.Properties", "GetAll");
+    message << QString(ACCOUNTS_USER_INTERFACE);
+    const QDBusReply<QVariantMap> reply = QDBusConnection::systemBus().call(message);
+    if (!reply.isValid()) {
+        qWarning() << "Failed to get user properties:" << path << reply.error().message();
+        return QVariantMap();
+    }
+
+    return reply.value();
 }
 
 void NativeUser::initConnections()
@@ -242,35 +497,57 @@ void NativeUser::initConnections()
     connect(m_userInter, &UserInter::MaxPasswordAgeChanged, this, &NativeUser::updatePasswordExpiredInfo);
 }
 
-void NativeUser::initData()
+void NativeUser::initData(const QVariantMap &properties)
 {
-    m_isAutomaticLogin = m_userInter->automaticLogin();
-    m_isNoPasswordLogin = m_userInter->noPasswdLogin();
-    m_isPasswordValid = (m_userInter->passwordStatus() == "P");
-    m_isUse24HourFormat = m_userInter->use24HourFormat();
+    if (properties.isEmpty()) {
+        return;
+    }
 
-    m_expiredState = m_userInter->PasswordExpiredInfo(m_expiredDayLeft).value();
-    m_shortDateFormat = m_userInter->shortDateFormat();
-    m_shortTimeFormat = m_userInter->shortTimeFormat();
-    m_weekdayFormat = m_userInter->weekdayFormat();
-    m_accountType = m_userInter->accountType();
+    m_isAutomaticLogin = properties.value("AutomaticLogin").toBool();
+    m_isNoPasswordLogin = properties.value("NoPasswdLogin").toBool();
+    m_isPasswordValid = (properties.value("PasswordStatus").toString() == "P");
+    m_isUse24HourFormat = properties.value("Use24HourFormat").toBool();
 
-    const QString avatarPath = toLocalFile(m_userInter->iconFile());
+    m_shortDateFormat = properties.value("ShortDateFormat").toInt();
+    m_shortTimeFormat = properties.value("ShortTimeFormat").toInt();
+    m_weekdayFormat = properties.value("WeekdayFormat").toInt();
+    m_accountType = properties.value("AccountType", m_accountType).toInt();
+
+    const QString avatarPath = toLocalFile(properties.value("IconFile").toString());
     if (!avatarPath.isEmpty() && QFile(avatarPath).exists() && QFile(avatarPath).size() && QImageReader(avatarPath).canRead()) {
         m_avatar = avatarPath;
     }
-    m_fullName = m_userInter->fullName();
-    const QString backgroundPath = toLocalFile(m_userInter->greeterBackground());
+    m_fullName = properties.value("FullName").toString();
+    const QString backgroundPath = toLocalFile(properties.value("GreeterBackground").toString());
     if (!backgroundPath.isEmpty() && QFile(backgroundPath).exists() && QFile(backgroundPath).size() && QImageReader(backgroundPath).canRead()) {
         m_greeterBackground = backgroundPath;
     }
-    m_keyboardLayout = m_userInter->layout();
-    m_locale = m_userInter->locale();
-    m_name = m_userInter->userName();
-    m_passwordHint = m_userInter->passwordHint();
-    m_desktopBackgrounds = m_userInter->desktopBackgrounds();
-    m_keyboardLayoutList = m_userInter->historyLayout();
-    m_uid = m_userInter->uid().toUInt();
+    m_keyboardLayout = properties.value("Layout").toString();
+    m_locale = properties.value("Locale").toString();
+    m_name = properties.value("UserName").toString();
+    m_passwordHint = properties.value("PasswordHint").toString();
+    m_desktopBackgrounds = properties.value("DesktopBackgrounds").toStringList();
+    m_keyboardLayoutList = properties.value("HistoryLayout").toStringList();
+    m_uid = properties.value("Uid").toString().toUInt();
+}
+
+/**
+ * @brief 异步获取密码过期信息，认证前还会通过 updatePasswordExpiredInfo 同步更新
+ */
+void NativeUser::initPasswordExpiredInfo()
+{
+    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(m_userInter->PasswordExpiredInfo(), this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [this](QDBusPendingCallWatcher *call) {
+        const QDBusPendingReply<int, int> reply = *call;
+        call->deleteLater();
+        if (reply.isError()) {
+            qWarning() << "Failed to get password expired info:" << m_path << reply.error().message();
+            return;
+        }
+        m_expiredState = reply.argumentAt<0>();
+        m_expiredDayLeft = reply.argumentAt<1>();
+        emit passwordExpiredInfoChanged();
+    });
 }
 
 /**
@@ -303,6 +580,7 @@ void NativeUser::initConfiguration(const QString &config)
  */
 void NativeUser::setKeyboardLayout(const QString &keyboard)
 {
+    materialize();
     m_userInter->SetLayout(keyboard);
 }
 
@@ -421,7 +699,9 @@ void NativeUser::updateName(const QString &name)
     if (name == m_name) {
         return;
     }
+    const QString oldName = m_name;
     m_name = name;
+    emit nameChanged(name, oldName);
     emit displayNameChanged(m_fullName.isEmpty() ? name : m_fullName);
 }
 
@@ -459,6 +739,7 @@ void NativeUser::updatePasswordHint(const QString &hint)
  */
 void NativeUser::updatePasswordExpiredInfo()
 {
+    materialize();
     m_expiredState = m_userInter->PasswordExpiredInfo(m_expiredDayLeft).value();
 
     emit passwordExpiredInfoChanged();
@@ -540,7 +821,9 @@ void NativeUser::updateUid(const QString &uid)
     if (uidTmp == m_uid) {
         return;
     }
+    const uid_t oldUid = m_uid;
     m_uid = uidTmp;
+    emit uidChanged(uidTmp, oldUid);
 }
 
 /**
@@ -607,6 +890,8 @@ void ADDomainUser::setName(const QString &name)
     if (m_name == name) {
         return;
     }
+    const QString oldName = m_name;
     m_name = name;
+    emit nameChanged(name, oldName);
     emit displayNameChanged(m_fullName.isEmpty() ? name : m_fullName);
 }
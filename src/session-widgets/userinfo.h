@@ -12,8 +12,12 @@
 
 #include <QObject>
 
+#include <memory>
+
 using UserInter = org::deepin::dde::accounts1::User;
 
+class QDBusPendingCallWatcher;
+
 class User : public QObject
 {
     Q_OBJECT
@@ -51,19 +55,23 @@ public:
 
     bool operator==(const User &user) const;
 
-    inline bool isAutomaticLogin() const { return m_isAutomaticLogin; }
-    inline bool isPasswordValid() const { return m_isPasswordValid; }
+    // 用户名、头像、全名和账户类型在延迟加载的用户上是占位值，用于显示用户列表；
+    // 其它属性会影响登录和锁屏的逻辑，只能在当前用户、上次登出的用户等已经加载的用户上读取，
+    // 在未加载的用户上读取时打印警告，不会在这里同步加载，见 NativeUser::materialize
+    inline bool isAutomaticLogin() const { checkMaterialized(__func__); return m_isAutomaticLogin; }
+    inline bool isPasswordValid() const { checkMaterialized(__func__); return m_isPasswordValid; }
     inline bool isLogin() const { return m_isLogin; }
-    inline bool isNoPasswordLogin() const { return m_isNoPasswordLogin || !m_isPasswordValid; }
+    inline bool isNoPasswordLogin() const { checkMaterialized(__func__); return m_isNoPasswordLogin || !m_isPasswordValid; }
     virtual inline bool isUserValid() const { return false; }
-    inline bool isUse24HourFormat() const { return m_isUse24HourFormat; }
+    virtual inline bool isMaterialized() const { return true; }
+    inline bool isUse24HourFormat() const { checkMaterialized(__func__); return m_isUse24HourFormat; }
 
-    inline int expiredDayLeft() const { return m_expiredDayLeft; }
-    inline int expiredState() const { return m_expiredState; }
+    inline int expiredDayLeft() const { checkMaterialized(__func__); return m_expiredDayLeft; }
+    inline int expiredState() const { checkMaterialized(__func__); return m_expiredState; }
     inline int lastAuthType() const { return m_lastAuthType; }
-    inline int shortDateFormat() const { return m_shortDateFormat; }
-    inline int shortTimeFormat() const { return m_shortTimeFormat; }
-    inline int weekdayFormat() const { return m_weekdayFormat; }
+    inline int shortDateFormat() const { checkMaterialized(__func__); return m_shortDateFormat; }
+    inline int shortTimeFormat() const { checkMaterialized(__func__); return m_shortTimeFormat; }
+    inline int weekdayFormat() const { checkMaterialized(__func__); return m_weekdayFormat; }
     inline int accountType() const { return m_accountType; }
 
     virtual inline int type() const { return Default; }
@@ -72,14 +80,14 @@ public:
     inline QString avatar() const { return m_avatar; }
     inline QString displayName() const { return m_fullName.isEmpty() ? m_name : m_fullName; }
     inline QString fullName() const { return m_fullName; }
-    inline QString greeterBackground() const { return m_greeterBackground; }
-    inline QString keyboardLayout() const { return m_keyboardLayout; }
-    inline QString locale() const { return m_locale; }
+    inline QString greeterBackground() const { checkMaterialized(__func__); return m_greeterBackground; }
+    inline QString keyboardLayout() const { checkMaterialized(__func__); return m_keyboardLayout; }
+    inline QString locale() const { checkMaterialized(__func__); return m_locale; }
     inline QString name() const { return m_name; }
-    inline QString passwordHint() const { return m_passwordHint; }
+    inline QString passwordHint() const { checkMaterialized(__func__); return m_passwordHint; }
     virtual inline QString path() const { return QString(); }
-    inline QStringList desktopBackgrounds() const { return m_desktopBackgrounds; }
-    inline QStringList keyboardLayoutList() const { return m_keyboardLayoutList; }
+    inline QStringList desktopBackgrounds() const { checkMaterialized(__func__); return m_desktopBackgrounds; }
+    inline QStringList keyboardLayoutList() const { checkMaterialized(__func__); return m_keyboardLayoutList; }
     inline uid_t uid() const { return m_uid; }
 
     void updateLimitsInfo(const QString &info);
@@ -88,6 +96,7 @@ public:
 
     virtual void setKeyboardLayout(const QString &keyboard) { Q_UNUSED(keyboard) }
     virtual void updatePasswordExpiredInfo() { }
+    virtual void materialize() { }
 
 signals:
     void avatarChanged(const QString &);
@@ -107,9 +116,13 @@ signals:
     void accountTypeChanged(const int);
     void use24HourFormatChanged(const bool);
     void passwordExpiredInfoChanged();
+    void nameChanged(const QString &name, const QString &oldName);
+    void uidChanged(const uid_t uid, const uid_t oldUid);
 
 
 protected:
+    inline void checkMaterialized(const char *getter) const { if (!isMaterialized()) warnNotMaterialized(getter); }
+    void warnNotMaterialized(const char *getter) const;
     bool checkUserIsNoPWGrp(const User *user) const;
     QString toLocalFile(const QString &path) const;
     QString userPwdName(const uid_t uid) const;
@@ -145,10 +158,17 @@ class NativeUser : public User
     Q_OBJECT
 public:
     explicit NativeUser(const QString &path, QObject *parent = nullptr);
+    explicit NativeUser(const QString &path, const QVariantMap &properties, QObject *parent = nullptr);
     explicit NativeUser(const uid_t &uid, QObject *parent = nullptr);
     explicit NativeUser(const NativeUser &user);
 
-    inline bool isUserValid() const override { return m_userInter->isValid(); }
+    static QVariantMap fetchProperties(const QString &path);
+    static std::shared_ptr<NativeUser> createLazy(const QString &path);
+    static QList<std::shared_ptr<NativeUser>> createLazy(const QStringList &paths);
+    static void materializeUsers(const QList<std::shared_ptr<User>> &users);
+
+    inline bool isUserValid() const override { return m_userInter && m_userInter->isValid(); }
+    inline bool isMaterialized() const override { return m_userInter; }
 
     inline int type() const override { return Native; }
     inline QString path() const override { return m_path; }
@@ -156,6 +176,8 @@ public:
     void setKeyboardLayout(const QString &keyboard) override;
 
     void updatePasswordExpiredInfo() override;
+    void materialize() override;
+    void materializeAsync();
 
 private slots:
     void updateAvatar(const QString &path);
@@ -177,14 +199,19 @@ private slots:
     void updateUse24HourFormat(const bool is24HourFormat);
 
 private:
+    NativeUser(const QString &path, const uid_t uid, const QString &name);
+
+    void materialize(const QVariantMap &properties);
     void initConnections();
-    void initData();
+    void initData(const QVariantMap &properties);
+    void initPasswordExpiredInfo();
     void initConfiguration(const QString &config);
     QStringList readDesktopBackgroundPath(const QString &path);
 
 private:
     QString m_path;
-    UserInter *m_userInter;
+    UserInter *m_userInter; // 仅在用户需要显示或被选中时创建，见 materialize
+    QDBusPendingCallWatcher *m_propertiesWatcher; // 正在异步获取属性，见 materializeAsync
 };
 
 class ADDomainUser : public User
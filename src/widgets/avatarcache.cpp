@@ -0,0 +1,137 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "avatarcache.h"
+#include "imagefilter.h"
+
+#include <QFutureWatcher>
+#include <QImageReader>
+#include <QPainter>
+#include <QPainterPath>
+#include <QtConcurrent>
+
+static const int AVATAR_CACHE_MAX_COST = 16 * 1024;   // 缓存上限，单位 KB
+
+static QString cacheKey(const QString &path, const QSize &size, qreal ratio, int radius, bool grayscale)
+{
+    return QString("%1\n%2x%3\n%4\n%5\n%6").arg(path).arg(size.width()).arg(size.height())
+            .arg(ratio).arg(radius).arg(grayscale);
+}
+
+AvatarCache::AvatarCache(QObject *parent)
+    : QObject(parent)
+    , m_cache(AVATAR_CACHE_MAX_COST)
+{
+}
+
+AvatarCache *AvatarCache::instance()
+{
+    static AvatarCache avatarCache;
+    return &avatarCache;
+}
+
+/**
+ * @brief 获取处理好的头像，缓存中没有时在线程池中生成，完成后发送 pixmapReady 信号
+ *
+ * @param path 头像路径
+ * @param size 显示尺寸
+ * @param ratio 设备缩放比例
+ * @param radius 圆角半径
+ * @param grayscale 是否转成灰度图
+ * @return QPixmap 头像还没有生成或者无法读取时返回空图片
+ */
+QPixmap AvatarCache::pixmap(const QString &path, const QSize &size, qreal ratio, int radius, bool grayscale)
+{
+    if (path.isEmpty() || size.isEmpty())
+        return QPixmap();
+
+    const QString key = cacheKey(path, size, ratio, radius, grayscale);
+    if (QPixmap *pixmap = m_cache.object(key))
+        return *pixmap;
+
+    if (m_pendingKeys.contains(key))
+        return QPixmap();
+
+    m_pendingKeys.insert(key);
+    m_pathKeys[path].insert(key);
+    auto watcher = new QFutureWatcher<QImage>(this);
+    connect(watcher, &QFutureWatcher<QImage>::finished, this, [this, watcher, key, path, ratio] {
+        watcher->deleteLater();
+        // 生成期间头像已经失效
+        if (!m_pendingKeys.remove(key))
+            return;
+
+        // 无法读取的头像也缓存空图片，避免重复读取
+        QPixmap *pixmap = new QPixmap(QPixmap::fromImage(watcher->result()));
+        pixmap->setDevicePixelRatio(ratio);
+        m_cache.insert(key, pixmap, qMax(1, pixmap->width() * pixmap->height() * 4 / 1024));
+        Q_EMIT pixmapReady(path);
+    });
+    watcher->setFuture(QtConcurrent::run(&AvatarCache::render, path, size, ratio, radius, grayscale));
+
+    return QPixmap();
+}
+
+/**
+ * @brief 头像文件变化时清除这个文件的所有尺寸的缓存
+ */
+void AvatarCache::invalidate(const QString &path)
+{
+    const QSet<QString> keys = m_pathKeys.take(path);
+    for (const QString &key : keys) {
+        m_cache.remove(key);
+        m_pendingKeys.remove(key);
+    }
+
+    Q_EMIT pixmapReady(path);
+}
+
+/**
+ * @brief 只清除一个尺寸的缓存，参数和 pixmap 一致
+ */
+void AvatarCache::invalidate(const QString &path, const QSize &size, qreal ratio, int radius, bool grayscale)
+{
+    const QString key = cacheKey(path, size, ratio, radius, grayscale);
+    m_cache.remove(key);
+    m_pendingKeys.remove(key);
+    auto it = m_pathKeys.find(path);
+    if (it != m_pathKeys.end()) {
+        it->remove(key);
+        if (it->isEmpty())
+            m_pathKeys.erase(it);
+    }
+
+    Q_EMIT pixmapReady(path);
+}
+
+/**
+ * @brief 在线程池中解码并裁剪头像
+ */
+QImage AvatarCache::render(const QString &path, const QSize &size, qreal ratio, int radius, bool grayscale)
+{
+    const QSize trueSize = size * ratio;
+    QImageReader reader(path);
+    // 按需要的尺寸解码，头像原图可能很大
+    if (reader.supportsOption(QImageIOHandler::ScaledSize))
+        reader.setScaledSize(trueSize);
+    const QImage source = reader.read();
+    if (source.isNull())
+        return QImage();
+
+    QImage image(trueSize, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+
+    QPainter painter(&image);
+    painter.setRenderHints(QPainter::Antialiasing | QPainter::SmoothPixmapTransform);
+    QPainterPath clipPath;
+    clipPath.addRoundedRect(QRectF(QPointF(0, 0), trueSize), radius * ratio, radius * ratio);
+    painter.setClipPath(clipPath);
+    painter.drawImage(image.rect(), source);
+    painter.end();
+
+    if (grayscale)
+        image = ImageFilter::grayscale(image);
+
+    return image;
+}
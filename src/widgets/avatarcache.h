@@ -0,0 +1,43 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef AVATARCACHE_H
+#define AVATARCACHE_H
+
+#include <QCache>
+#include <QHash>
+#include <QObject>
+#include <QPixmap>
+#include <QSet>
+
+/**
+ * @brief 用户头像缓存
+ * 头像在线程池中解码，按尺寸、缩放比例裁剪成圆角，需要时再转成灰度图，
+ * 绘制时直接使用缓存的图片，不再读取文件。
+ */
+class AvatarCache : public QObject
+{
+    Q_OBJECT
+public:
+    static AvatarCache *instance();
+
+    QPixmap pixmap(const QString &path, const QSize &size, qreal ratio, int radius, bool grayscale = false);
+    void invalidate(const QString &path);
+    void invalidate(const QString &path, const QSize &size, qreal ratio, int radius, bool grayscale = false);
+
+Q_SIGNALS:
+    void pixmapReady(const QString &path);
+
+private:
+    explicit AvatarCache(QObject *parent = nullptr);
+
+    static QImage render(const QString &path, const QSize &size, qreal ratio, int radius, bool grayscale);
+
+private:
+    QCache<QString, QPixmap> m_cache;
+    QSet<QString> m_pendingKeys;
+    QHash<QString, QSet<QString>> m_pathKeys;   // 头像路径 -> 缓存的键值，用于清除一个头像的缓存
+};
+
+#endif // AVATARCACHE_H
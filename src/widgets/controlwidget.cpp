@@ -17,20 +17,24 @@
 #include "userlistpopupwidget.h"
 #include "roundpopupwidget.h"
 #include "constants.h"
+#include "tracer.h"
 
 #include <DFloatingButton>
 #include <DPushButton>
 #include <DConfig>
 
+#include <QElapsedTimer>
 #include <QEvent>
 #include <QGraphicsDropShadowEffect>
 #include <QHBoxLayout>
 #include <QWheelEvent>
 #include <QMenu>
+#include <QTimer>
 
 #define BUTTON_ICON_SIZE QSize(26,26)
 #define BUTTON_SIZE QSize(52,52)
 static constexpr int TipsBottomDistance = 10;
+static constexpr int TrayModuleIdleInitDelay = 1000;   // 界面显示后延迟初始化托盘插件，单位毫秒
 
 using namespace dss;
 DCORE_USE_NAMESPACE
@@ -61,6 +65,7 @@ ControlWidget::ControlWidget(const SessionBaseModel *model, QWidget *parent)
     , m_sessionBtn(new FloatingButton(this))
     , m_keyboardBtn(nullptr)
     , m_contextMenu(new QMenu(this))
+    , m_trayInitTimer(new QTimer(this))
     , m_tipContentWidget(nullptr)
     , m_tipsWidget(new TipsWidget(parent ? parent->window() : nullptr))
     , m_roundPopupWidget(new RoundPopupWidget(this))
@@ -115,6 +120,7 @@ void ControlWidget::initUI()
 {
     m_tipsWidget->setVisible(false);
     m_roundPopupWidget->setVisible(false);
+    m_trayInitTimer->setSingleShot(true);
 
     m_mainLayout = new QHBoxLayout(this);
     m_mainLayout->setContentsMargins(0, 0, 60, 0);
@@ -181,6 +187,7 @@ void ControlWidget::initUI()
 void ControlWidget::initConnect()
 {
     connect(&module::ModulesLoader::instance(), &module::ModulesLoader::moduleFound, this, &ControlWidget::addModule);
+    connect(m_trayInitTimer, &QTimer::timeout, this, &ControlWidget::initPendingTrayModule);
 
     connect(m_sessionBtn, &FloatingButton::clicked, this, &ControlWidget::showSessionPopup);
     connect(m_sessionBtn, &FloatingButton::requestShowTips, this, &ControlWidget::showInfoTips);
@@ -213,27 +220,22 @@ void ControlWidget::addModule(module::BaseModuleInterface *module)
     if (!trayModule)
         return;
 
-    trayModule->init();
-
+    // 先只用图标占位，init、content 和菜单解析推迟到第一次交互或者界面空闲时，不影响密码框的显示
     FloatingButton *button = new FloatingButton(this);
     button->setIconSize(QSize(26, 26));
     button->setFixedSize(QSize(52, 52));
     button->setAutoExclusive(true);
     button->setBackgroundRole(DPalette::Button);
+    const QString iconPath = trayModule->icon();
+    button->setIcon(QIcon(iconPath));
 
-    if (QWidget *trayWidget = trayModule->itemWidget()) {
-        QHBoxLayout *layout = new QHBoxLayout(button);
-        layout->setAlignment(Qt::AlignCenter);
-        layout->setSpacing(0);
-        layout->setMargin(0);
-        layout->addWidget(trayWidget);
-    } else {
-        button->setIcon(QIcon(trayModule->icon()));
-    }
-
-    m_modules.insert(trayModule->key(), button);
+    const QString key = trayModule->key();
+    m_modules.insert(key, button);
+    m_pendingTrayModules.insert(key, trayModule);
 
     connect(button, &FloatingButton::requestShowMenu, this, [ = ] {
+        initTrayModule(key, "menu");
+
         const QString menuJson = trayModule->itemContextMenu();
         if (menuJson.isEmpty())
             return;
@@ -262,6 +264,8 @@ void ControlWidget::addModule(module::BaseModuleInterface *module)
     });
 
     connect(button, &FloatingButton::requestShowTips, this, [ = ] {
+        initTrayModule(key, "hover");
+
         if (trayModule->itemTipsWidget()) {
             m_tipsWidget->setContent(trayModule->itemTipsWidget());
             QPoint p = m_tipsWidget->parentWidget() ? m_tipsWidget->parentWidget()->mapFromGlobal(mapToGlobal(button->pos())) : mapToGlobal(button->pos());
@@ -277,14 +281,68 @@ void ControlWidget::addModule(module::BaseModuleInterface *module)
         m_tipsWidget->hide();
     });
 
-    connect(button, &FloatingButton::clicked, this, [this, button, trayModule] {
+    connect(button, &FloatingButton::clicked, this, [this, button, key, trayModule] {
+        initTrayModule(key, "click");
+
         auto content = trayModule->content();
         if (!content)
             return;
         toggleButtonPopup(button, content);
     });
 
+    // 没有图标的插件（如虚拟键盘）由 itemWidget 绘制图标，只有初始化后按钮才不是空白的，不能推迟
+    if (iconPath.isEmpty())
+        initTrayModule(key, "no icon");
+
     updateLayout();
+
+    if (isVisible() && !m_pendingTrayModules.isEmpty() && !m_trayInitTimer->isActive())
+        m_trayInitTimer->start(TrayModuleIdleInitDelay);
+}
+
+/**
+ * @brief 初始化托盘插件，并用插件提供的图标界面替换占位图标，已经初始化过的插件直接返回
+ *
+ * @param key 插件的键值
+ * @param reason 触发初始化的原因，用于日志
+ */
+void ControlWidget::initTrayModule(const QString &key, const char *reason)
+{
+    module::TrayModuleInterface *trayModule = m_pendingTrayModules.take(key);
+    if (!trayModule)
+        return;
+
+    DSS_TRACE_SCOPE("initTrayModule");
+    QElapsedTimer timer;
+    timer.start();
+    trayModule->init();
+
+    FloatingButton *button = qobject_cast<FloatingButton *>(m_modules.value(key));
+    QWidget *trayWidget = trayModule->itemWidget();
+    if (button && trayWidget) {
+        button->setIcon(QIcon());
+        QHBoxLayout *layout = new QHBoxLayout(button);
+        layout->setAlignment(Qt::AlignCenter);
+        layout->setSpacing(0);
+        layout->setMargin(0);
+        layout->addWidget(trayWidget);
+    }
+
+    qInfo() << "Tray module" << key << "initialized on" << reason << ", cost:" << timer.elapsed() << "ms";
+}
+
+/**
+ * @brief 界面空闲时每次初始化一个托盘插件，避免一次占用事件循环太久
+ */
+void ControlWidget::initPendingTrayModule()
+{
+    if (m_pendingTrayModules.isEmpty())
+        return;
+
+    initTrayModule(m_pendingTrayModules.firstKey(), "idle");
+
+    if (!m_pendingTrayModules.isEmpty())
+        m_trayInitTimer->start(0);
 }
 
 void ControlWidget::updateLayout()
@@ -541,5 +599,8 @@ void ControlWidget::showEvent(QShowEvent *event)
 {
     updateTapOrder();
 
+    if (!m_pendingTrayModules.isEmpty() && !m_trayInitTimer->isActive())
+        m_trayInitTimer->start(TrayModuleIdleInitDelay);
+
     QWidget::showEvent(event);
 }
@@ -19,6 +19,7 @@
 namespace dss {
 namespace module {
 class BaseModuleInterface;
+class TrayModuleInterface;
 }
 } // namespace dss
 
@@ -40,6 +41,7 @@ class TipContentWidget;
 class SessionPopupWidget;
 class UserListPopupWidget;
 class RoundPopupWidget;
+class QTimer;
 
 const int BlurRadius = 15;
 const int BlurTransparency = 70;
@@ -128,10 +130,12 @@ private:
     void updateTapOrder();
     int focusedBtnIndex();
     void toggleButtonPopup(const FloatingButton *button, QWidget *popup);
+    void initTrayModule(const QString &key, const char *reason);
 
 private slots:
     void showInfoTips();
     void hideInfoTips();
+    void initPendingTrayModule();
 
 private:
     QList<FloatingButton *> m_showedBtnList;
@@ -148,6 +152,8 @@ private:
 
     QMenu *m_contextMenu;
     QMap<QString, QWidget *> m_modules;
+    QMap<QString, dss::module::TrayModuleInterface *> m_pendingTrayModules;  // 还没有调用 init 的托盘插件
+    QTimer *m_trayInitTimer;                    // 空闲时初始化托盘插件
 
     TipContentWidget *m_tipContentWidget;       // 显示按钮文字tip
     TipsWidget *m_tipsWidget;                   // 显示插件提供widget tip
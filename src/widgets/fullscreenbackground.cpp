@@ -5,24 +5,87 @@
 #include "fullscreenbackground.h"
 
 #include "black_widget.h"
+#include "imageblur.h"
 #include "public_func.h"
 #include "sessionbasemodel.h"
+#include "wallpapercache.h"
 
 #include <DGuiApplicationHelper>
 
 #include <QDebug>
+#include <QFutureWatcher>
 #include <QImageReader>
 #include <QKeyEvent>
 #include <QPainter>
 #include <QScreen>
 #include <QTimer>
 #include <QWindow>
+#include <QtConcurrent>
+#include <QtMath>
 
 DGUI_USE_NAMESPACE
 
 const int PIXMAP_TYPE_BACKGROUND = 0;
 const int PIXMAP_TYPE_BLUR_BACKGROUND = 1;
 
+using ScaledImageList = QList<QPair<QSize, QImage>>;
+
+// 壁纸异步加载状态，下标为壁纸类型
+static bool pixmapRequested[2] = {false, false};    // 已经安排了加载，多个屏幕的请求合并成一次
+static QString pixmapCachedPath[2];                 // 缓存中的壁纸对应的图片路径
+static bool localBlurBackground = false;            // 模糊壁纸是否是本地根据清晰壁纸生成的临时壁纸
+
+// 等待 ImageEffect1 返回模糊壁纸的时间，超时后先使用本地模糊的壁纸
+static const int BLUR_SERVICE_TIMEOUT = 300;
+
+/**
+ * @brief 解码图片。JPEG 等格式在解码时就缩小到覆盖最大屏幕所需的尺寸，避免解码完整的大图
+ *
+ * @param path 图片路径
+ * @param sizes 需要的壁纸尺寸
+ */
+static QImage decodeImage(const QString &path, const QList<QSize> &sizes)
+{
+    QImageReader reader(path);
+    const QSize imageSize = reader.size();
+    if (imageSize.isValid()) {
+        qreal factor = 0;
+        for (const QSize &size : sizes) {
+            factor = qMax(factor, qMax(static_cast<qreal>(size.width()) / imageSize.width(),
+                                       static_cast<qreal>(size.height()) / imageSize.height()));
+        }
+        if (factor > 0 && factor < 1) {
+            reader.setScaledSize(QSize(qCeil(imageSize.width() * factor), qCeil(imageSize.height() * factor)));
+        }
+    }
+
+    return reader.read();
+}
+
+/**
+ * @brief 按屏幕尺寸缩放并居中裁剪壁纸
+ */
+static QImage scaleImage(const QImage &image, const QSize &size)
+{
+    if (image.isNull())
+        return QImage();
+
+    const QImage scaled = image.scaled(size, Qt::KeepAspectRatioByExpanding, Qt::FastTransformation);
+    return scaled.copy(QRect((scaled.width() - size.width()) / 2,
+                             (scaled.height() - size.height()) / 2,
+                             size.width(),
+                             size.height()));
+}
+
+/**
+ * @brief 生成屏幕尺寸的壁纸，需要时再模糊
+ */
+static QImage processImage(const QImage &image, const QSize &size, bool blur)
+{
+    const QImage scaled = scaleImage(image, size);
+    return blur ? ImageBlur::blur(scaled) : scaled;
+}
+
 QString FullscreenBackground::backgroundPath;
 QString FullscreenBackground::blurBackgroundPath;
 
@@ -80,6 +143,10 @@ FullscreenBackground::FullscreenBackground(SessionBaseModel *model, QWidget *par
 
     m_blackWidget->setBlackMode(m_model->isBlackMode());
     connect(m_model, &SessionBaseModel::blackModeChanged, m_blackWidget, &BlackWidget::setBlackMode);
+    connect(m_model, &SessionBaseModel::blackModeChanged, this, [this](bool isBlack) {
+        if (isBlack)
+            finishFadeOutAnimation();
+    });
 }
 
 FullscreenBackground::~FullscreenBackground()
@@ -96,7 +163,7 @@ void FullscreenBackground::updateBackground(const QString &path)
         // 动画播放完毕不再需要清晰的背景图片
         if (!m_fadeOutAniFinished && !(backgroundPath == path && contains(PIXMAP_TYPE_BACKGROUND))) {
             backgroundPath = path;
-            addPixmap(pixmapHandle(QPixmap(path)), PIXMAP_TYPE_BACKGROUND);
+            requestPixmap(PIXMAP_TYPE_BACKGROUND);
         }
 
         // 需要播放动画的时候才更新模糊壁纸
@@ -107,9 +174,19 @@ void FullscreenBackground::updateBackground(const QString &path)
 
 void FullscreenBackground::updateBlurBackground(const QString &path)
 {
+    // ImageEffect1 第一次生成模糊壁纸可能需要几秒，超时后先在本地模糊清晰的壁纸，服务返回后再替换
+    QSharedPointer<bool> replied(new bool(false));
+    QTimer::singleShot(BLUR_SERVICE_TIMEOUT, this, [this, path, replied] {
+        if (!*replied) {
+            qInfo() << "Get blur background timeout, blur the background locally";
+            useLocalBlurBackground(path);
+        }
+    });
+
     QDBusPendingCall async = m_imageEffectInter->Get("", path);
     QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(async, this);
-    connect(watcher, &QDBusPendingCallWatcher::finished, this, [this] (QDBusPendingCallWatcher *call) {
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [this, path, replied] (QDBusPendingCallWatcher *call) {
+        *replied = true;
         const QDBusPendingReply<QString> reply = *call;
         if (!reply.isError()) {
             QString blurPath = reply.value();
@@ -118,26 +195,72 @@ void FullscreenBackground::updateBlurBackground(const QString &path)
                 blurPath = "/usr/share/backgrounds/default_background.jpg";
             }
 
-            if (blurBackgroundPath != blurPath || !contains(PIXMAP_TYPE_BLUR_BACKGROUND)) {
+            if (blurBackgroundPath != blurPath || localBlurBackground || !contains(PIXMAP_TYPE_BLUR_BACKGROUND)) {
                 blurBackgroundPath = blurPath;
-                addPixmap(pixmapHandle(QPixmap(blurPath)), PIXMAP_TYPE_BLUR_BACKGROUND);
+                localBlurBackground = false;
+                // 模糊壁纸加载完成后再播放动画
+                requestPixmap(PIXMAP_TYPE_BLUR_BACKGROUND);
+            } else {
+                startFadeOutAnimation();
             }
-
-            // 只播放一次动画，后续背景图片变更直接更新模糊壁纸即可
-            if (m_fadeOutAni && !m_fadeOutAniFinished)
-                m_fadeOutAni->start();
-            else
-                update();
         } else {
             qWarning() << "get blur background image error: " << reply.error().message();
+            useLocalBlurBackground(path);
         }
         call->deleteLater();
     }, Qt::QueuedConnection);
 }
 
+/**
+ * @brief FullscreenBackground::useLocalBlurBackground
+ * 使用本地模糊的壁纸作为临时的模糊壁纸
+ * @param path 清晰壁纸路径
+ */
+void FullscreenBackground::useLocalBlurBackground(const QString &path)
+{
+    // 已经有模糊壁纸并且不需要播放动画时，等待服务返回即可
+    if (m_fadeOutAniFinished && contains(PIXMAP_TYPE_BLUR_BACKGROUND))
+        return;
+
+    if (localBlurBackground && blurBackgroundPath == path)
+        return;
+
+    blurBackgroundPath = path;
+    localBlurBackground = true;
+    requestPixmap(PIXMAP_TYPE_BLUR_BACKGROUND);
+}
+
+/**
+ * @brief FullscreenBackground::startFadeOutAnimation
+ * 只播放一次动画，后续背景图片变更直接更新模糊壁纸即可
+ */
+void FullscreenBackground::startFadeOutAnimation()
+{
+    if (m_fadeOutAni && !m_fadeOutAniFinished) {
+        // 窗口不可见或者待机黑屏时看不到动画，直接显示动画结束时的状态
+        if (!isVisible() || m_model->isBlackMode()) {
+            m_fadeOutAni->setCurrentTime(m_fadeOutAni->duration());
+        } else if (m_fadeOutAni->state() != QAbstractAnimation::Running) {
+            m_fadeOutAni->start();
+        }
+    } else {
+        update();
+    }
+}
+
+/**
+ * @brief FullscreenBackground::finishFadeOutAnimation
+ * 动画播放过程中窗口被隐藏或者进入待机黑屏时，直接结束动画，避免每一帧都重绘
+ */
+void FullscreenBackground::finishFadeOutAnimation()
+{
+    if (m_fadeOutAni && m_fadeOutAni->state() == QAbstractAnimation::Running)
+        m_fadeOutAni->setCurrentTime(m_fadeOutAni->duration());
+}
+
 bool FullscreenBackground::contentVisible() const
 {
-    return m_content && m_content->isVisible();
+    return m_content && m_content->parentWidget() == this && m_content->isVisible();
 }
 
 void FullscreenBackground::setEnterEnable(bool enable)
@@ -154,9 +277,8 @@ void FullscreenBackground::setScreen(QPointer<QScreen> screen, bool isVisible)
             << screen->geometry() << " lockframe:" << this;
     QScreen *primary_screen = QGuiApplication::primaryScreen();
     if (primary_screen == screen && isVisible) {
-        m_content->show();
+        setContentVisible(true);
         m_primaryShowFinished = true;
-        emit contentVisibleChanged(true);
     } else {
         QTimer::singleShot(1000, this, [ = ] {
             m_primaryShowFinished = true;
@@ -178,16 +300,34 @@ void FullscreenBackground::setContentVisible(bool visible)
     if (!isVisible() && !visible)
         return;
 
+    // 多个屏幕共用同一个内容时，显示之前先把内容移动到当前屏幕
+    if (visible && m_content->parentWidget() != this)
+        attachContent();
+
     m_content->setVisible(visible);
 
     emit contentVisibleChanged(visible);
 }
 
+/**
+ * @brief 设置显示的内容
+ * 内容可以被多个屏幕共用，正在其它屏幕上显示时不移动，等到在当前屏幕显示时再移动过来
+ */
 void FullscreenBackground::setContent(QWidget *const w)
 {
     m_content = w;
-    m_content->setParent(this);
+    if (m_content->parentWidget() != this && m_content->isVisible())
+        return;
+
+    attachContent();
+}
+
+void FullscreenBackground::attachContent()
+{
+    if (m_content->parentWidget() != this)
+        m_content->setParent(this);
     m_content->move(0, 0);
+    m_content->resize(size());
     m_content->setFocus();
     setFocusProxy(m_content);
     // 如果是黑屏状态则不置顶
@@ -198,8 +338,7 @@ void FullscreenBackground::setContent(QWidget *const w)
 void FullscreenBackground::setIsHibernateMode()
 {
     updateGeometry();
-    m_content->show();
-    emit contentVisibleChanged(true);
+    setContentVisible(true);
 }
 
 bool FullscreenBackground::isPicture(const QString &file)
@@ -224,7 +363,8 @@ void FullscreenBackground::paintEvent(QPaintEvent *e)
     const QPixmap &blurBackground = getPixmap(PIXMAP_TYPE_BLUR_BACKGROUND);
 
     const QRect trueRect(QPoint(0, 0), QSize(size() * devicePixelRatioF()));
-    if (m_useSolidBackground) {
+    if (m_useSolidBackground || (background.isNull() && blurBackground.isNull())) {
+        // 壁纸还在后台解码时先绘制纯色背景
         painter.fillRect(trueRect, QColor(DDESESSIONCC::SOLID_BACKGROUND_COLOR));
     } else {
         if (m_fadeOutAni) {
@@ -266,7 +406,7 @@ void FullscreenBackground::tryActiveWindow(int count/* = 9*/)
 
     activateWindow();
 
-    if (m_content && !m_content->isVisible()) {
+    if (m_content && !contentVisible()) {
         qDebug() << "hide..." << count;
         return;
     }
@@ -275,13 +415,11 @@ void FullscreenBackground::tryActiveWindow(int count/* = 9*/)
 
 void FullscreenBackground::enterEvent(QEvent *event)
 {
-    if (m_primaryShowFinished && m_enableEnterEvent && m_model->visible()) {
-        m_content->show();
-        emit contentVisibleChanged(true);
-    }
+    if (m_primaryShowFinished && m_enableEnterEvent && m_model->visible())
+        setContentVisible(true);
 
     // 锁屏截图之后 activewindow 不是锁屏了，此时发现不是 activewindow 主动尝试激活
-    if (!isActiveWindow() && m_content && m_content->isVisible())
+    if (!isActiveWindow() && contentVisible())
          tryActiveWindow();
 
     return QWidget::enterEvent(event);
@@ -295,11 +433,12 @@ void FullscreenBackground::leaveEvent(QEvent *event)
 void FullscreenBackground::resizeEvent(QResizeEvent *event)
 {
     m_blackWidget->resize(size());
-    m_content->resize(size());
-    if (isPicture(backgroundPath) && !contains(PIXMAP_TYPE_BACKGROUND))
-        addPixmap(pixmapHandle(QPixmap(backgroundPath)), PIXMAP_TYPE_BACKGROUND);
-    if (isPicture(blurBackgroundPath) && !contains(PIXMAP_TYPE_BLUR_BACKGROUND))
-        addPixmap(pixmapHandle(QPixmap(blurBackgroundPath)), PIXMAP_TYPE_BLUR_BACKGROUND);
+    if (m_content && m_content->parentWidget() == this)
+        m_content->resize(size());
+    if (!contains(PIXMAP_TYPE_BACKGROUND))
+        requestPixmap(PIXMAP_TYPE_BACKGROUND);
+    if (!contains(PIXMAP_TYPE_BLUR_BACKGROUND))
+        requestPixmap(PIXMAP_TYPE_BLUR_BACKGROUND);
 
     updatePixmap();
     QWidget::resizeEvent(event);
@@ -312,10 +451,8 @@ void FullscreenBackground::resizeEvent(QResizeEvent *event)
  */
 void FullscreenBackground::mouseMoveEvent(QMouseEvent *event)
 {
-    if (m_model->visible()) {
-        m_content->show();
-        emit contentVisibleChanged(true);
-    }
+    if (m_model->visible())
+        setContentVisible(true);
 
     QWidget::mouseMoveEvent(event);
 }
@@ -347,30 +484,14 @@ void FullscreenBackground::showEvent(QShowEvent *event)
 
 void FullscreenBackground::hideEvent(QHideEvent *event)
 {
+    finishFadeOutAnimation();
+
     if (m_model->isUseWayland()) {
         Q_EMIT requestDisableGlobalShortcutsForWayland(false);
     }
     QWidget::hideEvent(event);
 }
 
-const QPixmap FullscreenBackground::pixmapHandle(const QPixmap &pixmap)
-{
-    const QSize trueSize {size() * devicePixelRatioF()};
-    QPixmap pix;
-    if (!pixmap.isNull())
-        pix = pixmap.scaled(trueSize, Qt::KeepAspectRatioByExpanding, Qt::FastTransformation);
-
-    pix = pix.copy(QRect((pix.width() - trueSize.width()) / 2,
-                         (pix.height() - trueSize.height()) / 2,
-                         trueSize.width(),
-                         trueSize.height()));
-
-    // draw pix to widget, so pix need set pixel ratio from qwidget devicepixelratioF
-    pix.setDevicePixelRatio(devicePixelRatioF());
-
-    return pix;
-}
-
 void FullscreenBackground::updateScreen(QScreen *screen)
 {
     if (screen == m_screen)
@@ -405,7 +526,7 @@ bool FullscreenBackground::event(QEvent *e)
 {
 #ifndef QT_DEBUG
     if (e->type() == QEvent::WindowDeactivate) {
-        if (m_content->isVisible()) {
+        if (contentVisible()) {
             tryActiveWindow();
         }
     }
@@ -486,6 +607,142 @@ void FullscreenBackground::updatePixmap()
     updateFunc(blurBackgroundCacheList);
 }
 
+/**
+ * @brief FullscreenBackground::requestPixmap
+ * 请求加载壁纸，同一轮事件循环中所有屏幕的请求合并成一次解码
+ * @param type 清晰壁纸还是模糊壁纸
+ */
+void FullscreenBackground::requestPixmap(const int type)
+{
+    if (pixmapRequested[type])
+        return;
+
+    pixmapRequested[type] = true;
+    QTimer::singleShot(0, qApp, [type] {
+        loadPixmap(type);
+    });
+}
+
+/**
+ * @brief FullscreenBackground::loadPixmap
+ * 在线程池中解码壁纸，每个图片只解码一次，再并行生成各个屏幕尺寸的壁纸，完成后回到主线程更新缓存
+ * @param type 清晰壁纸还是模糊壁纸
+ */
+void FullscreenBackground::loadPixmap(const int type)
+{
+    pixmapRequested[type] = false;
+
+    // 本地模糊的壁纸和服务生成的模糊壁纸分开标记，服务返回后需要替换
+    auto currentKey = [type] {
+        if (PIXMAP_TYPE_BACKGROUND == type)
+            return backgroundPath;
+        return localBlurBackground ? "local-blur:" + blurBackgroundPath : blurBackgroundPath;
+    };
+    const QString path = (PIXMAP_TYPE_BACKGROUND == type) ? backgroundPath : blurBackgroundPath;
+    const QString key = currentKey();
+    const bool localBlur = (PIXMAP_TYPE_BLUR_BACKGROUND == type) && localBlurBackground;
+    if (path.isEmpty() || !isPicture(path))
+        return;
+
+    // 只处理缓存中还没有的尺寸，图片变化时所有尺寸都需要重新生成
+    QList<QSize> sizes;
+    for (FullscreenBackground *frame : qAsConst(frameList)) {
+        const QSize size = frame->trueSize();
+        if (size.isEmpty() || sizes.contains(size))
+            continue;
+        if (pixmapCachedPath[type] == key && frame->contains(type))
+            continue;
+        sizes.append(size);
+    }
+
+    // 磁盘上有缓存的尺寸直接使用，不需要解码原图
+    for (auto it = sizes.begin(); !localBlur && it != sizes.end();) {
+        const QImage image = WallpaperCache::load(path, *it);
+        if (image.isNull()) {
+            ++it;
+            continue;
+        }
+        pixmapCachedPath[type] = key;
+        publishPixmap(type, *it, image);
+        it = sizes.erase(it);
+    }
+    if (sizes.isEmpty())
+        return;
+
+    // 本地模糊时优先使用已经生成的清晰壁纸，不再解码原图
+    ScaledImageList sources;
+    if (localBlur && pixmapCachedPath[PIXMAP_TYPE_BACKGROUND] == path) {
+        for (const auto &pair : qAsConst(backgroundCacheList)) {
+            if (sizes.contains(pair.first) && !pair.second.isNull())
+                sources.append(qMakePair(pair.first, pair.second.toImage()));
+        }
+    }
+
+    auto watcher = new QFutureWatcher<ScaledImageList>(qApp);
+    QObject::connect(watcher, &QFutureWatcher<ScaledImageList>::finished, qApp, [watcher, type, key, currentKey] {
+        watcher->deleteLater();
+
+        // 处理期间壁纸已经变化，丢弃旧的结果
+        if (key != currentKey())
+            return;
+
+        pixmapCachedPath[type] = key;
+        const ScaledImageList images = watcher->result();
+        for (const auto &pair : images)
+            publishPixmap(type, pair.first, pair.second);
+    });
+    watcher->setFuture(QtConcurrent::run([path, sizes, sources, localBlur] {
+        QImage image;
+        QList<QFuture<QImage>> futures;
+        for (const QSize &size : sizes) {
+            auto source = std::find_if(sources.begin(), sources.end(), [size](const QPair<QSize, QImage> &pair) {
+                return pair.first == size;
+            });
+            if (source != sources.end()) {
+                futures.append(QtConcurrent::run(processImage, source->second, size, localBlur));
+                continue;
+            }
+            // 原图只解码一次
+            if (image.isNull())
+                image = decodeImage(path, sizes);
+            futures.append(QtConcurrent::run(processImage, image, size, localBlur));
+        }
+
+        ScaledImageList images;
+        for (int i = 0; i < sizes.size(); ++i) {
+            const QImage scaled = futures.at(i).result();
+            if (!localBlur)
+                WallpaperCache::save(path, sizes.at(i), scaled);
+            images.append(qMakePair(sizes.at(i), scaled));
+        }
+        return images;
+    }));
+}
+
+/**
+ * @brief FullscreenBackground::publishPixmap
+ * 把指定尺寸的壁纸加入缓存，并刷新使用这个尺寸的屏幕
+ * @param type 清晰壁纸还是模糊壁纸
+ * @param size 屏幕物理像素尺寸
+ * @param image 缩放后的壁纸
+ */
+void FullscreenBackground::publishPixmap(const int type, const QSize &size, const QImage &image)
+{
+    for (FullscreenBackground *frame : qAsConst(frameList)) {
+        if (frame->trueSize() != size)
+            continue;
+
+        // draw pix to widget, so pix need set pixel ratio from qwidget devicepixelratioF
+        QPixmap pixmap = QPixmap::fromImage(image);
+        pixmap.setDevicePixelRatio(frame->devicePixelRatioF());
+        frame->addPixmap(pixmap, type);
+        if (PIXMAP_TYPE_BLUR_BACKGROUND == type)
+            frame->startFadeOutAnimation();
+        else
+            frame->update();
+    }
+}
+
 bool FullscreenBackground::contains(int type)
 {
     auto containsFunc = [this](QList<QPair<QSize, QPixmap>> &list) -> bool {
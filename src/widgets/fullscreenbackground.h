@@ -53,17 +53,23 @@ private:
     void enterEvent(QEvent *event) Q_DECL_OVERRIDE;
     void leaveEvent(QEvent *event) Q_DECL_OVERRIDE;
     void mouseMoveEvent(QMouseEvent *event) Q_DECL_OVERRIDE;
-    const QPixmap pixmapHandle(const QPixmap &pixmap);
     void updateScreen(QScreen *screen);
     void updateGeometry();
-    bool isPicture(const QString &file);
+    void attachContent();
+    static bool isPicture(const QString &file);
     QString getLocalFile(const QString &file);
     const QPixmap& getPixmap(int type);
     QSize trueSize() const;
     void addPixmap(const QPixmap &pixmap, const int type);
     static void updatePixmap();
+    static void requestPixmap(const int type);
+    static void loadPixmap(const int type);
+    static void publishPixmap(const int type, const QSize &size, const QImage &image);
     bool contains(int type);
     void tryActiveWindow(int count = 9);
+    void startFadeOutAnimation();
+    void finishFadeOutAnimation();
+    void useLocalBlurBackground(const QString &path);
 
 private:
     static QString backgroundPath;                             // 高清背景图片路径
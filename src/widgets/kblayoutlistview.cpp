@@ -12,7 +12,6 @@ const int ITEM_SPACING = 2;
 
 KBLayoutListView::KBLayoutListView(const QString &language, QWidget *parent)
     : DListView(parent)
-    , m_xkbParse(new XkbParser(this))
     , m_buttonModel(new QStandardItemModel(this))
     , m_curLanguage(language)
     , m_clickState(false)
@@ -30,14 +29,15 @@ void KBLayoutListView::initData(const QStringList &buttons)
         return;
 
     m_buttons = buttons;
-    m_kbdParseList = m_xkbParse->lookUpKeyboardList(m_buttons);
+    m_kbdParseList = XkbParser::instance()->lookUpKeyboardList(m_buttons);
 
     if (m_kbdParseList.isEmpty())
         m_kbdParseList = buttons;
 
     // 获取当前输入法名称-全名,而不是简写的英文字符串
-    if (!m_xkbParse->lookUpKeyboardList(QStringList(m_curLanguage)).isEmpty())
-        m_curLanguage = m_xkbParse->lookUpKeyboardList(QStringList(m_curLanguage)).at(0);
+    const QStringList currentLanguage = XkbParser::instance()->lookUpKeyboardList(QStringList(m_curLanguage));
+    if (!currentLanguage.isEmpty())
+        m_curLanguage = currentLanguage.at(0);
 
     m_buttonModel->clear();
 
@@ -96,8 +96,9 @@ void KBLayoutListView::updateSelectState(const QString &name)
  */
 void KBLayoutListView::updateList(const QString &str)
 {
-    if (!m_xkbParse->lookUpKeyboardList(QStringList(str)).isEmpty())
-        m_curLanguage = m_xkbParse->lookUpKeyboardList(QStringList(str)).at(0);
+    const QStringList language = XkbParser::instance()->lookUpKeyboardList(QStringList(str));
+    if (!language.isEmpty())
+        m_curLanguage = language.at(0);
 
     m_clickState = false;
     updateSelectState(m_curLanguage);
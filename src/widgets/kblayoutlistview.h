@@ -37,7 +37,6 @@ private:
 
 private:
     QStringList m_buttons;
-    XkbParser *m_xkbParse;
     QStringList m_kbdParseList;
 
     QStandardItemModel *m_buttonModel;
@@ -0,0 +1,119 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "spritecache.h"
+
+#include <QDebug>
+#include <QImageReader>
+#include <QPainter>
+#include <QtConcurrent>
+
+static QString spriteKey(const QString &pattern, int frameCount, qreal ratio)
+{
+    return QString("%1\n%2\n%3").arg(pattern).arg(frameCount).arg(ratio);
+}
+
+/**
+ * @brief 获取一帧，超出范围时返回空图片
+ *
+ * @param index 帧序号，从 0 开始
+ */
+QPixmap SpriteCache::Sprite::frame(int index) const
+{
+    return frames.value(index);
+}
+
+SpriteCache *SpriteCache::instance()
+{
+    static SpriteCache spriteCache;
+    return &spriteCache;
+}
+
+/**
+ * @brief 在线程池中提前光栅化，第一次获取时还没有完成会等待结果
+ *
+ * @param pattern 帧文件路径，%1 为帧编号，从 1 开始
+ * @param frameCount 帧数
+ * @param ratio 设备缩放比例
+ */
+void SpriteCache::preload(const QString &pattern, int frameCount, qreal ratio)
+{
+    const QString key = spriteKey(pattern, frameCount, ratio);
+    if (m_sprites.contains(key) || m_pending.contains(key))
+        return;
+
+    m_pending.insert(key, QtConcurrent::run(&SpriteCache::render, pattern, frameCount, ratio));
+}
+
+/**
+ * @brief 获取动画帧，缓存中没有时同步光栅化
+ */
+SpriteCache::Sprite SpriteCache::sprite(const QString &pattern, int frameCount, qreal ratio)
+{
+    const QString key = spriteKey(pattern, frameCount, ratio);
+    auto it = m_sprites.constFind(key);
+    if (it != m_sprites.constEnd())
+        return it.value();
+
+    const QImage image = m_pending.contains(key) ? m_pending.take(key).result() : render(pattern, frameCount, ratio);
+
+    Sprite sprite;
+    if (!image.isNull() && frameCount > 0) {
+        sprite.frameSize = QSize(image.width() / frameCount, image.height());
+        sprite.frameCount = frameCount;
+        sprite.frames.reserve(frameCount);
+        for (int i = 0; i < frameCount; ++i) {
+            QPixmap frame = QPixmap::fromImage(image.copy(i * sprite.frameSize.width(), 0,
+                                                          sprite.frameSize.width(), sprite.frameSize.height()));
+            frame.setDevicePixelRatio(ratio);
+            sprite.frames.append(frame);
+        }
+    }
+
+    m_sprites.insert(key, sprite);
+    return sprite;
+}
+
+void SpriteCache::clear()
+{
+    for (auto &future : m_pending)
+        future.waitForFinished();
+    m_pending.clear();
+    m_sprites.clear();
+}
+
+/**
+ * @brief 按 svg 的默认尺寸和缩放比例光栅化所有帧，横向排列到一张图中
+ * 所有帧使用第一帧的尺寸，读取失败的帧留空。
+ */
+QImage SpriteCache::render(const QString &pattern, int frameCount, qreal ratio)
+{
+    QSize frameSize;
+    QImage atlas;
+    for (int i = 0; i < frameCount; ++i) {
+        QImageReader reader(pattern.arg(i + 1));
+        if (frameSize.isEmpty()) {
+            frameSize = reader.size() * ratio;
+            if (frameSize.isEmpty()) {
+                qWarning() << "Failed to read sprite frame:" << reader.fileName() << reader.errorString();
+                return QImage();
+            }
+            atlas = QImage(frameSize.width() * frameCount, frameSize.height(), QImage::Format_ARGB32_Premultiplied);
+            atlas.fill(Qt::transparent);
+        }
+
+        reader.setScaledSize(frameSize);
+        const QImage image = reader.read();
+        if (image.isNull()) {
+            qWarning() << "Failed to read sprite frame:" << reader.fileName() << reader.errorString();
+            continue;
+        }
+
+        QPainter painter(&atlas);
+        painter.setCompositionMode(QPainter::CompositionMode_Source);
+        painter.drawImage(i * frameSize.width(), 0, image);
+    }
+
+    return atlas;
+}
@@ -0,0 +1,47 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef SPRITECACHE_H
+#define SPRITECACHE_H
+
+#include <QFuture>
+#include <QHash>
+#include <QImage>
+#include <QPixmap>
+#include <QVector>
+
+/**
+ * @brief 动画帧缓存
+ * 把一组 svg 动画帧按缩放比例光栅化到一张横向排列的图集中，进程内共用。
+ * 图集生成后一次性拆分成每帧的图片，播放时按序号直接取用，不再每帧解析、光栅化 svg。
+ * 可以调用 preload 提前在线程池中光栅化，只在界面线程使用。
+ */
+class SpriteCache
+{
+public:
+    struct Sprite {
+        QVector<QPixmap> frames;
+        QSize frameSize;    // 单帧的像素尺寸
+        int frameCount = 0;
+
+        QPixmap frame(int index) const;
+    };
+
+    static SpriteCache *instance();
+
+    void preload(const QString &pattern, int frameCount, qreal ratio);
+    Sprite sprite(const QString &pattern, int frameCount, qreal ratio);
+    void clear();
+
+    static QImage render(const QString &pattern, int frameCount, qreal ratio);
+
+private:
+    SpriteCache() = default;
+
+private:
+    QHash<QString, Sprite> m_sprites;
+    QHash<QString, QFuture<QImage>> m_pending;
+};
+
+#endif // SPRITECACHE_H
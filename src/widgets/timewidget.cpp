@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "timewidget.h"
+#include "timerscheduler.h"
 
 #include <QVBoxLayout>
 #include <QDateTime>
@@ -41,8 +42,9 @@ TimeWidget::TimeWidget(QWidget *parent)
     refreshTime();
 
     m_refreshTimer = new QTimer(this);
-    m_refreshTimer->setInterval(1000);
-    m_refreshTimer->start();
+    m_refreshTimer->setSingleShot(true);
+    m_refreshTimer->setTimerType(Qt::PreciseTimer);
+    scheduleRefresh();
 
     QVBoxLayout *vLayout = new QVBoxLayout;
     vLayout->addWidget(m_timeLabel);
@@ -52,7 +54,10 @@ TimeWidget::TimeWidget(QWidget *parent)
 
     setLayout(vLayout);
 
-    connect(m_refreshTimer, &QTimer::timeout, this, &TimeWidget::refreshTime);
+    connect(m_refreshTimer, &QTimer::timeout, this, [this] {
+        refreshTime();
+        scheduleRefresh();
+    });
 }
 
 void TimeWidget::set24HourFormat(bool use24HourFormat)
@@ -69,6 +74,7 @@ void TimeWidget::updateLocale(const QLocale &locale, const QString &shortTimeFor
     if (!longDateFormat.isEmpty())
         m_longDateFormat = longDateFormat;
     refreshTime();
+    scheduleRefresh();
 }
 
 void TimeWidget::refreshTime()
@@ -88,6 +94,18 @@ void TimeWidget::refreshTime()
     }
 }
 
+/**
+ * @brief TimeWidget::scheduleRefresh 在下一个整分钟（显示秒时为整秒）刷新时间
+ * 控件不可见或者待机黑屏时暂停刷新，恢复时立即刷新
+ */
+void TimeWidget::scheduleRefresh()
+{
+    const bool showSeconds = !m_shortTimeFormat.isEmpty() && !m_longDateFormat.isEmpty() && m_shortTimeFormat.contains('s');
+    const qint64 period = showSeconds ? 1000 : 60 * 1000;
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    TimerScheduler::instance()->start(m_refreshTimer, this, static_cast<int>(period - now % period));
+}
+
 /**
  * @brief TimeWidget::setWeekdayFormatType 根据类型来设置周显示格式
  * @param type 自定义类型
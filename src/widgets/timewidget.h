@@ -29,6 +29,7 @@ public Q_SLOTS:
 
 private:
     void refreshTime();
+    void scheduleRefresh();
 
 private:
     QLabel *m_timeLabel;
@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "useravatar.h"
+#include "avatarcache.h"
 #include "dthememanager.h"
 #include <QUrl>
 #include <QFile>
@@ -13,6 +14,7 @@
 UserAvatar::UserAvatar(QWidget *parent)
     : QPushButton(parent)
     , m_iconLabel(new QLabel(this))
+    , m_sourceRatio(0)
     , m_borderColor(Qt::white)
     , m_avatarSize(90)
     , m_borderWidth(0)
@@ -30,16 +32,70 @@ UserAvatar::UserAvatar(QWidget *parent)
     m_iconLabel->setAccessibleName("UserAvatar");
 
     mainLayout->addWidget(m_iconLabel, 0, Qt::AlignCenter);
+
+    connect(AvatarCache::instance(), &AvatarCache::pixmapReady, this, [this](const QString &path) {
+        if (path == m_sourcePath)
+            update();
+    });
 }
 
 void UserAvatar::setIcon(const QString &iconPath)
 {
+    const QString oldIconPath = m_iconPath;
     QUrl url(iconPath);
     if (url.isLocalFile()) {
         m_iconPath = url.path();
     } else {
         m_iconPath = iconPath;
     }
+
+    if (m_iconPath == oldIconPath)
+        return;
+
+    // 头像变化时重新读取文件，文件可能被覆盖过，只清除这个控件使用的缓存
+    m_sourceRatio = 0;
+    if (!oldIconPath.isEmpty()) {
+        updateSourcePath();
+        AvatarCache::instance()->invalidate(m_sourcePath, QSize(m_avatarSize, m_avatarSize), devicePixelRatioF(),
+                                            AVATAR_ROUND_RADIUS, !isEnabled());
+    }
+    update();
+}
+
+/**
+ * @brief 头像文件被原地覆盖时路径不变，清除这个文件所有尺寸的缓存后重新读取
+ */
+void UserAvatar::reloadIcon()
+{
+    if (m_iconPath.isEmpty())
+        return;
+
+    const QString sourcePath = m_sourcePath;
+    m_sourceRatio = 0;
+    updateSourcePath();
+    AvatarCache::instance()->invalidate(m_iconPath);
+    if (!sourcePath.isEmpty() && sourcePath != m_iconPath)
+        AvatarCache::instance()->invalidate(sourcePath);
+    if (m_sourcePath != m_iconPath && m_sourcePath != sourcePath)
+        AvatarCache::instance()->invalidate(m_sourcePath);
+    update();
+}
+
+/**
+ * @brief 高分屏优先使用大尺寸的头像，只在头像或缩放比例变化时检查文件
+ */
+void UserAvatar::updateSourcePath()
+{
+    const qreal ratio = devicePixelRatioF();
+    if (qFuzzyCompare(ratio, m_sourceRatio))
+        return;
+
+    m_sourceRatio = ratio;
+    m_sourcePath = m_iconPath;
+    if (ratio > 1.0)
+        m_sourcePath.replace("icons/", "icons/bigger/");
+    if (!QFile(m_sourcePath).exists())
+        m_sourcePath = m_iconPath;
 }
 
 void UserAvatar::paintEvent(QPaintEvent *)
@@ -51,19 +107,15 @@ void UserAvatar::paintEvent(QPaintEvent *)
 
     painter.setRenderHint(QPainter::Antialiasing);
     painter.setRenderHint(QPainter::SmoothPixmapTransform);
-    painter.setClipPath(path);
-
-    const auto ratio = devicePixelRatioF();
-    QString imgPath = m_iconPath;
-    if (ratio > 1.0)
-        imgPath.replace("icons/", "icons/bigger/");
-    if (!QFile(imgPath).exists())
-        imgPath = m_iconPath;
 
-    QImage tmpImg(imgPath);
-
-    painter.drawImage(roundedRect, this->isEnabled() ? tmpImg : imageToGray(tmpImg));
+    // 缓存的头像已经裁剪成圆角，还没有生成时先只绘制边框
+    updateSourcePath();
+    const QPixmap avatar = AvatarCache::instance()->pixmap(m_sourcePath, roundedRect.size(), devicePixelRatioF(),
+                                                           AVATAR_ROUND_RADIUS, !isEnabled());
+    if (!avatar.isNull())
+        painter.drawPixmap(roundedRect, avatar);
 
+    painter.setClipPath(path);
     QColor penColor = m_selected ? m_borderSelectedColor : m_borderColor;
 
     if (m_borderWidth) {
@@ -76,41 +128,6 @@ void UserAvatar::paintEvent(QPaintEvent *)
     }
 }
 
-QImage UserAvatar::imageToGray(const QImage &image)
-{
-    int height = image.height();
-    int width = image.width();
-    QImage targetImg(width, height, QImage::Format_Indexed8);
-    targetImg.setColorCount(256);
-    for(int i = 0; i < 256; i++)
-        targetImg.setColor(i, qRgb(i, i, i));
-
-    switch (image.format()) {
-    case QImage::Format_Indexed8:
-        for (int i = 0; i < height; i++) {
-            const uchar *pSrc = static_cast<const uchar *>(image.constScanLine(i));
-            uchar *pDest = static_cast<uchar *>(targetImg.scanLine(i));
-            memcpy(pDest, pSrc, static_cast<size_t>(width));
-        }
-        break;
-    case QImage::Format_RGB32:
-    case QImage::Format_ARGB32:
-    case QImage::Format_ARGB32_Premultiplied:
-        for (int i = 0; i < height; i++) {
-            const QRgb *pSrc = reinterpret_cast<const QRgb *>(image.constScanLine(i));
-            uchar *pDest = targetImg.scanLine(i);
-
-            for (int j = 0; j < width; j++) {
-                pDest[j] = static_cast<uchar>(qGray(pSrc[j]));
-            }
-        }
-        break;
-    default:
-        break;
-    }
-    return targetImg;
-}
-
 void UserAvatar::setAvatarSize(const int size)
 {
     if (size == m_avatarSize)
@@ -33,6 +33,7 @@ public:
 
     explicit UserAvatar(QWidget *parent = nullptr);
     void setIcon(const QString &iconPath);
+    void reloadIcon();
     void setAvatarSize(const int size);
     void setDisabled(bool disable);
 
@@ -60,11 +61,13 @@ protected:
     void paintEvent(QPaintEvent *) override;
 
 private:
-    QImage imageToGray(const QImage &image);
+    void updateSourcePath();
 
 private:
     QLabel *m_iconLabel;
     QString m_iconPath;
+    QString m_sourcePath;       // 根据缩放比例实际使用的头像文件
+    qreal m_sourceRatio;
     QColor m_borderColor;
     QColor m_borderSelectedColor;
     int m_avatarSize;
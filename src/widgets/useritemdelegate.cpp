@@ -3,10 +3,10 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "useritemdelegate.h"
+#include "avatarcache.h"
 
 #include <DFontSizeManager>
 
-#include <QFile>
 #include <QPainter>
 #include <QBitmap>
 #include <QPainterPath>
@@ -82,7 +82,7 @@ QSize UserItemDelegate::sizeHint(const QStyleOptionViewItem &option, const QMode
 
 void UserItemDelegate::drawRoundImage(QPainter *thisPainter, const QRect &rect, const QString &path) const
 {
-    if (path.isEmpty() || !QFile::exists(path))
+    if (path.isEmpty())
         return;
 
     // 设计图上常量
@@ -92,13 +92,13 @@ void UserItemDelegate::drawRoundImage(QPainter *thisPainter, const QRect &rect,
 
     QRect drawRect = QRect(rect.left() + marginLeft, rect.top() + margTop,
                            IMAGE_SIZE.width(), IMAGE_SIZE.height());
-    QPainterPath clipPath;
-    clipPath.addRoundedRect(drawRect, imageRadius, imageRadius);
+    // 缓存的头像已经裁剪成圆角，生成后列表会重新绘制
+    const QPixmap pixmap = AvatarCache::instance()->pixmap(path, IMAGE_SIZE, thisPainter->device()->devicePixelRatioF(), imageRadius);
+    if (pixmap.isNull())
+        return;
+
     thisPainter->save();
     thisPainter->setRenderHints(QPainter::Antialiasing | QPainter::SmoothPixmapTransform);
-    thisPainter->setClipPath(clipPath);
-    QPixmap pixmap(path);
-    pixmap = pixmap.scaled(IMAGE_SIZE);
     thisPainter->drawPixmap(drawRect, pixmap);
     thisPainter->restore();
 }
@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "userlistpopupwidget.h"
+#include "avatarcache.h"
 #include "sessionbasemodel.h"
 #include "useritemdelegate.h"
 
@@ -10,7 +11,9 @@
 
 #include <QMap>
 #include <QKeyEvent>
+#include <QScrollBar>
 #include <QStandardItem>
+#include <QTimer>
 
 DWIDGET_USE_NAMESPACE
 
@@ -26,6 +29,7 @@ UserListPopupWidget::UserListPopupWidget(const SessionBaseModel *model, QWidget
     , m_model(model)
     , m_userItemDelegate(new UserItemDelegate(this))
     , m_userItemModel(new QStandardItemModel(this))
+    , m_materializeTimer(new QTimer(this))
 {
     initUI();
     initConnections();
@@ -89,6 +93,7 @@ void UserListPopupWidget::keyPressEvent(QKeyEvent *event)
 void UserListPopupWidget::showEvent(QShowEvent *event)
 {
     setFocus();
+    m_materializeTimer->start();
 
     QWidget::showEvent(event);
 }
@@ -121,9 +126,10 @@ void UserListPopupWidget::addUser(const std::shared_ptr<User> &user)
 
     m_userItemMap[user->uid()] = item;
 
-    connect(user.get(), &User::avatarChanged, this, &UserListPopupWidget::userInfoChanged);
+    connect(user.get(), &User::avatarChanged, this, &UserListPopupWidget::onAvatarChanged);
     connect(user.get(), &User::displayNameChanged, this, &UserListPopupWidget::userInfoChanged);
     connect(user.get(), &User::loginStateChanged, this, &UserListPopupWidget::userInfoChanged);
+    connect(user.get(), &User::accountTypeChanged, this, &UserListPopupWidget::userInfoChanged);
 
     // 新增一个用户，可能改变整个view中item的宽度
     updateViewWidth();
@@ -136,9 +142,10 @@ void UserListPopupWidget::removeUser(const std::shared_ptr<User> &user)
     if (!user.get())
         return;
 
-    disconnect(user.get(), &User::avatarChanged, this, &UserListPopupWidget::userInfoChanged);
+    disconnect(user.get(), &User::avatarChanged, this, &UserListPopupWidget::onAvatarChanged);
     disconnect(user.get(), &User::displayNameChanged, this, &UserListPopupWidget::userInfoChanged);
     disconnect(user.get(), &User::loginStateChanged, this, &UserListPopupWidget::userInfoChanged);
+    disconnect(user.get(), &User::accountTypeChanged, this, &UserListPopupWidget::userInfoChanged);
 
     if (m_userItemMap.contains(user->uid()) && m_userItemMap[user->uid()]) {
         m_userItemModel->removeRow(m_userItemMap[user->uid()]->row());
@@ -204,6 +211,15 @@ void UserListPopupWidget::initConnections()
         qInfo() << "request switch user id:" << data.userId << " displayName:" << data.displayName;
         Q_EMIT requestSwitchToUser(m_model->findUserByUid(data.userId));
     });
+
+    // 只加载列表中可见用户的完整信息，滚动和增删用户合并到下一次事件循环处理
+    m_materializeTimer->setSingleShot(true);
+    m_materializeTimer->setInterval(0);
+    connect(m_materializeTimer, &QTimer::timeout, this, &UserListPopupWidget::materializeVisibleUsers);
+    // 头像在后台生成完成后刷新列表
+    connect(AvatarCache::instance(), &AvatarCache::pixmapReady, viewport(), static_cast<void (QWidget::*)()>(&QWidget::update));
+    connect(verticalScrollBar(), &QScrollBar::valueChanged, m_materializeTimer, static_cast<void (QTimer::*)()>(&QTimer::start));
+    connect(m_userItemModel, &QStandardItemModel::rowsInserted, m_materializeTimer, static_cast<void (QTimer::*)()>(&QTimer::start));
 }
 
 void UserListPopupWidget::loadUsers()
@@ -216,6 +232,26 @@ void UserListPopupWidget::loadUsers()
     }
 }
 
+void UserListPopupWidget::materializeVisibleUsers()
+{
+    if (!isVisible())
+        return;
+
+    QList<std::shared_ptr<User>> users;
+    const QRect visibleRect = viewport()->rect();
+    for (int row = 0; row < m_userItemModel->rowCount(); ++row) {
+        const QModelIndex index = m_userItemModel->index(row, 0);
+        if (!visualRect(index).intersects(visibleRect))
+            continue;
+
+        const UserItemDelegate::UserItemData data = index.data(UserItemDelegate::StaticUserDataRole).value<UserItemDelegate::UserItemData>();
+        std::shared_ptr<User> user = m_model->findUserByUid(data.userId);
+        if (user && !user->isMaterialized())
+            users.append(user);
+    }
+    NativeUser::materializeUsers(users);
+}
+
 void UserListPopupWidget::userInfoChanged()
 {
     User *user = qobject_cast<User *>(sender());
@@ -233,6 +269,12 @@ void UserListPopupWidget::userInfoChanged()
     updateViewWidth();
 }
 
+void UserListPopupWidget::onAvatarChanged(const QString &path)
+{
+    AvatarCache::instance()->invalidate(path);
+    userInfoChanged();
+}
+
 void UserListPopupWidget::currentUserChanged(const std::shared_ptr<User> &user)
 {
     if (m_currentUser->uid() == user->uid())
@@ -14,6 +14,7 @@ class User;
 class SessionBaseModel;
 class UserItemDelegate;
 class QStandardItemModel;
+class QTimer;
 
 /*!
  * \brief The UserListPopupWidget class
@@ -34,12 +35,14 @@ protected:
 
 private slots:
     void userInfoChanged();
+    void onAvatarChanged(const QString &path);
     void currentUserChanged(const std::shared_ptr<User> &user);
 
 private:
     void initUI();
     void initConnections();
     void loadUsers();
+    void materializeVisibleUsers();
 
     void handlerBeforeAddUser(const std::shared_ptr<User> &user);
     void addUser(const std::shared_ptr<User> &user);
@@ -59,6 +62,7 @@ private:
 
     QMap<uid_t, QStandardItem *> m_userItemMap;
     std::shared_ptr<User> m_currentUser;
+    QTimer *m_materializeTimer;
 };
 
 #endif // USER_LIST_WIDGET_H
@@ -11,7 +11,9 @@
 
 int main(int argc, char **argv)
 {
-    qputenv("QT_QPA_PLATFORM", "offscreen"); // gerrit编译时没有显示器，需要指定环境变量
+    // gerrit编译时没有显示器，需要指定环境变量；在 Xvfb 中运行时可以指定 QT_QPA_PLATFORM=xcb
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
 
     QApplication app(argc, argv);
 
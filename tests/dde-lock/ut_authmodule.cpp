@@ -4,6 +4,10 @@
 
 #include "auth_module.h"
 #include "authcommon.h"
+#include "spritecache.h"
+
+#include <QDebug>
+#include <QElapsedTimer>
 
 #include <gtest/gtest.h>
 
@@ -35,3 +39,34 @@ TEST_F(UT_AuthModule, BasicTest)
     // m_authModule->setAuthState("");
     m_authModule->setLimitsInfo(LimitsInfo());
 }
+
+TEST_F(UT_AuthModule, authStateFrame)
+{
+    m_authModule->setAuthStateLabel(new DLabel(m_authModule));
+    for (int i = 1; i <= AUTH_UNLOCK_FRAME_COUNT; ++i) {
+        m_authModule->setAuthStateFrame(i);
+        ASSERT_NE(m_authModule->m_authStateLabel->pixmap(), nullptr);
+        EXPECT_FALSE(m_authModule->m_authStateLabel->pixmap()->isNull());
+    }
+}
+
+TEST_F(UT_AuthModule, FrameTime)
+{
+    m_authModule->setAuthStateLabel(new DLabel(m_authModule));
+
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 1; i <= AUTH_UNLOCK_FRAME_COUNT; ++i)
+        m_authModule->setAuthStateStyle(AUTH_UNLOCK_FRAMES.arg(i));
+    qInfo() << "unlock animation svg frame time:" << timer.nsecsElapsed() / 1000 / AUTH_UNLOCK_FRAME_COUNT << "us";
+
+    SpriteCache::instance()->clear();
+    timer.restart();
+    SpriteCache::instance()->sprite(AUTH_UNLOCK_FRAMES, AUTH_UNLOCK_FRAME_COUNT, m_authModule->devicePixelRatioF());
+    qInfo() << "unlock animation sprite build time:" << timer.nsecsElapsed() / 1000 << "us";
+
+    timer.restart();
+    for (int i = 1; i <= AUTH_UNLOCK_FRAME_COUNT; ++i)
+        m_authModule->setAuthStateFrame(i);
+    qInfo() << "unlock animation sprite frame time:" << timer.nsecsElapsed() / 1000 / AUTH_UNLOCK_FRAME_COUNT << "us";
+}
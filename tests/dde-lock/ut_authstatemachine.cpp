@@ -0,0 +1,182 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "authstatemachine.h"
+#include "authcommon.h"
+
+#include <QSignalSpy>
+#include <QStringList>
+
+#include <gtest/gtest.h>
+
+using namespace AuthCommon;
+
+class UT_AuthStateMachine : public testing::Test
+{
+protected:
+    void SetUp() override;
+    void TearDown() override;
+
+    AuthStateMachine *m_machine;
+    QStringList m_actions;      // 按顺序记录状态机发出的请求
+};
+
+void UT_AuthStateMachine::SetUp()
+{
+    m_machine = new AuthStateMachine;
+    QObject::connect(m_machine, &AuthStateMachine::statusChanged, [this](const int type, const int state) {
+        m_actions << QString("status %1 %2").arg(type).arg(state);
+    });
+    QObject::connect(m_machine, &AuthStateMachine::deferredStateChanged, [this](const int type, const int state) {
+        m_actions << QString("update %1 %2").arg(type).arg(state);
+    });
+    QObject::connect(m_machine, &AuthStateMachine::requestStartAuthentication, [this](const int type) {
+        m_actions << QString("start %1").arg(type);
+    });
+    QObject::connect(m_machine, &AuthStateMachine::requestEndAuthentication, [this](const int type) {
+        m_actions << QString("end %1").arg(type);
+    });
+}
+
+void UT_AuthStateMachine::TearDown()
+{
+    delete m_machine;
+}
+
+TEST_F(UT_AuthStateMachine, failure)
+{
+    m_machine->handleStatus(AT_Password, AS_Started, QString());
+    EXPECT_EQ(m_machine->factorState(AT_Password), AuthStateMachine::FS_Running);
+
+    m_machine->handleStatus(AT_Password, AS_Failure, "failure");
+    m_machine->finishFactor(AT_Password, AS_Failure, "failure", true);
+    EXPECT_EQ(m_machine->factorState(AT_Password), AuthStateMachine::FS_Ending);
+
+    // Ended 之前不更新界面，也不重新开启
+    m_machine->handleStatus(AT_Fingerprint, AS_Ended, QString());
+    EXPECT_EQ(m_machine->factorState(AT_Password), AuthStateMachine::FS_Ending);
+
+    m_machine->handleStatus(AT_Password, AS_Ended, QString());
+    EXPECT_EQ(m_machine->factorState(AT_Password), AuthStateMachine::FS_Idle);
+    EXPECT_EQ(m_actions, QStringList({
+        QString("status %1 %2").arg(AT_Password).arg(AS_Started),
+        QString("status %1 %2").arg(AT_Password).arg(AS_Failure),
+        QString("end %1").arg(AT_Password),
+        QString("status %1 %2").arg(AT_Fingerprint).arg(AS_Ended),
+        QString("status %1 %2").arg(AT_Password).arg(AS_Ended),
+        QString("start %1").arg(AT_Password),
+        QString("update %1 %2").arg(AT_Password).arg(AS_Failure)
+    }));
+}
+
+TEST_F(UT_AuthStateMachine, locked)
+{
+    m_machine->finishFactor(AT_Fingerprint, AS_Locked, "locked", false);
+    m_machine->handleStatus(AT_Fingerprint, AS_Ended, QString());
+    EXPECT_EQ(m_actions.last(), QString("update %1 %2").arg(AT_Fingerprint).arg(AS_Locked));
+    EXPECT_FALSE(m_actions.contains(QString("start %1").arg(AT_Fingerprint)));
+}
+
+TEST_F(UT_AuthStateMachine, markEnded)
+{
+    m_machine->finishFactor(AT_PAM, AS_None, QString(), true);
+    m_machine->markEnded(AT_PAM);
+    EXPECT_EQ(m_actions, QStringList({QString("end %1").arg(AT_PAM), QString("start %1").arg(AT_PAM)}));
+}
+
+TEST_F(UT_AuthStateMachine, timeout)
+{
+    QSignalSpy spy(m_machine, &AuthStateMachine::deferredStateChanged);
+    m_machine->finishFactor(AT_Password, AS_Failure, "failure", false);
+    ASSERT_TRUE(spy.wait(AuthStateMachine::EndTimeout * 2));
+    EXPECT_EQ(m_machine->factorState(AT_Password), AuthStateMachine::FS_Idle);
+    EXPECT_EQ(m_machine->events().last().kind, AuthStateMachine::Event::Timeout);
+
+    // 超时后再收到 Ended 不会重复更新
+    m_machine->handleStatus(AT_Password, AS_Ended, QString());
+    EXPECT_EQ(spy.count(), 1);
+}
+
+TEST_F(UT_AuthStateMachine, reset)
+{
+    m_machine->finishFactor(AT_Password, AS_Failure, "failure", true);
+    m_machine->reset();
+    m_machine->handleStatus(AT_Password, AS_Ended, QString());
+    EXPECT_FALSE(m_actions.contains(QString("start %1").arg(AT_Password)));
+
+    m_machine->finishFactor(AT_Password, AS_Failure, "failure", true);
+    m_machine->handleStatus(AT_All, AS_Cancel, QString());
+    EXPECT_EQ(m_machine->factorState(AT_Password), AuthStateMachine::FS_Idle);
+}
+
+TEST_F(UT_AuthStateMachine, replay)
+{
+    m_machine->handleStatus(AT_Password, AS_Started, QString());
+    m_machine->handleStatus(AT_Password, AS_Failure, "failure");
+    m_machine->finishFactor(AT_Password, AS_Failure, "failure", true);
+    m_machine->handleStatus(AT_Password, AS_Ended, QString());
+    m_machine->finishFactor(AT_Face, AS_Locked, "locked", false);
+    m_machine->markEnded(AT_Face);
+    m_machine->reset();
+
+    const QList<AuthStateMachine::Event> events = m_machine->events();
+    const QStringList actions = m_actions;
+    ASSERT_EQ(events.size(), 7);
+
+    m_actions.clear();
+    AuthStateMachine machine;
+    QObject::connect(&machine, &AuthStateMachine::deferredStateChanged, [this](const int type, const int state) {
+        m_actions << QString("update %1 %2").arg(type).arg(state);
+    });
+    QObject::connect(&machine, &AuthStateMachine::requestStartAuthentication, [this](const int type) {
+        m_actions << QString("start %1").arg(type);
+    });
+    machine.replay(events);
+    EXPECT_EQ(machine.events().size(), events.size());
+    EXPECT_EQ(m_actions, QStringList({
+        QString("start %1").arg(AT_Password),
+        QString("update %1 %2").arg(AT_Password).arg(AS_Failure),
+        QString("update %1 %2").arg(AT_Face).arg(AS_Locked)
+    }));
+
+    // 回放的结果和原来的一致
+    QStringList expected;
+    for (const QString &action : actions) {
+        if (action.startsWith("start") || action.startsWith("update"))
+            expected << action;
+    }
+    EXPECT_EQ(m_actions, expected);
+}
+
+TEST_F(UT_AuthStateMachine, eventLimit)
+{
+    for (int i = 0; i < AuthStateMachine::MaxEventCount + 10; ++i)
+        m_machine->handleStatus(AT_Password, AS_Verify, QString::number(i));
+
+    const QList<AuthStateMachine::Event> events = m_machine->events();
+    ASSERT_EQ(events.size(), AuthStateMachine::MaxEventCount);
+    EXPECT_EQ(events.first().message, QString::number(10));
+}
+
+TEST_F(UT_AuthStateMachine, factorDeadline)
+{
+    m_machine->finishFactor(AT_Password, AS_Failure, "failure", true);
+    EXPECT_GE(m_machine->m_pendings.value(AT_Password).deadline, m_machine->m_clock.elapsed());
+
+    // 密码已经到截止时间，结束其它因子不会推迟它
+    const qint64 passwordDeadline = m_machine->m_clock.elapsed() - 1;
+    m_machine->m_pendings[AT_Password].deadline = passwordDeadline;
+    m_machine->finishFactor(AT_Fingerprint, AS_Failure, "failure", true);
+    EXPECT_EQ(m_machine->m_pendings.value(AT_Password).deadline, passwordDeadline);
+    EXPECT_EQ(m_machine->m_endTimer->remainingTime(), 0);
+
+    m_machine->onEndTimeout();
+    EXPECT_EQ(m_machine->factorState(AT_Password), AuthStateMachine::FS_Idle);
+    EXPECT_EQ(m_machine->factorState(AT_Fingerprint), AuthStateMachine::FS_Ending);
+    EXPECT_EQ(m_machine->events().last().type, AT_Password);
+    EXPECT_TRUE(m_machine->m_endTimer->isActive());
+
+    m_machine->handleStatus(AT_Fingerprint, AS_Ended, QString());
+    EXPECT_FALSE(m_machine->m_endTimer->isActive());
+}
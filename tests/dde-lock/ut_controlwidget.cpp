@@ -4,6 +4,7 @@
 
 #include "controlwidget.h"
 #include "sessionbasemodel.h"
+#include "tray_module_interface.h"
 #include <gtest/gtest.h>
 #include <QApplication>
 #include <QKeyEvent>
@@ -45,3 +46,58 @@ TEST_F(UT_ControlWidget, init)
 
     QTest::keyRelease(m_controlWidget, Qt::Key_0, Qt::KeyboardModifier::NoModifier);
 }
+
+class FakeTrayModule : public dss::module::TrayModuleInterface
+{
+public:
+    void init() override { ++initCount; }
+    QString key() const override { return "FakeTray"; }
+    QWidget *content() override { return nullptr; }
+    bool isNeedInitPlugin() const override { return true; }
+    QString icon() const override { return iconPath; }
+    QWidget *itemWidget() const override { return nullptr; }
+    QWidget *itemTipsWidget() const override { return nullptr; }
+    const QString itemContextMenu() const override { return QString(); }
+    void invokedMenuItem(const QString &, const bool) const override {}
+
+    int initCount = 0;
+    QString iconPath = ":/img/screen_keyboard_normal.svg";
+};
+
+TEST_F(UT_ControlWidget, deferredTrayModule)
+{
+    FakeTrayModule module;
+    m_controlWidget->addModule(&module);
+    ASSERT_TRUE(m_controlWidget->m_modules.contains(module.key()));
+    EXPECT_EQ(module.initCount, 0);
+
+    // 第一次悬停时初始化，之后不再重复初始化
+    FloatingButton *button = qobject_cast<FloatingButton *>(m_controlWidget->m_modules.value(module.key()));
+    ASSERT_TRUE(button);
+    Q_EMIT button->requestShowTips();
+    EXPECT_EQ(module.initCount, 1);
+    Q_EMIT button->requestShowTips();
+    m_controlWidget->initPendingTrayModule();
+    EXPECT_EQ(module.initCount, 1);
+}
+
+TEST_F(UT_ControlWidget, idleTrayModule)
+{
+    FakeTrayModule module;
+    m_controlWidget->addModule(&module);
+    EXPECT_EQ(module.initCount, 0);
+
+    m_controlWidget->initPendingTrayModule();
+    EXPECT_EQ(module.initCount, 1);
+    EXPECT_TRUE(m_controlWidget->m_pendingTrayModules.isEmpty());
+}
+
+TEST_F(UT_ControlWidget, emptyIconTrayModule)
+{
+    // 没有图标的插件立即初始化，避免按钮空白
+    FakeTrayModule module;
+    module.iconPath.clear();
+    m_controlWidget->addModule(&module);
+    EXPECT_EQ(module.initCount, 1);
+    EXPECT_FALSE(m_controlWidget->m_pendingTrayModules.contains(module.key()));
+}
@@ -0,0 +1,68 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "dbusmetrics.h"
+#include "dbuslogin1manager.h"
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include <gtest/gtest.h>
+
+class UT_DBusMetrics : public testing::Test
+{
+protected:
+    void SetUp() override { DBusMetrics::instance()->reset(); }
+    void TearDown() override { DBusMetrics::instance()->reset(); }
+};
+
+TEST_F(UT_DBusMetrics, record)
+{
+    DBusMetrics *metrics = DBusMetrics::instance();
+    metrics->record("org.deepin.dde.Test1", "Foo", true, false, 500);
+    metrics->record("org.deepin.dde.Test1", "Foo", false, true, 20 * 1000);
+    metrics->record("org.deepin.dde.Test1", "Foo", true, false, 2000 * 1000);
+
+    const QMap<QString, DBusMetrics::MethodStats> stats = metrics->stats();
+    ASSERT_TRUE(stats.contains("org.deepin.dde.Test1.Foo"));
+    const DBusMetrics::MethodStats &foo = stats.value("org.deepin.dde.Test1.Foo");
+    EXPECT_EQ(foo.syncCount, 2);
+    EXPECT_EQ(foo.asyncCount, 1);
+    EXPECT_EQ(foo.errorCount, 1);
+    EXPECT_EQ(foo.maxLatency, 2000 * 1000);
+    EXPECT_EQ(foo.histogram[0], 1);
+    EXPECT_EQ(foo.histogram[3], 1);
+    EXPECT_EQ(foo.histogram[DBusMetrics::BucketCount - 1], 1);
+}
+
+TEST_F(UT_DBusMetrics, dump)
+{
+    {
+        DBusCallTimer timer("org.deepin.dde.Test1", "Bar");
+    }
+
+    const QJsonObject root = QJsonDocument::fromJson(DBusMetrics::instance()->dump().toUtf8()).object();
+    EXPECT_EQ(root.value("buckets").toArray().size(), DBusMetrics::BucketCount);
+    const QJsonObject bar = root.value("methods").toObject().value("org.deepin.dde.Test1.Bar").toObject();
+    EXPECT_EQ(bar.value("sync").toInt(), 1);
+    EXPECT_EQ(bar.value("async").toInt(), 0);
+    EXPECT_EQ(bar.value("histogram").toArray().size(), DBusMetrics::BucketCount);
+}
+
+TEST_F(UT_DBusMetrics, property)
+{
+    // 没有连接的总线上读取属性会立即失败，不依赖 D-Bus 服务
+    DBusLogin1Manager manager("org.freedesktop.login1", "/org/freedesktop/login1", QDBusConnection("dss-ut-disconnected"));
+    manager.blockInhibited();
+
+    // 通过基类指针读取属性同样会统计
+    QDBusAbstractInterface *inter = &manager;
+    inter->property("BlockInhibited");
+
+    const QString key = QString("%1.Get:BlockInhibited").arg(DBusLogin1Manager::staticInterfaceName());
+    const QMap<QString, DBusMetrics::MethodStats> stats = DBusMetrics::instance()->stats();
+    ASSERT_TRUE(stats.contains(key));
+    EXPECT_EQ(stats.value(key).syncCount, 2);
+}
@@ -5,7 +5,13 @@
 #include "authcommon.h"
 #include "deepinauthframework.h"
 
+#include <QElapsedTimer>
+#include <QSignalSpy>
+#include <QThread>
+
 #include <gtest/gtest.h>
+#include <security/pam_appl.h>
+#include <thread>
 
 class UT_DeepinAuthFramework : public testing::Test
 {
@@ -42,7 +48,7 @@ TEST_F(UT_DeepinAuthFramework, DATest)
 //    m_authFramework->GetLimitedInfo(UserName);
 //    m_authFramework->GetSupportedEncrypts();
 
-//    m_authFramework->CreateAuthController(UserName, 19, AuthCommon::AppTypeLock);
+//    m_authFramework->CreateAuthControllerAsync(UserName, 19, AuthCommon::AppTypeLock);
 //    m_authFramework->StartAuthentication(UserName, 19, -1);
 //    m_authFramework->SendTokenToAuth(UserName, 1, "123");
 //    m_authFramework->EndAuthentication(UserName, 19);
@@ -57,3 +63,115 @@ TEST_F(UT_DeepinAuthFramework, DATest)
 //    m_authFramework->SetPrivilegesEnable(UserName, "");
 //    m_authFramework->AuthSessionPath(UserName);
 }
+
+/**
+ * 模拟 PAM 模块调用会话回调，测量 SendToken 到会话回调返回的耗时
+ */
+TEST_F(UT_DeepinAuthFramework, PAMConversationLatency)
+{
+    DeepinAuthFramework authFramework;
+    authFramework.m_PAMSession = std::make_shared<DeepinAuthFramework::PAMSession>();
+    authFramework.m_PAMSession->framework = &authFramework;
+    DeepinAuthFramework::PAMSession *session = authFramework.m_PAMSession.get();
+    struct pam_message message = {PAM_PROMPT_ECHO_OFF, "Password: "};
+    const struct pam_message *messages[] = {&message};
+    struct pam_response *response = nullptr;
+    int ret = PAM_CONV_ERR;
+    QElapsedTimer timer;
+    qint64 latency = -1;
+
+    std::thread worker([&] {
+        ret = DeepinAuthFramework::PAMConversation(1, messages, &response, session);
+        latency = timer.nsecsElapsed();
+    });
+    // 确保 PAM 线程已经进入等待
+    QThread::msleep(100);
+    timer.start();
+    authFramework.SendToken("123");
+    worker.join();
+
+    qInfo() << "SendToken to PAM conversation return:" << latency << "ns";
+    EXPECT_EQ(PAM_SUCCESS, ret);
+    ASSERT_NE(nullptr, response);
+    EXPECT_STREQ("123", response[0].resp);
+    EXPECT_LT(latency, 10 * 1000 * 1000);
+
+    free(response[0].resp);
+    free(response);
+}
+
+TEST_F(UT_DeepinAuthFramework, PAMConversationCancel)
+{
+    DeepinAuthFramework authFramework;
+    authFramework.m_PAMSession = std::make_shared<DeepinAuthFramework::PAMSession>();
+    authFramework.m_PAMSession->framework = &authFramework;
+    const std::shared_ptr<DeepinAuthFramework::PAMSession> session = authFramework.m_PAMSession;
+    struct pam_message message = {PAM_PROMPT_ECHO_OFF, "Password: "};
+    const struct pam_message *messages[] = {&message};
+    struct pam_response *response = nullptr;
+    int ret = PAM_SUCCESS;
+
+    std::thread worker([&] {
+        ret = DeepinAuthFramework::PAMConversation(1, messages, &response, session.get());
+    });
+    QThread::msleep(100);
+
+    // 结束认证只通知线程取消，不等待线程退出
+    QElapsedTimer timer;
+    timer.start();
+    authFramework.DestroyAuthenticate();
+    qInfo() << "DestroyAuthenticate cost:" << timer.nsecsElapsed() << "ns";
+    EXPECT_LT(timer.elapsed(), 100);
+    EXPECT_FALSE(authFramework.m_PAMSession);
+    worker.join();
+
+    EXPECT_EQ(PAM_ABORT, ret);
+    EXPECT_EQ(nullptr, response);
+    EXPECT_TRUE(session->cancel);
+    EXPECT_EQ(nullptr, session->framework);
+}
+
+/**
+ * 认证服务创建过程中的请求先排队，不需要 D-Bus
+ */
+TEST_F(UT_DeepinAuthFramework, PendingAuthController)
+{
+    using namespace AuthCommon;
+    const QString account("uos");
+    DeepinAuthFramework authFramework;
+    QSignalSpy spy(&authFramework, &DeepinAuthFramework::AuthControllerReady);
+    DeepinAuthFramework::PendingAuthController &pending = authFramework.m_pendingAuthControllers[account];
+    pending.serial = 2;
+    pending.pendingReplies = 2;
+
+    authFramework.StartAuthentication(account, AT_Password | AT_Fingerprint, 10);
+    authFramework.SendTokenToAuth(account, AT_Password, "123");
+    authFramework.SendTokenToAuth(account, AT_PIN, "456");
+    EXPECT_EQ(pending.startAuthType, AT_Password | AT_Fingerprint);
+    EXPECT_EQ(pending.startTimeout, 10);
+    ASSERT_EQ(pending.tokens.size(), 2);
+    EXPECT_EQ(pending.tokens.first().token, QString("123"));
+
+    // 结束认证时清除排队的类型和密码
+    authFramework.EndAuthentication(account, AT_Fingerprint | AT_PIN);
+    EXPECT_EQ(pending.startAuthType, AT_Password);
+    ASSERT_EQ(pending.tokens.size(), 1);
+    EXPECT_EQ(pending.tokens.first().authType, AT_Password);
+
+    // 过期的回复不影响当前的创建过程，也不会给其它账户插入空的记录
+    authFramework.onAuthControllerReplyFinished(account, 1);
+    authFramework.onAuthControllerReplyFinished("other", 2);
+    EXPECT_EQ(pending.pendingReplies, 2);
+    EXPECT_FALSE(authFramework.m_pendingAuthControllers.contains("other"));
+
+    authFramework.onAuthControllerReplyFinished(account, 2);
+    EXPECT_EQ(spy.count(), 0);
+    authFramework.onAuthControllerReplyFinished(account, 2);
+    ASSERT_EQ(spy.count(), 1);
+    EXPECT_TRUE(spy.first().at(1).toBool());
+    EXPECT_FALSE(authFramework.m_pendingAuthControllers.contains(account));
+
+    // 创建完成后不再排队
+    authFramework.SendTokenToAuth(account, AT_Password, "123");
+    EXPECT_FALSE(authFramework.m_pendingAuthControllers.contains(account));
+}
@@ -0,0 +1,92 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "encryptionprovider.h"
+
+#include <QDebug>
+#include <QElapsedTimer>
+
+#include <gtest/gtest.h>
+
+namespace {
+const QString PublicKey = "-----BEGIN PUBLIC KEY-----\n"
+                          "MIIBIjANBgkqhkiG9w0BAQEFAAOCAQ8AMIIBCgKCAQEAq7wLFSd62QcGtxPDKDWT\n"
+                          "d8p00GFWUvUuxaAdMEIteB1LL+UxikFaEMTZYhorRxL5/lV6zTBi7ps2uuu70J8h\n"
+                          "CRB34uv9G4UUsN3Rbz6VSgFYdQnIJlVgr/nqzWMnuNs+qV1IFa1GH/qQS+P6hjeN\n"
+                          "3M+NeS6fzg8pS6BrvvV3VUpZzfYWpoXrHa7sRKEy1gYvCyKxQBpmwPiw8XR4PWpo\n"
+                          "hb5Mez4oJKP+honjc+X6WYoY7vc031iX6uCOfa6VB8FKqlXjZN4C5J/aL0PVSkk4\n"
+                          "x1gJmwva7D1ZOrvYXbgBCyOSoniy3MKbD3Laq/6LPWBbg7pkDSrA7It0Yf/xLpEY\n"
+                          "+wIDAQAB\n"
+                          "-----END PUBLIC KEY-----\n";
+}
+
+class UT_EncryptionProvider : public testing::Test
+{
+protected:
+    void SetUp() override;
+    void TearDown() override;
+
+    EncryptionProvider *m_provider;
+};
+
+void UT_EncryptionProvider::SetUp()
+{
+    m_provider = EncryptionProvider::instance();
+}
+
+void UT_EncryptionProvider::TearDown()
+{
+}
+
+TEST_F(UT_EncryptionProvider, Encrypt)
+{
+    ASSERT_TRUE(m_provider->setPublicKey(PublicKey));
+    ASSERT_TRUE(m_provider->isValid());
+
+    const QString symmetricKey = EncryptionProvider::generateSymmetricKey();
+    EXPECT_EQ(16, symmetricKey.length());
+    EXPECT_EQ(256, m_provider->encryptSymmetricKey(symmetricKey).size());
+
+    EXPECT_EQ(16, m_provider->encryptToken(symmetricKey, "123").size());
+    EXPECT_EQ(32, m_provider->encryptToken(symmetricKey, "0123456789abcdef").size());
+    EXPECT_EQ(m_provider->encryptToken(symmetricKey, "123"), m_provider->encryptToken(symmetricKey, "123"));
+
+    // 同一公钥只解析一次
+    ASSERT_TRUE(m_provider->setPublicKey(PublicKey));
+    EXPECT_EQ(1, m_provider->m_RSACache.size());
+    EXPECT_FALSE(m_provider->setPublicKey("invalid"));
+}
+
+TEST_F(UT_EncryptionProvider, Release)
+{
+    ASSERT_TRUE(m_provider->setPublicKey(PublicKey));
+    m_provider->release();
+    EXPECT_FALSE(m_provider->isValid());
+    EXPECT_TRUE(m_provider->m_RSACache.isEmpty());
+    EXPECT_TRUE(m_provider->encryptToken(EncryptionProvider::generateSymmetricKey(), "123").isEmpty());
+
+    // 释放后再次设置公钥会重新加载
+    ASSERT_TRUE(m_provider->setPublicKey(PublicKey));
+    EXPECT_TRUE(m_provider->isValid());
+}
+
+TEST_F(UT_EncryptionProvider, Benchmark)
+{
+    const int Loops = 1000;
+    const QString symmetricKey = EncryptionProvider::generateSymmetricKey();
+    QElapsedTimer timer;
+
+    timer.start();
+    for (int i = 0; i < Loops; ++i) {
+        m_provider->setPublicKey(PublicKey);
+        m_provider->encryptSymmetricKey(symmetricKey);
+    }
+    qInfo() << "setPublicKey + encryptSymmetricKey:" << timer.nsecsElapsed() / Loops << "ns";
+
+    timer.restart();
+    for (int i = 0; i < Loops; ++i) {
+        m_provider->encryptToken(symmetricKey, "password");
+    }
+    qInfo() << "encryptToken:" << timer.nsecsElapsed() / Loops << "ns";
+}
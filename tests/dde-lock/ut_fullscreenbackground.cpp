@@ -5,10 +5,15 @@
 #include "fullscreenbackground.h"
 #include "sessionbasemodel.h"
 
+#include <QDir>
+#include <QElapsedTimer>
+#include <QTemporaryFile>
 #include <QTest>
 
 #include <gtest/gtest.h>
 
+const int PIXMAP_TYPE_BACKGROUND = 0;
+
 class UT_FullscreenBackground : public testing::Test
 {
 protected:
@@ -46,3 +51,28 @@ TEST_F(UT_FullscreenBackground, BasicTest)
     m_background->updateBlurBackground("/usr/share/backgrounds/default_background.jpg");
     QTest::keyPress(m_background, Qt::Key_0, Qt::KeyboardModifier::NoModifier);
 }
+
+TEST_F(UT_FullscreenBackground, AsyncPixmap)
+{
+    if (m_background->m_useSolidBackground)
+        return;
+
+    QTemporaryFile file(QDir::tempPath() + "/XXXXXX.png");
+    ASSERT_TRUE(file.open());
+    QImage image(800, 600, QImage::Format_RGB32);
+    image.fill(Qt::darkCyan);
+    ASSERT_TRUE(image.save(&file, "PNG"));
+    file.close();
+
+    m_background->resize(200, 100);
+    m_background->updateBackground(file.fileName());
+
+    QElapsedTimer timer;
+    timer.start();
+    while (m_background->getPixmap(PIXMAP_TYPE_BACKGROUND).isNull() && timer.elapsed() < 5000)
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 50);
+
+    const QPixmap &pixmap = m_background->getPixmap(PIXMAP_TYPE_BACKGROUND);
+    ASSERT_FALSE(pixmap.isNull());
+    EXPECT_EQ(pixmap.size(), m_background->trueSize());
+}
@@ -0,0 +1,128 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "imageblur.h"
+
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QtMath>
+
+#include <gtest/gtest.h>
+
+class UT_ImageBlur : public testing::Test
+{
+protected:
+    static QImage testImage(const QSize &size);
+    static QImage gaussianBlur(const QImage &image, double sigma);
+    static double psnr(const QImage &image1, const QImage &image2);
+};
+
+QImage UT_ImageBlur::testImage(const QSize &size)
+{
+    QImage image(size, QImage::Format_ARGB32_Premultiplied);
+    for (int y = 0; y < image.height(); ++y) {
+        QRgb *line = reinterpret_cast<QRgb *>(image.scanLine(y));
+        for (int x = 0; x < image.width(); ++x)
+            line[x] = qRgb((x * 7) ^ (y * 13), (x * 3 + y) & 0xff, (x ^ y) & 0xff);
+    }
+    return image;
+}
+
+/**
+ * @brief 作为参照的可分离高斯模糊，边缘像素延伸处理
+ */
+QImage UT_ImageBlur::gaussianBlur(const QImage &image, double sigma)
+{
+    const int radius = qCeil(sigma * 3);
+    QVector<double> kernel(2 * radius + 1);
+    double total = 0;
+    for (int i = -radius; i <= radius; ++i) {
+        kernel[i + radius] = qExp(-i * i / (2 * sigma * sigma));
+        total += kernel[i + radius];
+    }
+
+    auto pass = [&](const QImage &src, bool horizontal) {
+        QImage dst(src.size(), src.format());
+        for (int y = 0; y < src.height(); ++y) {
+            for (int x = 0; x < src.width(); ++x) {
+                double sum[4] = {0, 0, 0, 0};
+                for (int i = -radius; i <= radius; ++i) {
+                    const int sx = horizontal ? qBound(0, x + i, src.width() - 1) : x;
+                    const int sy = horizontal ? y : qBound(0, y + i, src.height() - 1);
+                    const QRgb pixel = reinterpret_cast<const QRgb *>(src.constScanLine(sy))[sx];
+                    sum[0] += kernel[i + radius] * qRed(pixel);
+                    sum[1] += kernel[i + radius] * qGreen(pixel);
+                    sum[2] += kernel[i + radius] * qBlue(pixel);
+                    sum[3] += kernel[i + radius] * qAlpha(pixel);
+                }
+                reinterpret_cast<QRgb *>(dst.scanLine(y))[x] = qRgba(qRound(sum[0] / total), qRound(sum[1] / total),
+                                                                      qRound(sum[2] / total), qRound(sum[3] / total));
+            }
+        }
+        return dst;
+    };
+
+    return pass(pass(image, true), false);
+}
+
+double UT_ImageBlur::psnr(const QImage &image1, const QImage &image2)
+{
+    double mse = 0;
+    for (int y = 0; y < image1.height(); ++y) {
+        const QRgb *line1 = reinterpret_cast<const QRgb *>(image1.constScanLine(y));
+        const QRgb *line2 = reinterpret_cast<const QRgb *>(image2.constScanLine(y));
+        for (int x = 0; x < image1.width(); ++x) {
+            mse += qPow(qRed(line1[x]) - qRed(line2[x]), 2) + qPow(qGreen(line1[x]) - qGreen(line2[x]), 2)
+                    + qPow(qBlue(line1[x]) - qBlue(line2[x]), 2);
+        }
+    }
+    mse /= image1.width() * image1.height() * 3;
+    return mse == 0 ? 100 : 10 * std::log10(255 * 255 / mse);
+}
+
+TEST_F(UT_ImageBlur, SimdMatchesScalar)
+{
+    const QImage image = testImage(QSize(97, 61));
+    for (int radius : {1, 4, 15}) {
+        const QImage simd = ImageBlur::boxBlur(image, radius, 3, ImageBlur::Auto);
+        const QImage scalar = ImageBlur::boxBlur(image, radius, 3, ImageBlur::Scalar);
+        EXPECT_GT(psnr(simd, scalar), 50) << "radius:" << radius;
+    }
+}
+
+TEST_F(UT_ImageBlur, Similarity)
+{
+    // 三次盒式模糊和同样方差的高斯模糊相近
+    const int radius = 4;
+    const QImage image = testImage(QSize(128, 96));
+    const QImage box = ImageBlur::boxBlur(image, radius);
+    const QImage gaussian = gaussianBlur(image, qSqrt(3 * ((2 * radius + 1) * (2 * radius + 1) - 1) / 12.0));
+    EXPECT_GT(psnr(box, gaussian), 35);
+
+    // 缩小后模糊再放大的结果和在原图上模糊相近
+    const QImage blurred = ImageBlur::blur(image, 16);
+    EXPECT_EQ(blurred.size(), image.size());
+    EXPECT_GT(psnr(blurred, ImageBlur::boxBlur(image, 16)), 20);
+}
+
+TEST_F(UT_ImageBlur, Benchmark)
+{
+    for (const QSize &size : {QSize(1920, 1080), QSize(3840, 2160)}) {
+        const QImage image = testImage(size);
+        for (ImageBlur::Backend backend : {ImageBlur::Scalar, ImageBlur::Auto}) {
+            QElapsedTimer timer;
+            timer.start();
+            const QImage small = image.scaled(size / 4);
+            ImageBlur::boxBlur(small, 10, 3, backend);
+            qInfo() << "blur" << size << (backend == ImageBlur::Auto ? "simd" : "scalar")
+                    << "cost:" << timer.elapsed() << "ms";
+        }
+
+        QElapsedTimer timer;
+        timer.start();
+        const QImage blurred = ImageBlur::blur(image);
+        qInfo() << "blur pipeline" << size << "cost:" << timer.elapsed() << "ms";
+        EXPECT_EQ(blurred.size(), size);
+    }
+}
@@ -0,0 +1,71 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "imagefilter.h"
+
+#include <QDebug>
+#include <QElapsedTimer>
+
+#include <gtest/gtest.h>
+
+class UT_ImageFilter : public testing::Test
+{
+protected:
+    static QImage testImage(const QSize &size);
+};
+
+QImage UT_ImageFilter::testImage(const QSize &size)
+{
+    QImage image(size, QImage::Format_ARGB32);
+    for (int y = 0; y < image.height(); ++y) {
+        QRgb *line = reinterpret_cast<QRgb *>(image.scanLine(y));
+        for (int x = 0; x < image.width(); ++x)
+            line[x] = qRgba((x * 7) ^ (y * 13), (x * 3 + y) & 0xff, (x ^ y) & 0xff, (x + y * 5) & 0xff);
+    }
+    return image;
+}
+
+TEST_F(UT_ImageFilter, Grayscale)
+{
+    // 宽度不是 SIMD 宽度的整数倍，覆盖每行末尾的标量处理
+    const QImage image = testImage(QSize(37, 19));
+    for (QImage::Format format : {QImage::Format_ARGB32, QImage::Format_ARGB32_Premultiplied, QImage::Format_RGB32,
+                                  QImage::Format_RGB888, QImage::Format_Indexed8, QImage::Format_Grayscale8}) {
+        const QImage source = image.convertToFormat(format);
+        const QImage expected = source.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+        const QImage gray = ImageFilter::grayscale(source);
+        ASSERT_EQ(gray.format(), QImage::Format_ARGB32_Premultiplied) << "format:" << format;
+        ASSERT_EQ(gray.size(), source.size());
+        EXPECT_EQ(gray, ImageFilter::grayscale(source, ImageFilter::Scalar)) << "format:" << format;
+
+        for (int y = 0; y < gray.height(); ++y) {
+            for (int x = 0; x < gray.width(); ++x) {
+                const QRgb pixel = gray.pixel(x, y);
+                const QRgb origin = expected.pixel(x, y);
+                EXPECT_EQ(qRed(pixel), qGreen(pixel));
+                EXPECT_EQ(qGreen(pixel), qBlue(pixel));
+                EXPECT_EQ(qAlpha(pixel), qAlpha(origin));
+                // pixel() 返回非预乘的颜色，按 alpha 还原后有舍入误差
+                EXPECT_NEAR(qRed(pixel), qGray(origin), 1 + 255 / qMax(1, qAlpha(origin)));
+            }
+        }
+    }
+
+    EXPECT_TRUE(ImageFilter::grayscale(QImage()).isNull());
+}
+
+TEST_F(UT_ImageFilter, Benchmark)
+{
+    const int count = 100;
+    const QImage image = testImage(QSize(512, 512)).convertToFormat(QImage::Format_ARGB32_Premultiplied);
+    for (ImageFilter::Backend backend : {ImageFilter::Scalar, ImageFilter::Auto}) {
+        QElapsedTimer timer;
+        timer.start();
+        for (int i = 0; i < count; ++i)
+            ImageFilter::grayscale(image, backend);
+        const qint64 cost = timer.nsecsElapsed() / count;
+        qInfo() << "grayscale 512x512" << (backend == ImageFilter::Auto ? "simd" : "scalar") << "cost:" << cost / 1000 << "us,"
+                << 512.0 * 512 * 1000 / qMax<qint64>(1, cost) << "Mpixel/s";
+    }
+}
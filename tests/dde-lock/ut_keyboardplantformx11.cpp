@@ -0,0 +1,80 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "keyboardplantform_x11.h"
+
+#include <QDebug>
+#include <QSignalSpy>
+#include <QX11Info>
+
+#include <X11/Xlib.h>
+#include <X11/keysym.h>
+#include <X11/extensions/XTest.h>
+
+#include <gtest/gtest.h>
+
+class UT_KeyboardPlantformX11 : public testing::Test
+{
+protected:
+    void SetUp() override;
+    void TearDown() override;
+
+    void pressKey(KeySym keysym);
+
+    KeyboardPlantformX11 *m_keyboard;
+};
+
+void UT_KeyboardPlantformX11::SetUp()
+{
+    m_keyboard = new KeyboardPlantformX11;
+}
+
+void UT_KeyboardPlantformX11::TearDown()
+{
+    delete m_keyboard;
+}
+
+void UT_KeyboardPlantformX11::pressKey(KeySym keysym)
+{
+    Display *display = QX11Info::display();
+    const unsigned int keycode = XKeysymToKeycode(display, keysym);
+    XTestFakeKeyEvent(display, keycode, True, CurrentTime);
+    XTestFakeKeyEvent(display, keycode, False, CurrentTime);
+    XFlush(display);
+}
+
+TEST_F(UT_KeyboardPlantformX11, basic)
+{
+    m_keyboard->isCapslockOn();
+    m_keyboard->isNumlockOn();
+}
+
+// 需要在 Xvfb 等 X 服务器中运行：QT_QPA_PLATFORM=xcb xvfb-run dde-lock-test
+TEST_F(UT_KeyboardPlantformX11, indicatorState)
+{
+    if (!QX11Info::isPlatformX11())
+        GTEST_SKIP() << "needs X11";
+
+    const bool capslock = m_keyboard->isCapslockOn();
+    QSignalSpy capslockSpy(m_keyboard, &KeyBoardPlatform::capslockStatusChanged);
+    pressKey(XK_Caps_Lock);
+    ASSERT_TRUE(capslockSpy.wait(1000));
+    EXPECT_EQ(capslockSpy.first().first().toBool(), !capslock);
+    EXPECT_EQ(m_keyboard->isCapslockOn(), !capslock);
+
+    pressKey(XK_Caps_Lock);
+    ASSERT_TRUE(capslockSpy.wait(1000));
+    EXPECT_EQ(m_keyboard->isCapslockOn(), capslock);
+
+    const bool numlock = m_keyboard->isNumlockOn();
+    QSignalSpy numlockSpy(m_keyboard, &KeyBoardPlatform::numlockStatusChanged);
+    m_keyboard->setNumlockStatus(!numlock);
+    ASSERT_TRUE(numlockSpy.wait(1000));
+    EXPECT_EQ(m_keyboard->isNumlockOn(), !numlock);
+
+    m_keyboard->setNumlockStatus(numlock);
+    ASSERT_TRUE(numlockSpy.wait(1000));
+    EXPECT_EQ(m_keyboard->isNumlockOn(), numlock);
+    EXPECT_EQ(capslockSpy.count(), 2);
+}
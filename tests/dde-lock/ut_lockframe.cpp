@@ -2,6 +2,7 @@
 //
 // SPDX-License-Identifier: GPL-3.0-or-later
 
+#include "lockcontent.h"
 #include "lockframe.h"
 #include "sessionbasemodel.h"
 
@@ -67,3 +68,40 @@ TEST_F(UT_LockFrame, event)
      m_lockFrame->hide();
      m_lockFrame->show();
 }
+
+TEST_F(UT_LockFrame, sharedContent)
+{
+    LockContent *content = new LockContent(m_model);
+    LockFrame *frame1 = new LockFrame(m_model, content);
+    LockFrame *frame2 = new LockFrame(m_model, content);
+    frame1->show();
+    frame2->show();
+
+    // 内容跟随显示它的屏幕移动，同时只在一个屏幕上显示
+    frame1->setContentVisible(true);
+    EXPECT_EQ(content->parentWidget(), frame1);
+    EXPECT_TRUE(frame1->contentVisible());
+    frame2->setContentVisible(true);
+    EXPECT_EQ(content->parentWidget(), frame2);
+    EXPECT_TRUE(frame2->contentVisible());
+    EXPECT_FALSE(frame1->contentVisible());
+    frame1->setContentVisible(false);
+    EXPECT_TRUE(frame2->contentVisible());
+
+    // 共用内容的请求不经过窗口转发，避免重复请求
+    QSignalSpy spy1(frame1, &LockFrame::requestStartAuthentication);
+    QSignalSpy spy2(frame2, &LockFrame::requestStartAuthentication);
+    emit content->requestStartAuthentication("test", 1);
+    EXPECT_EQ(spy1.count(), 0);
+    EXPECT_EQ(spy2.count(), 0);
+
+    // 显示内容的窗口析构后内容仍然可用
+    QPointer<LockContent> contentPointer(content);
+    delete frame2;
+    ASSERT_FALSE(contentPointer.isNull());
+    frame1->setContentVisible(true);
+    EXPECT_EQ(content->parentWidget(), frame1);
+
+    delete frame1;
+    delete content;
+}
@@ -2,9 +2,13 @@
 //
 // SPDX-License-Identifier: GPL-3.0-or-later
 
+#include "authcommon.h"
+#include "authstatemachine.h"
 #include "deepinauthframework.h"
 #include "lockworker.h"
 
+#include <QSignalSpy>
+
 #include <gtest/gtest.h>
 
 class UT_LockWorker : public testing::Test
@@ -63,3 +67,22 @@ TEST_F(UT_LockWorker, connection)
 //    m_worker->doPowerAction(SessionBaseModel::PowerAction::RequireSwitchSystem);
 //    m_worker->doPowerAction(SessionBaseModel::PowerAction::RequireSwitchUser);
 }
+
+TEST_F(UT_LockWorker, pamRestart)
+{
+    using namespace AuthCommon;
+
+    // 不使用认证框架时，PAM 线程结束之后才重新开启认证
+    m_model->updateFrameworkState(Unavailable);
+    AuthStateMachine *machine = m_worker->m_authStateMachine;
+    QSignalSpy spy(machine, &AuthStateMachine::requestStartAuthentication);
+    machine->finishFactor(AT_PAM, AS_Failure, "failure", true);
+    EXPECT_EQ(machine->factorState(AT_PAM), AuthStateMachine::FS_Ending);
+    EXPECT_EQ(spy.count(), 0);
+
+    Q_EMIT m_worker->m_authFramework->PAMAuthenticationFinished();
+    EXPECT_EQ(machine->factorState(AT_PAM), AuthStateMachine::FS_Idle);
+    ASSERT_EQ(spy.count(), 1);
+    EXPECT_EQ(spy.first().first().toInt(), AT_PAM);
+    m_worker->destroyAuthentication(m_worker->m_account);
+}
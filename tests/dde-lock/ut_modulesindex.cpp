@@ -0,0 +1,116 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "modulesindex.h"
+
+#include <QDateTime>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include <gtest/gtest.h>
+
+#include <utime.h>
+
+using namespace dss::module;
+
+class UT_ModulesIndex : public testing::Test
+{
+protected:
+    void SetUp() override;
+
+    void writeFile(const QString &name, const QByteArray &data);
+    void touchModulesDir();
+
+    QTemporaryDir m_modulesDir;
+    QTemporaryDir m_indexDir;
+    QString m_indexFile;
+};
+
+void UT_ModulesIndex::SetUp()
+{
+    m_indexFile = m_indexDir.filePath("modules.index");
+    writeFile("libfirst.so", "first");
+    writeFile("readme.txt", "not a module");
+}
+
+void UT_ModulesIndex::writeFile(const QString &name, const QByteArray &data)
+{
+    QFile file(m_modulesDir.filePath(name));
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly | QIODevice::Append));
+    file.write(data);
+}
+
+/**
+ * @brief 模拟安装软件包，目录的修改时间变化，避免文件系统时间精度导致测试不稳定
+ */
+void UT_ModulesIndex::touchModulesDir()
+{
+    const time_t time = QDateTime::currentDateTime().addSecs(10).toSecsSinceEpoch();
+    struct utimbuf times = {time, time};
+    ASSERT_EQ(utime(m_modulesDir.path().toLocal8Bit().constData(), &times), 0);
+}
+
+TEST_F(UT_ModulesIndex, scan)
+{
+    const QList<ModuleMetaData> modules = ModulesIndex::scan(m_modulesDir.path());
+    ASSERT_EQ(modules.size(), 1);
+    EXPECT_EQ(modules.first().path, m_modulesDir.filePath("libfirst.so"));
+    EXPECT_EQ(modules.first().size, 5);
+    // 不是插件的动态库没有元数据
+    EXPECT_TRUE(modules.first().iid.isEmpty());
+}
+
+TEST_F(UT_ModulesIndex, load)
+{
+    QList<ModuleMetaData> modules;
+    {
+        ModulesIndex index(m_indexFile);
+        EXPECT_FALSE(index.modules(m_modulesDir.path(), modules));
+        index.setModules(m_modulesDir.path(), ModulesIndex::scan(m_modulesDir.path()));
+        EXPECT_TRUE(index.save());
+    }
+
+    ModulesIndex index(m_indexFile);
+    ASSERT_TRUE(index.modules(m_modulesDir.path(), modules));
+    ASSERT_EQ(modules.size(), 1);
+    EXPECT_EQ(modules.first().path, m_modulesDir.filePath("libfirst.so"));
+    EXPECT_TRUE(modules.first().enabled);
+    EXPECT_FALSE(index.modules(m_indexDir.path(), modules));
+}
+
+TEST_F(UT_ModulesIndex, stale)
+{
+    ModulesIndex index(m_indexFile);
+    QList<ModuleMetaData> modules;
+
+    // 插件被直接覆盖，目录的修改时间不变
+    index.setModules(m_modulesDir.path(), ModulesIndex::scan(m_modulesDir.path()));
+    writeFile("libfirst.so", "changed");
+    EXPECT_FALSE(index.modules(m_modulesDir.path(), modules));
+
+    // 新增插件
+    index.setModules(m_modulesDir.path(), ModulesIndex::scan(m_modulesDir.path()));
+    EXPECT_TRUE(index.modules(m_modulesDir.path(), modules));
+    writeFile("libsecond.so", "second");
+    touchModulesDir();
+    EXPECT_FALSE(index.modules(m_modulesDir.path(), modules));
+
+    // 删除插件
+    index.setModules(m_modulesDir.path(), ModulesIndex::scan(m_modulesDir.path()));
+    EXPECT_TRUE(index.modules(m_modulesDir.path(), modules));
+    EXPECT_EQ(modules.size(), 2);
+    ASSERT_TRUE(QFile::remove(m_modulesDir.filePath("libsecond.so")));
+    EXPECT_FALSE(index.modules(m_modulesDir.path(), modules));
+}
+
+TEST_F(UT_ModulesIndex, version)
+{
+    QFile file(m_indexFile);
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+    file.write(QString(R"({"version": 0, "dirs": {"%1": {"mtime": 0, "modules": []}}})").arg(m_modulesDir.path()).toUtf8());
+    file.close();
+
+    QList<ModuleMetaData> modules;
+    EXPECT_FALSE(ModulesIndex(m_indexFile).modules(m_modulesDir.path(), modules));
+}
@@ -0,0 +1,84 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "base_module_interface.h"
+#include "modules_loader.h"
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QPluginLoader>
+#include <QTemporaryDir>
+
+#include <gtest/gtest.h>
+
+using namespace dss::module;
+
+class UT_ModulesLoader : public testing::Test
+{
+protected:
+    void SetUp() override;
+    void TearDown() override;
+
+    QTemporaryDir m_indexDir;
+    ModulesLoader *m_loader;
+};
+
+void UT_ModulesLoader::SetUp()
+{
+    m_loader = new ModulesLoader;
+    m_loader->setIndexFileName(m_indexDir.filePath("modules.index"));
+}
+
+void UT_ModulesLoader::TearDown()
+{
+    delete m_loader;
+}
+
+TEST_F(UT_ModulesLoader, invalidPath)
+{
+    m_loader->setModulePaths({"/dev/null/modules"});
+    m_loader->run();
+    EXPECT_TRUE(m_loader->moduleList().isEmpty());
+}
+
+/**
+ * modules/examples/benchmark 中的 20 个插件只在 Debug 模式下编译，每个插件构造时耗时 20ms，
+ * 其中 5 个在元数据中禁用。
+ */
+TEST_F(UT_ModulesLoader, Benchmark)
+{
+    const QString path = QCoreApplication::applicationDirPath() + "/../../modules-benchmark";
+    const QFileInfoList modules = QDir(path).entryInfoList({"*.so"}, QDir::Files);
+    if (modules.isEmpty()) {
+        qInfo() << "benchmark modules not found in" << path;
+        return;
+    }
+
+    QStringList keys;
+    QObject::connect(m_loader, &ModulesLoader::moduleFound, m_loader, [&keys](BaseModuleInterface *module) {
+        keys.append(module->key());
+    }, Qt::DirectConnection);
+
+    m_loader->setModulePaths({path});
+    QElapsedTimer timer;
+    timer.start();
+    m_loader->run();
+    qInfo() << "load" << keys.size() << "of" << modules.size() << "modules cost:" << timer.elapsed() << "ms,"
+            << "serial loading would cost at least" << keys.size() * 20 << "ms";
+
+    // 信号按照扫描的顺序发送，元数据中禁用的插件没有被加载
+    QStringList expectedKeys;
+    for (const QFileInfo &module : modules) {
+        const QString key = module.baseName().mid(QString("lib").size());
+        if (key.section('_', 1).toInt() % 4 == 0) {
+            EXPECT_FALSE(QPluginLoader(module.absoluteFilePath()).isLoaded()) << key.toStdString();
+        } else {
+            expectedKeys.append(key);
+        }
+    }
+    EXPECT_EQ(keys, expectedKeys);
+    EXPECT_EQ(m_loader->moduleList().size(), expectedKeys.size());
+}
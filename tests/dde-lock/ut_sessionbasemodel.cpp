@@ -5,9 +5,12 @@
 #include "sessionbasemodel.h"
 #include "userinfo.h"
 
+#include <QElapsedTimer>
 #include <QSignalSpy>
 
 #include <gtest/gtest.h>
+#include <pwd.h>
+#include <unistd.h>
 
 class UT_SessionBaseModel : public testing::Test
 {
@@ -130,3 +133,213 @@ TEST_F(UT_SessionBaseModel, init)
     m_sessionBaseModel->setHasVirtualKB(true);
     m_sessionBaseModel->setHasVirtualKB(false);
 }
+
+TEST_F(UT_SessionBaseModel, lazyUserList)
+{
+    for (const int count : {10, 1000, 10000}) {
+        QStringList paths;
+        for (int i = 0; i < count; ++i) {
+            paths << "/org/deepin/dde/Accounts1/User" + QString::number(100000 + i);
+        }
+
+        QElapsedTimer timer;
+        timer.start();
+        m_sessionBaseModel->updateUserList(paths);
+        qInfo() << "update user list of" << count << "users cost:" << timer.elapsed() << "ms";
+
+        const QList<std::shared_ptr<User>> userList = m_sessionBaseModel->userList();
+        ASSERT_EQ(userList.size(), count);
+        for (const std::shared_ptr<User> &user : userList) {
+            EXPECT_FALSE(user->isMaterialized());
+        }
+        EXPECT_EQ(m_sessionBaseModel->findUserByUid(100000 + count - 1)->path(), paths.last());
+
+        // 对比在调用线程中逐个调用 getpwuid 获取用户名的耗时，createLazy 在线程池中查询
+        timer.restart();
+        for (int i = 0; i < count; ++i) {
+            getpwuid(static_cast<uid_t>(100000 + i));
+        }
+        qInfo() << "getpwuid of" << count << "users cost:" << timer.elapsed() << "ms";
+        timer.restart();
+        NativeUser::createLazy(paths);
+        qInfo() << "createLazy of" << count << "users cost:" << timer.elapsed() << "ms";
+    }
+}
+
+TEST_F(UT_SessionBaseModel, lazyUserName)
+{
+    const uid_t uid = getuid();
+    struct passwd *pw = getpwuid(uid);
+    ASSERT_NE(pw, nullptr);
+    const QString name = QString::fromLocal8Bit(pw->pw_name);
+
+    const QList<std::shared_ptr<NativeUser>> users = NativeUser::createLazy({
+        "/org/deepin/dde/Accounts1/User" + QString::number(uid),
+        "/org/deepin/dde/Accounts1/User" + QString::number(999999)
+    });
+    ASSERT_EQ(users.size(), 2);
+    EXPECT_EQ(users.at(0)->uid(), uid);
+    // 用户名在线程池中查询，创建时先显示占位的用户名
+    EXPECT_EQ(users.at(0)->name(), QString("..."));
+    EXPECT_FALSE(users.at(0)->isMaterialized());
+
+    QSignalSpy spy(users.at(0).get(), &User::nameChanged);
+    ASSERT_TRUE(spy.wait(5000));
+    EXPECT_EQ(users.at(0)->name(), name);
+    // passwd 中没有的用户保持占位的用户名
+    EXPECT_EQ(users.at(1)->name(), QString("..."));
+
+    // 读取影响登录逻辑的属性不会同步加载
+    users.at(1)->isNoPasswordLogin();
+    EXPECT_FALSE(users.at(1)->isMaterialized());
+}
+
+TEST_F(UT_SessionBaseModel, materializeUsersAsync)
+{
+    QList<std::shared_ptr<User>> users;
+    for (int i = 0; i < 100; ++i) {
+        users << NativeUser::createLazy("/org/deepin/dde/Accounts1/User" + QString::number(100000 + i));
+    }
+
+    // 只发出请求，不等待回复
+    QElapsedTimer timer;
+    timer.start();
+    NativeUser::materializeUsers(users);
+    qInfo() << "request properties of" << users.size() << "users cost:" << timer.elapsed() << "ms";
+    for (const std::shared_ptr<User> &user : users) {
+        EXPECT_FALSE(user->isMaterialized());
+        EXPECT_NE(std::static_pointer_cast<NativeUser>(user)->m_propertiesWatcher, nullptr);
+    }
+
+    // 同一个用户不重复请求
+    QDBusPendingCallWatcher *watcher = std::static_pointer_cast<NativeUser>(users.first())->m_propertiesWatcher;
+    NativeUser::materializeUsers(users);
+    EXPECT_EQ(std::static_pointer_cast<NativeUser>(users.first())->m_propertiesWatcher, watcher);
+}
+
+TEST_F(UT_SessionBaseModel, materializeProperties)
+{
+    // GetAll 回复到用户属性的映射，不需要 D-Bus
+    const std::shared_ptr<NativeUser> user = NativeUser::createLazy("/org/deepin/dde/Accounts1/User100001");
+    EXPECT_EQ(user->uid(), 100001u);
+    QSignalSpy nameSpy(user.get(), &User::nameChanged);
+    QSignalSpy uidSpy(user.get(), &User::uidChanged);
+
+    QVariantMap properties;
+    properties.insert("UserName", "lazy_user");
+    properties.insert("FullName", "Lazy User");
+    properties.insert("Uid", "100002");
+    properties.insert("AccountType", 1);
+    properties.insert("AutomaticLogin", true);
+    properties.insert("NoPasswdLogin", false);
+    properties.insert("PasswordStatus", "NP");
+    properties.insert("Use24HourFormat", false);
+    properties.insert("ShortDateFormat", 3);
+    properties.insert("ShortTimeFormat", 1);
+    properties.insert("WeekdayFormat", 2);
+    properties.insert("Layout", "us;");
+    properties.insert("HistoryLayout", QStringList({"us;", "cn;altgr-pinyin"}));
+    properties.insert("Locale", "zh_CN.UTF-8");
+    properties.insert("PasswordHint", "hint");
+    properties.insert("IconFile", "file:///nonexistent/avatar.png");
+    user->materialize(properties);
+
+    EXPECT_TRUE(user->isMaterialized());
+    EXPECT_EQ(user->name(), QString("lazy_user"));
+    EXPECT_EQ(user->fullName(), QString("Lazy User"));
+    EXPECT_EQ(user->displayName(), QString("Lazy User"));
+    EXPECT_EQ(user->uid(), 100002u);
+    EXPECT_EQ(user->accountType(), User::Admin);
+    EXPECT_TRUE(user->isAutomaticLogin());
+    // 密码状态 NP 表示没有设置密码，按无密码登录处理
+    EXPECT_FALSE(user->isPasswordValid());
+    EXPECT_TRUE(user->isNoPasswordLogin());
+    EXPECT_FALSE(user->isUse24HourFormat());
+    EXPECT_EQ(user->shortDateFormat(), 3);
+    EXPECT_EQ(user->shortTimeFormat(), 1);
+    EXPECT_EQ(user->weekdayFormat(), 2);
+    EXPECT_EQ(user->keyboardLayout(), QString("us;"));
+    EXPECT_EQ(user->keyboardLayoutList(), QStringList({"us;", "cn;altgr-pinyin"}));
+    EXPECT_EQ(user->locale(), QString("zh_CN.UTF-8"));
+    EXPECT_EQ(user->passwordHint(), QString("hint"));
+    // 无法读取的头像保持默认头像
+    EXPECT_EQ(user->avatar(), QString(":/img/default_avatar.svg"));
+
+    // 已经在使用这个用户的界面收到更新
+    ASSERT_EQ(nameSpy.count(), 1);
+    EXPECT_EQ(nameSpy.first().at(0).toString(), QString("lazy_user"));
+    ASSERT_EQ(uidSpy.count(), 1);
+
+    // 已经加载的用户不再重复加载
+    properties.insert("UserName", "other");
+    user->materialize(properties);
+    EXPECT_EQ(user->name(), QString("lazy_user"));
+
+    properties.insert("PasswordStatus", "P");
+    const std::shared_ptr<NativeUser> passwordUser = NativeUser::createLazy("/org/deepin/dde/Accounts1/User100003");
+    passwordUser->materialize(properties);
+    EXPECT_TRUE(passwordUser->isPasswordValid());
+    EXPECT_FALSE(passwordUser->isNoPasswordLogin());
+}
+
+TEST_F(UT_SessionBaseModel, userIndex)
+{
+    std::shared_ptr<ADDomainUser> domainUser(new ADDomainUser(20001));
+    domainUser->setName("domain_user");
+    m_sessionBaseModel->addUser(domainUser);
+    EXPECT_EQ(m_sessionBaseModel->findUserByUid(20001), domainUser);
+    EXPECT_EQ(m_sessionBaseModel->findUserByName("domain_user"), domainUser);
+
+    domainUser->setName("domain_user_renamed");
+    EXPECT_EQ(m_sessionBaseModel->findUserByName("domain_user"), nullptr);
+    EXPECT_EQ(m_sessionBaseModel->findUserByName("domain_user_renamed"), domainUser);
+
+    m_sessionBaseModel->updateLastLogoutUser(20001);
+    m_sessionBaseModel->removeUser(domainUser);
+    EXPECT_EQ(m_sessionBaseModel->findUserByUid(20001), nullptr);
+    EXPECT_EQ(m_sessionBaseModel->findUserByName("domain_user_renamed"), nullptr);
+    EXPECT_EQ(m_sessionBaseModel->findUserByName(""), nullptr);
+}
+
+TEST_F(UT_SessionBaseModel, duplicateUid)
+{
+    // 域账户按 uid 保存，本地用户按 D-Bus 路径保存，按 m_users 的顺序本地用户在前
+    std::shared_ptr<ADDomainUser> domainUser(new ADDomainUser(20002));
+    domainUser->setName("domain_user");
+    m_sessionBaseModel->addUser(domainUser);
+    const std::shared_ptr<NativeUser> nativeUser = NativeUser::createLazy("/org/deepin/dde/Accounts1/User20002");
+    m_sessionBaseModel->addUser(nativeUser);
+
+    ASSERT_EQ(m_sessionBaseModel->m_usersByUid.count(20002), 2);
+    EXPECT_EQ(m_sessionBaseModel->findUserByUid(20002), nativeUser);
+    EXPECT_EQ(m_sessionBaseModel->findUserByUid(20002), m_sessionBaseModel->m_users->first());
+
+    m_sessionBaseModel->removeUser(nativeUser);
+    EXPECT_EQ(m_sessionBaseModel->findUserByUid(20002), domainUser);
+    m_sessionBaseModel->removeUser(domainUser);
+    EXPECT_FALSE(m_sessionBaseModel->findUserByUid(20002));
+}
+
+TEST_F(UT_SessionBaseModel, loginedUserListDiff)
+{
+    QSignalSpy loggedInSpy(m_sessionBaseModel, &SessionBaseModel::userLoggedIn);
+    QSignalSpy loggedOutSpy(m_sessionBaseModel, &SessionBaseModel::userLoggedOut);
+    QSignalSpy listSpy(m_sessionBaseModel, &SessionBaseModel::loginedUserListChanged);
+
+    const QString loginedList("{\"1\":[{\"Uid\":0,\"Desktop\":\"deepin\"},{\"Uid\":100,\"Desktop\":\"deepin\"}]}");
+    m_sessionBaseModel->updateLoginedUserList(loginedList);
+    EXPECT_EQ(loggedInSpy.count(), 1);
+    EXPECT_EQ(listSpy.count(), 1);
+    EXPECT_EQ(m_sessionBaseModel->loginedUserCount(), 1);
+
+    // 内容不变或只是顺序不同时不发送信号
+    m_sessionBaseModel->updateLoginedUserList(loginedList);
+    m_sessionBaseModel->updateLoginedUserList("{\"2\":[{\"Uid\":0,\"Desktop\":\"deepin\"}]}");
+    EXPECT_EQ(loggedInSpy.count(), 1);
+    EXPECT_EQ(listSpy.count(), 1);
+
+    m_sessionBaseModel->updateLoginedUserList("{}");
+    EXPECT_EQ(loggedOutSpy.count(), 1);
+    EXPECT_EQ(listSpy.count(), 2);
+    EXPECT_EQ(m_sessionBaseModel->loginedUserCount(), 0);
+}
@@ -0,0 +1,113 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "auth_face.h"
+#include "auth_fingerprint.h"
+#include "auth_password.h"
+#include "sfa_widget.h"
+#include "mfa_widget.h"
+#include "sessionbasemodel.h"
+
+#include <QDebug>
+#include <QElapsedTimer>
+
+#include <gtest/gtest.h>
+
+using namespace AuthCommon;
+
+static const int FIRST_USER_AUTH_TYPE = AT_Password | AT_Fingerprint;
+static const int SECOND_USER_AUTH_TYPE = AT_Password | AT_Face | AT_Iris | AT_Ukey;
+
+class UT_SFAWidget : public testing::Test
+{
+protected:
+    void SetUp() override;
+    void TearDown() override;
+
+    SessionBaseModel *m_model;
+    SFAWidget *m_sfaWidget;
+    MFAWidget *m_mfaWidget;
+};
+
+void UT_SFAWidget::SetUp()
+{
+    m_model = new SessionBaseModel();
+    std::shared_ptr<User> user_ptr(new User);
+    m_model->updateCurrentUser(user_ptr);
+
+    m_sfaWidget = new SFAWidget;
+    m_sfaWidget->setModel(m_model);
+    m_mfaWidget = new MFAWidget;
+    m_mfaWidget->setModel(m_model);
+}
+
+void UT_SFAWidget::TearDown()
+{
+    delete m_sfaWidget;
+    delete m_mfaWidget;
+    delete m_model;
+}
+
+TEST_F(UT_SFAWidget, recycleAuthModule)
+{
+    m_sfaWidget->setAuthType(FIRST_USER_AUTH_TYPE);
+    AuthPassword *passwordAuth = m_sfaWidget->m_passwordAuth;
+    AuthFingerprint *fingerprintAuth = m_sfaWidget->m_fingerprintAuth;
+    ASSERT_NE(fingerprintAuth, nullptr);
+    ASSERT_EQ(m_sfaWidget->m_authButtons.size(), 2);
+
+    m_sfaWidget->setAuthType(SECOND_USER_AUTH_TYPE);
+    EXPECT_EQ(m_sfaWidget->m_passwordAuth, passwordAuth);
+    EXPECT_EQ(m_sfaWidget->m_fingerprintAuth, nullptr);
+    EXPECT_TRUE(fingerprintAuth->signalsBlocked());
+    EXPECT_EQ(m_sfaWidget->m_authButtons.size(), 4);
+    EXPECT_FALSE(m_sfaWidget->m_authButtons.contains(AT_Fingerprint));
+
+    m_sfaWidget->setAuthType(FIRST_USER_AUTH_TYPE);
+    EXPECT_EQ(m_sfaWidget->m_fingerprintAuth, fingerprintAuth);
+    EXPECT_FALSE(fingerprintAuth->signalsBlocked());
+    EXPECT_EQ(m_sfaWidget->m_authButtons.size(), 2);
+    EXPECT_TRUE(m_sfaWidget->m_recycledAuthModules.contains(AT_Face));
+}
+
+TEST_F(UT_SFAWidget, mfaRecycleAuthModule)
+{
+    m_mfaWidget->setAuthType(SECOND_USER_AUTH_TYPE);
+    AuthFace *faceAuth = m_mfaWidget->m_faceAuth;
+    ASSERT_NE(faceAuth, nullptr);
+
+    m_mfaWidget->setAuthType(FIRST_USER_AUTH_TYPE);
+    EXPECT_EQ(m_mfaWidget->m_faceAuth, nullptr);
+    EXPECT_EQ(m_mfaWidget->m_mainLayout->indexOf(faceAuth), -1);
+
+    m_mfaWidget->setAuthType(SECOND_USER_AUTH_TYPE);
+    EXPECT_EQ(m_mfaWidget->m_faceAuth, faceAuth);
+    EXPECT_NE(m_mfaWidget->m_mainLayout->indexOf(faceAuth), -1);
+}
+
+TEST_F(UT_SFAWidget, SwitchTime)
+{
+    QElapsedTimer timer;
+    timer.start();
+    m_sfaWidget->setAuthType(FIRST_USER_AUTH_TYPE);
+    m_sfaWidget->setAuthType(SECOND_USER_AUTH_TYPE);
+    qInfo() << "SFA first switch cost:" << timer.nsecsElapsed() / 1000 << "us";
+
+    const int count = 50;
+    timer.restart();
+    for (int i = 0; i < count; ++i) {
+        m_sfaWidget->setAuthType(FIRST_USER_AUTH_TYPE);
+        m_sfaWidget->setAuthType(SECOND_USER_AUTH_TYPE);
+    }
+    qInfo() << "SFA switch between users cost:" << timer.nsecsElapsed() / 1000 / count / 2 << "us";
+
+    m_mfaWidget->setAuthType(FIRST_USER_AUTH_TYPE);
+    m_mfaWidget->setAuthType(SECOND_USER_AUTH_TYPE);
+    timer.restart();
+    for (int i = 0; i < count; ++i) {
+        m_mfaWidget->setAuthType(FIRST_USER_AUTH_TYPE);
+        m_mfaWidget->setAuthType(SECOND_USER_AUTH_TYPE);
+    }
+    qInfo() << "MFA switch between users cost:" << timer.nsecsElapsed() / 1000 / count / 2 << "us";
+}
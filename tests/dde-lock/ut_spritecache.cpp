@@ -0,0 +1,52 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "spritecache.h"
+
+#include <gtest/gtest.h>
+
+static const char UNLOCK_FRAMES[] = ":/misc/images/unlock/unlock_%1.svg";
+
+class UT_SpriteCache : public testing::Test
+{
+protected:
+    void TearDown() override;
+};
+
+void UT_SpriteCache::TearDown()
+{
+    SpriteCache::instance()->clear();
+}
+
+TEST_F(UT_SpriteCache, render)
+{
+    const QImage atlas = SpriteCache::render(UNLOCK_FRAMES, 11, 2);
+    ASSERT_FALSE(atlas.isNull());
+    EXPECT_EQ(atlas.width() % 11, 0);
+
+    EXPECT_TRUE(SpriteCache::render(":/not/exist_%1.svg", 3, 1).isNull());
+}
+
+TEST_F(UT_SpriteCache, frame)
+{
+    SpriteCache::instance()->preload(UNLOCK_FRAMES, 11, 1);
+    const SpriteCache::Sprite sprite = SpriteCache::instance()->sprite(UNLOCK_FRAMES, 11, 1);
+    ASSERT_EQ(sprite.frameCount, 11);
+
+    const QPixmap first = sprite.frame(0);
+    EXPECT_EQ(first.size(), sprite.frameSize);
+    EXPECT_FALSE(sprite.frame(10).isNull());
+    EXPECT_TRUE(sprite.frame(11).isNull());
+    EXPECT_TRUE(sprite.frame(-1).isNull());
+
+    // 图集只在生成时拆分一次，取帧不再拷贝图片
+    ASSERT_EQ(sprite.frames.size(), 11);
+    EXPECT_EQ(sprite.frame(3).cacheKey(), sprite.frame(3).cacheKey());
+    EXPECT_EQ(SpriteCache::instance()->sprite(UNLOCK_FRAMES, 11, 1).frame(3).cacheKey(), sprite.frame(3).cacheKey());
+
+    // 不同缩放比例分别缓存
+    const SpriteCache::Sprite hidpi = SpriteCache::instance()->sprite(UNLOCK_FRAMES, 11, 2);
+    EXPECT_EQ(hidpi.frameSize, sprite.frameSize * 2);
+    EXPECT_EQ(hidpi.frame(0).devicePixelRatio(), 2.0);
+}
@@ -0,0 +1,112 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "timerscheduler.h"
+
+#include <QSignalSpy>
+#include <QTimer>
+#include <QWidget>
+
+#include <gtest/gtest.h>
+
+class UT_TimerScheduler : public testing::Test
+{
+protected:
+    void SetUp() override;
+    void TearDown() override;
+
+    QWidget *m_widget;
+    QTimer *m_timer;
+};
+
+void UT_TimerScheduler::SetUp()
+{
+    m_widget = new QWidget;
+    m_timer = new QTimer(m_widget);
+}
+
+void UT_TimerScheduler::TearDown()
+{
+    TimerScheduler::instance()->setBlackMode(false);
+    TimerScheduler::instance()->setSessionActive(true);
+    delete m_widget;
+}
+
+TEST_F(UT_TimerScheduler, visibility)
+{
+    TimerScheduler *scheduler = TimerScheduler::instance();
+
+    // 控件不可见时不启动
+    scheduler->start(m_timer, m_widget, 10);
+    EXPECT_FALSE(m_timer->isActive());
+    m_widget->show();
+    EXPECT_TRUE(m_timer->isActive());
+    EXPECT_EQ(m_timer->interval(), 10);
+    m_widget->hide();
+    EXPECT_FALSE(m_timer->isActive());
+    m_widget->show();
+    EXPECT_TRUE(m_timer->isActive());
+
+    // 停止后不再恢复
+    scheduler->stop(m_timer);
+    m_widget->hide();
+    m_widget->show();
+    EXPECT_FALSE(m_timer->isActive());
+}
+
+TEST_F(UT_TimerScheduler, suspend)
+{
+    TimerScheduler *scheduler = TimerScheduler::instance();
+    QSignalSpy spy(scheduler, &TimerScheduler::suspendedChanged);
+    m_widget->show();
+    scheduler->start(m_timer, m_widget, 10);
+    EXPECT_TRUE(m_timer->isActive());
+
+    scheduler->setBlackMode(true);
+    EXPECT_TRUE(scheduler->isSuspended());
+    EXPECT_FALSE(m_timer->isActive());
+    scheduler->setSessionActive(false);
+    scheduler->setBlackMode(false);
+    EXPECT_FALSE(m_timer->isActive());
+    scheduler->setSessionActive(true);
+    EXPECT_FALSE(scheduler->isSuspended());
+    EXPECT_TRUE(m_timer->isActive());
+    EXPECT_EQ(spy.count(), 2);
+}
+
+TEST_F(UT_TimerScheduler, singleShot)
+{
+    TimerScheduler *scheduler = TimerScheduler::instance();
+    m_widget->show();
+    m_timer->setSingleShot(true);
+    scheduler->start(m_timer, m_widget, 60 * 1000);
+
+    // 恢复时单次定时器立即触发
+    scheduler->setBlackMode(true);
+    scheduler->setBlackMode(false);
+    QSignalSpy spy(m_timer, &QTimer::timeout);
+    EXPECT_TRUE(spy.wait(1000));
+
+    // 触发后不再恢复
+    scheduler->setBlackMode(true);
+    scheduler->setBlackMode(false);
+    EXPECT_FALSE(m_timer->isActive());
+}
+
+TEST_F(UT_TimerScheduler, wakeups)
+{
+    TimerScheduler *scheduler = TimerScheduler::instance();
+    const int wakeups = scheduler->wakeupsPerMinute();
+    m_widget->show();
+    scheduler->start(m_timer, m_widget, 10);
+
+    QSignalSpy spy(m_timer, &QTimer::timeout);
+    while (spy.count() < 5)
+        ASSERT_TRUE(spy.wait(1000));
+    EXPECT_GE(scheduler->wakeupsPerMinute() - wakeups, 5);
+
+    // 暂停期间没有唤醒
+    scheduler->setBlackMode(true);
+    EXPECT_FALSE(spy.wait(100));
+}
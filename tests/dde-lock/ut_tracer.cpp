@@ -0,0 +1,78 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "tracer.h"
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+
+#include <gtest/gtest.h>
+
+class UT_Tracer : public testing::Test
+{
+protected:
+    void SetUp() override;
+    void TearDown() override;
+
+    bool m_enabled;
+};
+
+void UT_Tracer::SetUp()
+{
+    m_enabled = Tracer::isEnabled();
+}
+
+void UT_Tracer::TearDown()
+{
+    Tracer::setEnabled(m_enabled);
+}
+
+TEST_F(UT_Tracer, disabled)
+{
+    Tracer::setEnabled(false);
+    const int count = Tracer::instance()->events().size();
+    {
+        TraceSpan outer("outer");
+        DSS_TRACE_SCOPE("inner");
+    }
+    Tracer::instance()->addMark("mark");
+    EXPECT_EQ(Tracer::instance()->events().size(), count);
+}
+
+TEST_F(UT_Tracer, span)
+{
+    // 不依赖 DSS_TRACE_FILE，直接在内存中记录
+    Tracer::setEnabled(true);
+    const int count = Tracer::instance()->events().size();
+    {
+        TraceSpan outer("outer");
+        DSS_TRACE_SCOPE("inner");
+    }
+
+    const QVector<Tracer::Event> events = Tracer::instance()->events();
+    ASSERT_EQ(events.size(), count + 2);
+    const Tracer::Event &inner = events.at(count);
+    const Tracer::Event &outer = events.at(count + 1);
+    EXPECT_EQ(inner.name, QByteArray("inner"));
+    EXPECT_EQ(inner.depth, outer.depth + 1);
+    EXPECT_EQ(inner.tid, outer.tid);
+    EXPECT_GE(inner.begin, outer.begin);
+    EXPECT_LE(inner.begin + inner.duration, outer.begin + outer.duration);
+}
+
+TEST_F(UT_Tracer, save)
+{
+    QTemporaryDir dir;
+    const QString fileName = dir.filePath("trace.json");
+    ASSERT_TRUE(Tracer::instance()->save(fileName));
+
+    QFile file(fileName);
+    ASSERT_TRUE(file.open(QIODevice::ReadOnly));
+    const QJsonObject root = QJsonDocument::fromJson(file.readAll()).object();
+    EXPECT_TRUE(root.value("traceEvents").isArray());
+    EXPECT_EQ(root.value("displayTimeUnit").toString(), QString("ms"));
+}
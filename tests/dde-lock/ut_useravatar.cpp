@@ -3,8 +3,13 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "useravatar.h"
+#include "avatarcache.h"
 
+#include <QDebug>
+#include <QElapsedTimer>
 #include <QPaintEvent>
+#include <QSignalSpy>
+#include <QTemporaryDir>
 
 #include <gtest/gtest.h>
 
@@ -39,3 +44,105 @@ TEST_F(UT_UserAvatar, BasicTest)
     m_avatar->borderWidth();
     //m_avatar->paintEvent(new QPaintEvent(m_avatar->rect()));
 }
+
+TEST_F(UT_UserAvatar, PaintBenchmark)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const QString iconPath = dir.filePath("avatar.png");
+    QImage icon(512, 512, QImage::Format_ARGB32);
+    icon.fill(Qt::darkCyan);
+    ASSERT_TRUE(icon.save(iconPath));
+
+    m_avatar->setIcon(iconPath);
+    m_avatar->setAvatarSize(UserAvatar::AvatarLargeSize);
+    m_avatar->resize(UserAvatar::AvatarLargeSize, UserAvatar::AvatarLargeSize);
+
+    QSignalSpy spy(AvatarCache::instance(), &AvatarCache::pixmapReady);
+    m_avatar->grab();
+    ASSERT_TRUE(spy.wait(5000));
+
+    const int count = 200;
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < count; ++i)
+        m_avatar->grab();
+    const qint64 cachedTime = timer.nsecsElapsed();
+
+    // 原来每次绘制都读取文件并裁剪
+    QPixmap target(UserAvatar::AvatarLargeSize, UserAvatar::AvatarLargeSize);
+    timer.restart();
+    for (int i = 0; i < count; ++i) {
+        QPainter painter(&target);
+        QPainterPath path;
+        path.addRoundedRect(target.rect(), 18, 18);
+        painter.setRenderHints(QPainter::Antialiasing | QPainter::SmoothPixmapTransform);
+        painter.setClipPath(path);
+        painter.drawImage(target.rect(), QImage(iconPath));
+    }
+    const qint64 decodeTime = timer.nsecsElapsed();
+
+    qInfo() << "avatar paint with cache:" << cachedTime / count / 1000 << "us, decode on paint:" << decodeTime / count / 1000 << "us";
+    EXPECT_FALSE(AvatarCache::instance()->pixmap(iconPath, QSize(UserAvatar::AvatarLargeSize, UserAvatar::AvatarLargeSize),
+                                                 m_avatar->devicePixelRatioF(), 18).isNull());
+    EXPECT_LT(cachedTime, decodeTime);
+}
+
+TEST_F(UT_UserAvatar, InvalidateOneSize)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const QString iconPath = dir.filePath("avatar.png");
+    QImage icon(256, 256, QImage::Format_ARGB32);
+    icon.fill(Qt::darkCyan);
+    ASSERT_TRUE(icon.save(iconPath));
+
+    AvatarCache *cache = AvatarCache::instance();
+    const QSize smallSize(UserAvatar::AvatarSmallSize, UserAvatar::AvatarSmallSize);
+    const QSize largeSize(UserAvatar::AvatarLargeSize, UserAvatar::AvatarLargeSize);
+    QSignalSpy spy(cache, &AvatarCache::pixmapReady);
+    cache->pixmap(iconPath, smallSize, 1.0, 18);
+    cache->pixmap(iconPath, largeSize, 1.0, 18);
+    while (spy.count() < 2)
+        ASSERT_TRUE(spy.wait(5000));
+    ASSERT_FALSE(cache->pixmap(iconPath, smallSize, 1.0, 18).isNull());
+    ASSERT_FALSE(cache->pixmap(iconPath, largeSize, 1.0, 18).isNull());
+
+    // 只清除小尺寸的缓存，大尺寸的仍然可以直接使用
+    cache->invalidate(iconPath, smallSize, 1.0, 18);
+    EXPECT_TRUE(cache->pixmap(iconPath, smallSize, 1.0, 18).isNull());
+    EXPECT_FALSE(cache->pixmap(iconPath, largeSize, 1.0, 18).isNull());
+
+    cache->invalidate(iconPath);
+    EXPECT_TRUE(cache->pixmap(iconPath, largeSize, 1.0, 18).isNull());
+}
+
+TEST_F(UT_UserAvatar, ReloadOverwrittenIcon)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const QString iconPath = dir.filePath("avatar.png");
+    QImage icon(256, 256, QImage::Format_ARGB32);
+    icon.fill(Qt::darkCyan);
+    ASSERT_TRUE(icon.save(iconPath));
+
+    m_avatar->setIcon(iconPath);
+    m_avatar->setAvatarSize(UserAvatar::AvatarLargeSize);
+    m_avatar->resize(UserAvatar::AvatarLargeSize, UserAvatar::AvatarLargeSize);
+
+    AvatarCache *cache = AvatarCache::instance();
+    const QSize size(UserAvatar::AvatarLargeSize, UserAvatar::AvatarLargeSize);
+    QSignalSpy spy(cache, &AvatarCache::pixmapReady);
+    m_avatar->grab();
+    ASSERT_TRUE(spy.wait(5000));
+    ASSERT_FALSE(cache->pixmap(iconPath, size, m_avatar->devicePixelRatioF(), 18).isNull());
+
+    // 文件被原地覆盖，路径不变，setIcon 不会清除缓存
+    icon.fill(Qt::red);
+    ASSERT_TRUE(icon.save(iconPath));
+    m_avatar->setIcon(iconPath);
+    EXPECT_FALSE(cache->pixmap(iconPath, size, m_avatar->devicePixelRatioF(), 18).isNull());
+
+    m_avatar->reloadIcon();
+    EXPECT_TRUE(cache->pixmap(iconPath, size, m_avatar->devicePixelRatioF(), 18).isNull());
+}
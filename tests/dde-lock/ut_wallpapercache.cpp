@@ -0,0 +1,94 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "wallpapercache.h"
+
+#include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QImageReader>
+#include <QTemporaryDir>
+
+#include <gtest/gtest.h>
+
+class UT_WallpaperCache : public testing::Test
+{
+protected:
+    void SetUp() override;
+    void TearDown() override;
+
+    QTemporaryDir m_dir;
+    QString m_imagePath;
+};
+
+void UT_WallpaperCache::SetUp()
+{
+    ASSERT_TRUE(m_dir.isValid());
+    WallpaperCache::setCacheDir(m_dir.filePath("cache"));
+
+    QImage image(3840, 2160, QImage::Format_RGB32);
+    for (int y = 0; y < image.height(); ++y) {
+        QRgb *line = reinterpret_cast<QRgb *>(image.scanLine(y));
+        for (int x = 0; x < image.width(); ++x)
+            line[x] = qRgb(x & 0xff, y & 0xff, (x ^ y) & 0xff);
+    }
+    m_imagePath = m_dir.filePath("wallpaper.jpg");
+    ASSERT_TRUE(image.save(m_imagePath, "JPG", 90));
+}
+
+void UT_WallpaperCache::TearDown()
+{
+    WallpaperCache::setCacheDir(QString());
+}
+
+TEST_F(UT_WallpaperCache, SaveAndLoad)
+{
+    const QSize size(1920, 1080);
+    EXPECT_TRUE(WallpaperCache::load(m_imagePath, size).isNull());
+
+    const QImage scaled = QImage(m_imagePath).scaled(size);
+    WallpaperCache::save(m_imagePath, size, scaled);
+
+    const QImage cached = WallpaperCache::load(m_imagePath, size);
+    ASSERT_FALSE(cached.isNull());
+    EXPECT_EQ(cached, scaled);
+
+    // 不同尺寸对应不同的缓存
+    EXPECT_TRUE(WallpaperCache::load(m_imagePath, QSize(1280, 720)).isNull());
+}
+
+TEST_F(UT_WallpaperCache, Evict)
+{
+    const QSize size(64, 64);
+    WallpaperCache::save(m_imagePath, size, QImage(m_imagePath).scaled(size));
+    const QString cacheDir = WallpaperCache::cacheDir();
+    ASSERT_EQ(QDir(cacheDir).entryList({"*.raw"}, QDir::Files).size(), 1);
+
+    // 长时间未使用的缓存被删除
+    QFile file(QDir(cacheDir).entryInfoList({"*.raw"}, QDir::Files).first().absoluteFilePath());
+    ASSERT_TRUE(file.open(QIODevice::ReadWrite));
+    ASSERT_TRUE(file.setFileTime(QDateTime::currentDateTime().addDays(-60), QFileDevice::FileModificationTime));
+    file.close();
+    WallpaperCache::evict();
+    EXPECT_TRUE(QDir(cacheDir).entryList({"*.raw"}, QDir::Files).isEmpty());
+}
+
+TEST_F(UT_WallpaperCache, ColdWarmBenchmark)
+{
+    const QSize size(2560, 1440);
+
+    QElapsedTimer timer;
+    timer.start();
+    QImage cold = QImage(m_imagePath).scaled(size, Qt::KeepAspectRatioByExpanding, Qt::FastTransformation);
+    const qint64 coldTime = timer.nsecsElapsed();
+    WallpaperCache::save(m_imagePath, size, cold);
+
+    timer.restart();
+    const QImage warm = WallpaperCache::load(m_imagePath, size);
+    const qint64 warmTime = timer.nsecsElapsed();
+
+    qInfo() << "wallpaper cold start:" << coldTime / 1000 << "us, warm start:" << warmTime / 1000 << "us";
+    ASSERT_FALSE(warm.isNull());
+    EXPECT_LT(warmTime, coldTime);
+}
@@ -4,20 +4,70 @@
 
 #include "xkbparser.h"
 
+#include <QDebug>
+#include <QDomDocument>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QTemporaryDir>
+
 #include <gtest/gtest.h>
 
+static const char TEST_BASE_XML[] = R"(<?xml version="1.0" encoding="UTF-8"?>
+<xkbConfigRegistry version="1.1">
+  <modelList>
+    <model><configItem><name>pc105</name><description>Generic 105-key PC</description></configItem></model>
+  </modelList>
+  <layoutList>
+    <layout>
+      <configItem>
+        <name>us</name>
+        <shortDescription>en</shortDescription>
+        <description>English (US)</description>
+        <languageList><iso639Id>eng</iso639Id></languageList>
+      </configItem>
+      <variantList>
+        <variant><configItem><name>intl</name><description>English (US, intl., with dead keys)</description></configItem></variant>
+        <variant><configItem><name>dvorak</name><description>English (Dvorak)</description></configItem></variant>
+      </variantList>
+    </layout>
+    <layout>
+      <configItem>
+        <name>cn</name>
+        <description>Chinese</description>
+        <description xml:lang="zh">中文</description>
+      </configItem>
+    </layout>
+  </layoutList>
+  <optionList>
+    <group allowMultipleSelection="true">
+      <configItem><name>grp</name><description>Switching to another layout</description></configItem>
+    </group>
+  </optionList>
+</xkbConfigRegistry>
+)";
+
 class UT_XkbParser : public testing::Test
 {
 protected:
     void SetUp() override;
     void TearDown() override;
 
+    QTemporaryDir m_dir;
+    QString m_baseFile;
+    QString m_indexFile;
     XkbParser *m_parser;
 };
 
 void UT_XkbParser::SetUp()
 {
-    m_parser = new XkbParser;
+    m_baseFile = m_dir.filePath("base.xml");
+    m_indexFile = m_dir.filePath("xkb.index");
+    QFile file(m_baseFile);
+    file.open(QIODevice::WriteOnly);
+    file.write(TEST_BASE_XML);
+    file.close();
+
+    m_parser = new XkbParser(m_baseFile, m_indexFile);
 }
 
 void UT_XkbParser::TearDown()
@@ -30,3 +80,83 @@ TEST_F(UT_XkbParser, basic)
     m_parser->lookUpKeyboardList(QStringList());
     m_parser->lookUpKeyboardKey(QString());
 }
+
+TEST_F(UT_XkbParser, parse)
+{
+    const XkbParser::Catalog catalog = XkbParser::parse(m_baseFile);
+    ASSERT_EQ(catalog.items.size(), 4);
+    EXPECT_EQ(catalog.items.at(0).first, QString("us;"));
+    EXPECT_EQ(catalog.items.at(1).first, QString("us;intl"));
+    EXPECT_EQ(catalog.descriptions.value("us;dvorak"), QString("English (Dvorak)"));
+    EXPECT_EQ(catalog.descriptions.value("cn;"), QString("Chinese"));
+    EXPECT_FALSE(catalog.descriptions.contains("pc105;"));
+    EXPECT_FALSE(catalog.descriptions.contains("grp;"));
+}
+
+TEST_F(UT_XkbParser, lookUp)
+{
+    m_parser->preload();
+    const QStringList list = m_parser->lookUpKeyboardList({"us;", "us;dvorak", "fr;", "us"});
+    ASSERT_EQ(list.size(), 2);
+    EXPECT_EQ(m_parser->lookUpKeyboardKey("English (US)"), QString("us|"));
+    EXPECT_EQ(m_parser->lookUpKeyboardKey("English (Dvorak)"), QString("us|dvorak"));
+    EXPECT_TRUE(m_parser->lookUpKeyboardKey("Unknown").isEmpty());
+}
+
+TEST_F(UT_XkbParser, index)
+{
+    const XkbParser::Catalog parsed = XkbParser::load(m_baseFile, m_indexFile);
+    ASSERT_TRUE(QFile::exists(m_indexFile));
+
+    XkbParser::Catalog indexed;
+    ASSERT_TRUE(XkbParser::loadIndex(m_baseFile, m_indexFile, indexed));
+    EXPECT_EQ(indexed.items, parsed.items);
+    EXPECT_EQ(indexed.keys, parsed.keys);
+
+    // base.xml 变化后索引失效
+    QFile file(m_baseFile);
+    file.open(QIODevice::Append);
+    file.write("\n");
+    file.close();
+    EXPECT_FALSE(XkbParser::loadIndex(m_baseFile, m_indexFile, indexed));
+}
+
+TEST_F(UT_XkbParser, Benchmark)
+{
+    if (!QFile::exists(XkbParser::BaseFile)) {
+        qInfo() << "xkb base.xml not found";
+        return;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    QFile file(XkbParser::BaseFile);
+    file.open(QIODevice::ReadOnly | QIODevice::Text);
+    QDomDocument document;
+    document.setContent(&file);
+    qInfo() << "xkb dom parse cost:" << timer.elapsed() << "ms";
+
+    timer.restart();
+    const XkbParser::Catalog catalog = XkbParser::parse(XkbParser::BaseFile);
+    qInfo() << "xkb stream parse, count:" << catalog.items.size() << ", cost:" << timer.elapsed() << "ms";
+    ASSERT_FALSE(catalog.items.isEmpty());
+
+    const QString indexFile = m_dir.filePath("system.index");
+    XkbParser::saveIndex(XkbParser::BaseFile, indexFile, catalog);
+    timer.restart();
+    XkbParser::Catalog indexed;
+    EXPECT_TRUE(XkbParser::loadIndex(XkbParser::BaseFile, indexFile, indexed));
+    qInfo() << "xkb index load cost:" << timer.elapsed() << "ms";
+
+    XkbParser parser(XkbParser::BaseFile);
+    QStringList keys;
+    for (const auto &item : catalog.items)
+        keys << item.first;
+    parser.lookUpKeyboardList(keys);
+    timer.restart();
+    for (int i = 0; i < 100; ++i) {
+        parser.lookUpKeyboardList(keys);
+        parser.lookUpKeyboardKey(catalog.items.last().second);
+    }
+    qInfo() << "xkb 100 lookups of" << keys.size() << "layouts cost:" << timer.elapsed() << "ms";
+}